@@ -0,0 +1,69 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * This program is the single database writer of a sweep: the
+ * simulations write their results as records to a file or a named pipe
+ * (see SqliteDataOutput::SetRecordFile), and this program loads them in
+ * the database in large transactions, e.g.
+ *
+ *   mkfifo records
+ *   ./waf --run "sqlite-data-import --records=records" &
+ *   ./waf --run "wifi-example-sim --format=db --records=records --distance=50" &
+ *   ./waf --run "wifi-example-sim --format=db --records=records --distance=100" &
+ *
+ * The program returns when the last writer has closed the pipe.
+ */
+
+#include <fstream>
+#include <iostream>
+
+#include "ns3/core-module.h"
+#include "ns3/stats-module.h"
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("SqliteDataImport");
+
+int main (int argc, char *argv[]) {
+
+  std::string records ("records");
+  std::string prefix ("data");
+  uint32_t batchSize = 10000;
+
+  CommandLine cmd;
+  cmd.AddValue ("records", "File or named pipe to read records from.",
+                records);
+  cmd.AddValue ("prefix", "Database file name, without the .db extension.",
+                prefix);
+  cmd.AddValue ("batchSize", "Number of records inserted per transaction.",
+                batchSize);
+  cmd.Parse (argc, argv);
+
+  std::ifstream is (records.c_str ());
+  if (!is.is_open ()) {
+      NS_LOG_ERROR ("Could not open record file \"" << records << "\"");
+      return -1;
+    }
+
+  Ptr<SqliteDataOutput> output = CreateObject<SqliteDataOutput> ();
+  output->SetFilePrefix (prefix);
+  uint32_t imported = output->Import (is, batchSize);
+  output->Dispose ();
+
+  std::cout << "imported " << imported << " records in " << prefix << ".db" << std::endl;
+  return 0;
+
+  // end main
+}
@@ -70,6 +70,7 @@ int main (int argc, char *argv[]) {
 
   double distance = 50.0;
   string format ("omnet");
+  string records;
 
   string experiment ("wifi-distance-test");
   string strategy ("wifi-default");
@@ -94,6 +95,8 @@ int main (int argc, char *argv[]) {
                 strategy);
   cmd.AddValue ("run", "Identifier for run.",
                 runID);
+  cmd.AddValue ("records", "With the db format, file or named pipe to write records to instead of the database.",
+                records);
   cmd.Parse (argc, argv);
 
   if (format != "omnet" && format != "db") {
@@ -309,7 +312,9 @@ int main (int argc, char *argv[]) {
     } else if (format == "db") {
     #ifdef STATS_HAS_SQLITE3
       NS_LOG_INFO ("Creating sqlite formatted data output.");
-      output = CreateObject<SqliteDataOutput>();
+      Ptr<SqliteDataOutput> sqliteOutput = CreateObject<SqliteDataOutput>();
+      sqliteOutput->SetRecordFile (records);
+      output = sqliteOutput;
     #endif
     } else {
       NS_LOG_ERROR ("Unknown output format " << format);
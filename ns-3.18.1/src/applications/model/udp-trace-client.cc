@@ -34,6 +34,7 @@
 #include <cstdlib>
 #include <cstdio>
 #include <fstream>
+#include <map>
 
 namespace ns3 {
 
@@ -91,6 +92,8 @@ UdpTraceClient::UdpTraceClient ()
   m_socket = 0;
   m_sendEvent = EventId ();
   m_maxPacketSize = 1400;
+  m_entries = GetSharedTrace ("");
+  m_currentEntry = 0;
 }
 
 UdpTraceClient::UdpTraceClient (Ipv4Address ip, uint16_t port,
@@ -104,6 +107,7 @@ UdpTraceClient::UdpTraceClient (Ipv4Address ip, uint16_t port,
   m_peerPort = port;
   m_currentEntry = 0;
   m_maxPacketSize = 1400;
+  m_entries = GetSharedTrace ("");
   if (traceFile != NULL)
     {
       SetTraceFile (traceFile);
@@ -113,14 +117,12 @@ UdpTraceClient::UdpTraceClient (Ipv4Address ip, uint16_t port,
 UdpTraceClient::~UdpTraceClient ()
 {
   NS_LOG_FUNCTION (this);
-  m_entries.clear ();
 }
 
 void
 UdpTraceClient::SetRemote (Address ip, uint16_t port)
 {
   NS_LOG_FUNCTION (this << ip << port);
-  m_entries.clear ();
   m_peerAddress = ip;
   m_peerPort = port;
 }
@@ -129,7 +131,6 @@ void
 UdpTraceClient::SetRemote (Ipv4Address ip, uint16_t port)
 {
   NS_LOG_FUNCTION (this << ip << port);
-  m_entries.clear ();
   m_peerAddress = Address (ip);
   m_peerPort = port;
 }
@@ -138,7 +139,6 @@ void
 UdpTraceClient::SetRemote (Ipv6Address ip, uint16_t port)
 {
   NS_LOG_FUNCTION (this << ip << port);
-  m_entries.clear ();
   m_peerAddress = Address (ip);
   m_peerPort = port;
 }
@@ -179,21 +179,46 @@ UdpTraceClient::DoDispose (void)
   Application::DoDispose ();
 }
 
-void
-UdpTraceClient::LoadTrace (std::string filename)
+const UdpTraceClient::TraceEntries*
+UdpTraceClient::GetSharedTrace (std::string filename)
 {
-  NS_LOG_FUNCTION (this << filename);
-  uint32_t time, index, prevTime = 0;
-  uint16_t size;
-  char frameType;
-  TraceEntry entry;
+  static std::map<std::string, TraceEntries> traces;
+  std::map<std::string, TraceEntries>::iterator it = traces.find (filename);
+  if (it != traces.end ())
+    {
+      return &it->second;
+    }
+  NS_LOG_FUNCTION (filename);
+  TraceEntries &entries = traces[filename];
+  uint32_t prevTime = 0;
   std::ifstream ifTraceFile;
-  ifTraceFile.open (filename.c_str (), std::ifstream::in);
-  m_entries.clear ();
-  if (!ifTraceFile.good ())
+  if (filename != "")
     {
-      LoadDefaultTrace ();
+      ifTraceFile.open (filename.c_str (), std::ifstream::in);
+    }
+  if (filename == "" || !ifTraceFile.good ())
+    {
+      for (uint32_t i = 0; i < (sizeof (g_defaultEntries) / sizeof (struct TraceEntry)); i++)
+        {
+          struct TraceEntry entry = g_defaultEntries[i];
+          if (entry.frameType == 'B')
+            {
+              entry.timeToSend = 0;
+            }
+          else
+            {
+              uint32_t tmp = entry.timeToSend;
+              entry.timeToSend -= prevTime;
+              prevTime = tmp;
+            }
+          entries.push_back (entry);
+        }
+      return &entries;
     }
+  uint32_t time, index;
+  uint16_t size;
+  char frameType;
+  TraceEntry entry;
   while (ifTraceFile.good ())
     {
       ifTraceFile >> index >> frameType >> time >> size;
@@ -208,9 +233,17 @@ UdpTraceClient::LoadTrace (std::string filename)
         }
       entry.packetSize = size;
       entry.frameType = frameType;
-      m_entries.push_back (entry);
+      entries.push_back (entry);
     }
   ifTraceFile.close ();
+  return &entries;
+}
+
+void
+UdpTraceClient::LoadTrace (std::string filename)
+{
+  NS_LOG_FUNCTION (this << filename);
+  m_entries = GetSharedTrace (filename);
   m_currentEntry = 0;
 }
 
@@ -218,22 +251,7 @@ void
 UdpTraceClient::LoadDefaultTrace (void)
 {
   NS_LOG_FUNCTION (this);
-  uint32_t prevTime = 0;
-  for (uint32_t i = 0; i < (sizeof (g_defaultEntries) / sizeof (struct TraceEntry)); i++)
-    {
-      struct TraceEntry entry = g_defaultEntries[i];
-      if (entry.frameType == 'B')
-        {
-          entry.timeToSend = 0;
-        }
-      else
-        {
-          uint32_t tmp = entry.timeToSend;
-          entry.timeToSend -= prevTime;
-          prevTime = tmp;
-        }
-      m_entries.push_back (entry);
-    }
+  m_entries = GetSharedTrace ("");
   m_currentEntry = 0;
 }
 
@@ -268,6 +286,25 @@ UdpTraceClient::StopApplication ()
   Simulator::Cancel (m_sendEvent);
 }
 
+std::string
+UdpTraceClient::PeerAddressString (void) const
+{
+  std::stringstream addressString;
+  if (Ipv4Address::IsMatchingType(m_peerAddress) == true)
+    {
+      addressString << Ipv4Address::ConvertFrom (m_peerAddress);
+    }
+  else if (Ipv6Address::IsMatchingType(m_peerAddress) == true)
+    {
+      addressString << Ipv6Address::ConvertFrom (m_peerAddress);
+    }
+  else
+    {
+      addressString << m_peerAddress;
+    }
+  return addressString.str ();
+}
+
 void
 UdpTraceClient::SendPacket (uint32_t size)
 {
@@ -287,30 +324,16 @@ UdpTraceClient::SendPacket (uint32_t size)
   seqTs.SetSeq (m_sent);
   p->AddHeader (seqTs);
 
-  std::stringstream addressString;
-  if (Ipv4Address::IsMatchingType(m_peerAddress) == true)
-    {
-      addressString << Ipv4Address::ConvertFrom (m_peerAddress);
-    }
-  else if (Ipv6Address::IsMatchingType(m_peerAddress) == true)
-    {
-      addressString << Ipv6Address::ConvertFrom (m_peerAddress);
-    }
-  else
-    {
-      addressString << m_peerAddress;
-    }
-
   if ((m_socket->Send (p)) >= 0)
     {
       ++m_sent;
       NS_LOG_INFO ("Sent " << size << " bytes to "
-                           << addressString.str ());
+                           << PeerAddressString ());
     }
   else
     {
       NS_LOG_INFO ("Error while sending " << size << " bytes to "
-                                          << addressString.str ());
+                                          << PeerAddressString ());
     }
 }
 
@@ -321,7 +344,7 @@ UdpTraceClient::Send (void)
 
   NS_ASSERT (m_sendEvent.IsExpired ());
   Ptr<Packet> p;
-  struct TraceEntry *entry = &m_entries[m_currentEntry];
+  const struct TraceEntry *entry = &(*m_entries)[m_currentEntry];
   do
     {
       for (int i = 0; i < entry->packetSize / m_maxPacketSize; i++)
@@ -333,8 +356,8 @@ UdpTraceClient::Send (void)
       SendPacket (sizetosend);
 
       m_currentEntry++;
-      m_currentEntry %= m_entries.size ();
-      entry = &m_entries[m_currentEntry];
+      m_currentEntry %= m_entries->size ();
+      entry = &(*m_entries)[m_currentEntry];
     }
   while (entry->timeToSend == 0);
   m_sendEvent = Simulator::Schedule (MilliSeconds (entry->timeToSend), &UdpTraceClient::Send, this);
@@ -49,6 +49,10 @@ class Packet;
  * -4- the fourth one indicates the frame size in byte
  * if no valid MPEG4 trace file is provided to the application the trace from
  * g_defaultEntries array will be loaded.
+ *
+ * Each trace file is parsed once per process: the clients which stream the
+ * same trace share a single read-only copy of its entries, and only keep
+ * their position in it.
  */
 class UdpTraceClient : public Application
 {
@@ -107,27 +111,36 @@ protected:
   virtual void DoDispose (void);
 
 private:
+  struct TraceEntry
+  {
+    uint32_t timeToSend;
+    uint16_t packetSize;
+    char frameType;
+  };
+  typedef std::vector<struct TraceEntry> TraceEntries;
+
   void LoadTrace (std::string filename);
   void LoadDefaultTrace (void);
+  /**
+   * \brief get the entries of a trace, shared by all the clients
+   * \param filename the trace file, or the empty string for the default trace
+   * \return the entries, parsed the first time the trace is requested
+   */
+  static const TraceEntries* GetSharedTrace (std::string filename);
   virtual void StartApplication (void);
   virtual void StopApplication (void);
   void ScheduleTransmit (Time dt);
   void Send (void);
   void SendPacket (uint32_t size);
+  std::string PeerAddressString (void) const;
 
 
-  struct TraceEntry
-  {
-    uint32_t timeToSend;
-    uint16_t packetSize;
-    char frameType;
-  };
   uint32_t m_sent;
   Ptr<Socket> m_socket;
   Address m_peerAddress;
   uint16_t m_peerPort;
   EventId m_sendEvent;
-  std::vector<struct TraceEntry> m_entries;
+  const TraceEntries *m_entries;
   uint32_t m_currentEntry;
   static struct TraceEntry g_defaultEntries[];
   uint16_t m_maxPacketSize;
@@ -181,6 +181,87 @@ void UdpTraceClientServerTestCase::DoRun (void)
 }
 
 
+/**
+ * Test that udpTraceClient applications streaming the same trace file
+ * send the same packets
+ */
+
+class UdpTraceClientSharedTraceTestCase : public TestCase
+{
+public:
+  UdpTraceClientSharedTraceTestCase ();
+  virtual ~UdpTraceClientSharedTraceTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+};
+
+UdpTraceClientSharedTraceTestCase::UdpTraceClientSharedTraceTestCase ()
+  : TestCase ("Test that udpTraceClient applications streaming the same trace file send the same packets")
+{
+}
+
+UdpTraceClientSharedTraceTestCase::~UdpTraceClientSharedTraceTestCase ()
+{
+}
+
+void UdpTraceClientSharedTraceTestCase::DoRun (void)
+{
+  std::string traceFile = CreateTempDirFilename ("udp-trace-client-shared.txt");
+  std::ofstream trace (traceFile.c_str ());
+  trace << "1 I 0 1000\n2 P 40 2000\n3 P 80 500";
+  trace.close ();
+
+  NodeContainer n;
+  n.Create (2);
+
+  InternetStackHelper internet;
+  internet.Install (n);
+
+  // link the two nodes
+  Ptr<SimpleNetDevice> txDev = CreateObject<SimpleNetDevice> ();
+  Ptr<SimpleNetDevice> rxDev = CreateObject<SimpleNetDevice> ();
+  n.Get (0)->AddDevice (txDev);
+  n.Get (1)->AddDevice (rxDev);
+  Ptr<SimpleChannel> channel1 = CreateObject<SimpleChannel> ();
+  rxDev->SetChannel (channel1);
+  txDev->SetChannel (channel1);
+  NetDeviceContainer d;
+  d.Add (txDev);
+  d.Add (rxDev);
+
+  Ipv4AddressHelper ipv4;
+  ipv4.SetBase ("10.1.1.0", "255.255.255.0");
+  Ipv4InterfaceContainer i = ipv4.Assign (d);
+
+  uint32_t MaxPacketSize = 1400 - 28; // ip/udp header
+  UdpServerHelper server[2] = { UdpServerHelper (4000), UdpServerHelper (4001) };
+  for (uint16_t j = 0; j < 2; j++)
+    {
+      ApplicationContainer apps = server[j].Install (n.Get (1));
+      apps.Start (Seconds (1.0));
+      apps.Stop (Seconds (5.0));
+
+      UdpTraceClientHelper client (i.GetAddress (1), 4000 + j, traceFile);
+      client.SetAttribute ("MaxPacketSize", UintegerValue (MaxPacketSize));
+      apps = client.Install (n.Get (0));
+      apps.Start (Seconds (2.0));
+      apps.Stop (Seconds (2.5));
+    }
+
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  // the 2000 bytes frame is sent in two packets, every 80 ms
+  for (uint16_t j = 0; j < 2; j++)
+    {
+      NS_TEST_ASSERT_MSG_EQ (server[j].GetServer ()->GetLost (), 0, "Packets were lost !");
+      NS_TEST_ASSERT_MSG_EQ (server[j].GetServer ()->GetReceived (), 25, "Did not receive expected number of packets !");
+    }
+}
+
+
 /**
  * Test that all the PacketLossCounter class checks loss correctly in different cases
  */
@@ -341,6 +422,7 @@ UdpClientServerTestSuite::UdpClientServerTestSuite ()
   : TestSuite ("udp-client-server", UNIT)
 {
   AddTestCase (new UdpTraceClientServerTestCase, TestCase::QUICK);
+  AddTestCase (new UdpTraceClientSharedTraceTestCase, TestCase::QUICK);
   AddTestCase (new UdpClientServerTestCase, TestCase::QUICK);
   AddTestCase (new PacketLossCounterTestCase, TestCase::QUICK);
   AddTestCase (new UdpEchoClientSetFillTestCase, TestCase::QUICK);
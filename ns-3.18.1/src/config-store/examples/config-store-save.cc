@@ -66,6 +66,22 @@ int main (int argc, char *argv[])
   ConfigStore outputConfig2;
   outputConfig2.ConfigureDefaults ();
   outputConfig2.ConfigureAttributes ();
+
+  // Output config store to binary format
+  Config::SetDefault ("ns3::ConfigStore::Filename", StringValue ("output-attributes.bin"));
+  Config::SetDefault ("ns3::ConfigStore::FileFormat", StringValue ("Binary"));
+  Config::SetDefault ("ns3::ConfigStore::Mode", StringValue ("Save"));
+  ConfigStore outputConfig3;
+  outputConfig3.ConfigureDefaults ();
+  outputConfig3.ConfigureAttributes ();
+
+  // Load it back, after changing the value of the rooted instance of A
+  a2_obj->SetAttribute ("TestInt16", IntegerValue (-7));
+  Config::SetDefault ("ns3::ConfigStore::Mode", StringValue ("Load"));
+  ConfigStore inputConfig;
+  inputConfig.ConfigureAttributes ();
+  a2_obj->GetAttribute ("TestInt16", iv);
+  NS_ABORT_MSG_UNLESS (iv.Get () == -3, "Cannot load A's integer attribute from a binary snapshot");
  
   Simulator::Run ();
 
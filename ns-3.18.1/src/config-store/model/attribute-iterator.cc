@@ -31,6 +31,7 @@ namespace ns3 {
 
 
 AttributeIterator::AttributeIterator ()
+  : m_currentAttributeIndex (0)
 {
 }
 
@@ -92,6 +93,18 @@ AttributeIterator::GetCurrentPath (void) const
   return oss.str ();
 }
 
+TypeId
+AttributeIterator::GetCurrentTypeId (void) const
+{
+  return m_currentTypeId;
+}
+
+uint32_t
+AttributeIterator::GetCurrentAttributeIndex (void) const
+{
+  return m_currentAttributeIndex;
+}
+
 void 
 AttributeIterator::DoStartVisitObject (Ptr<Object> object)
 {
@@ -248,6 +261,8 @@ AttributeIterator::DoIterate (Ptr<Object> object)
           if ((info.flags & TypeId::ATTR_GET) && info.accessor->HasGetter () && 
               (info.flags & TypeId::ATTR_SET) && info.accessor->HasSetter ())
             {
+              m_currentTypeId = tid;
+              m_currentAttributeIndex = i;
               VisitAttribute (object, info.name);
             }
           else
@@ -40,6 +40,15 @@ public:
   void Iterate (void);
 protected:
   std::string GetCurrentPath (void) const;
+  /**
+   * \return the TypeId which declares the attribute being visited
+   */
+  TypeId GetCurrentTypeId (void) const;
+  /**
+   * \return the index of the attribute being visited in the attributes
+   * of GetCurrentTypeId ()
+   */
+  uint32_t GetCurrentAttributeIndex (void) const;
 private:
   virtual void DoVisitAttribute (Ptr<Object> object, std::string name) = 0;
   virtual void DoStartVisitObject (Ptr<Object> object);
@@ -68,6 +77,8 @@ private:
 
   std::vector<Ptr<Object> > m_examined;
   std::vector<std::string> m_currentPath;
+  TypeId m_currentTypeId;
+  uint32_t m_currentAttributeIndex;
 };
 
 } // namespace ns3
@@ -0,0 +1,453 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "binary-config.h"
+#include "attribute-iterator.h"
+#include "attribute-default-iterator.h"
+#include "ns3/global-value.h"
+#include "ns3/string.h"
+#include "ns3/boolean.h"
+#include "ns3/integer.h"
+#include "ns3/uinteger.h"
+#include "ns3/double.h"
+#include "ns3/enum.h"
+#include "ns3/nstime.h"
+#include "ns3/log.h"
+#include "ns3/config.h"
+#include "ns3/fatal-error.h"
+#include <cstring>
+
+NS_LOG_COMPONENT_DEFINE ("BinaryConfig");
+
+namespace ns3 {
+
+// magic string and format version at the start of every snapshot
+static const char BINARY_CONFIG_MAGIC[8] = { 'n', 's', '3', 'c', 'f', 'g', 'b', '\0' };
+static const uint32_t BINARY_CONFIG_VERSION = 1;
+
+// record tags
+static const uint8_t BINARY_CONFIG_DEFAULT = 'D';
+static const uint8_t BINARY_CONFIG_GLOBAL = 'G';
+static const uint8_t BINARY_CONFIG_VALUE = 'V';
+
+/*
+ * The key of an attribute value. The path of the object is the one built
+ * by AttributeIterator, so it is the same when saving and loading as
+ * long as the object graph is the same.  The TypeId that declares the
+ * attribute is part of the hash because attribute indexes are only unique
+ * within a TypeId.
+ */
+static BinaryConfigLoad::Key
+MakeKey (std::string attributePath, TypeId tid, uint32_t index)
+{
+  std::string objectPath = attributePath.substr (0, attributePath.rfind ('/'));
+  // 64 bit FNV-1a
+  uint64_t h = 14695981039346656037ULL;
+  for (std::string::const_iterator i = objectPath.begin (); i != objectPath.end (); ++i)
+    {
+      h ^= static_cast<uint8_t> (*i);
+      h *= 1099511628211ULL;
+    }
+  std::string name = tid.GetName ();
+  h ^= '|';
+  h *= 1099511628211ULL;
+  for (std::string::const_iterator i = name.begin (); i != name.end (); ++i)
+    {
+      h ^= static_cast<uint8_t> (*i);
+      h *= 1099511628211ULL;
+    }
+  return std::make_pair (h, index);
+}
+
+template <typename T>
+static void
+Write (std::ostream *os, T value)
+{
+  os->write (reinterpret_cast<const char *> (&value), sizeof (value));
+}
+
+static void
+WriteString (std::ostream *os, const std::string &value)
+{
+  Write<uint32_t> (os, value.size ());
+  os->write (value.data (), value.size ());
+}
+
+template <typename T>
+static bool
+Read (std::istream *is, T &value)
+{
+  is->read (reinterpret_cast<char *> (&value), sizeof (value));
+  return is->good ();
+}
+
+static bool
+ReadString (std::istream *is, std::string &value)
+{
+  uint32_t size;
+  if (!Read (is, size))
+    {
+      return false;
+    }
+  value.resize (size);
+  if (size > 0)
+    {
+      is->read (&value[0], size);
+    }
+  return is->good ();
+}
+
+BinaryConfigSave::BinaryConfigSave ()
+  : m_os (0)
+{
+}
+BinaryConfigSave::~BinaryConfigSave ()
+{
+  if (m_os != 0)
+    {
+      m_os->close ();
+    }
+  delete m_os;
+  m_os = 0;
+}
+void
+BinaryConfigSave::SetFilename (std::string filename)
+{
+  m_os = new std::ofstream ();
+  m_os->open (filename.c_str (), std::ios::out | std::ios::binary);
+  m_os->write (BINARY_CONFIG_MAGIC, sizeof (BINARY_CONFIG_MAGIC));
+  Write (m_os, BINARY_CONFIG_VERSION);
+}
+void
+BinaryConfigSave::Default (void)
+{
+  class BinaryDefaultIterator : public AttributeDefaultIterator
+  {
+public:
+    BinaryDefaultIterator (std::ostream *os) {
+      m_os = os;
+    }
+private:
+    virtual void StartVisitTypeId (std::string name) {
+      m_typeId = name;
+    }
+    virtual void DoVisitAttribute (std::string name, std::string defaultValue) {
+      Write (m_os, BINARY_CONFIG_DEFAULT);
+      WriteString (m_os, m_typeId + "::" + name);
+      WriteString (m_os, defaultValue);
+    }
+    std::string m_typeId;
+    std::ostream *m_os;
+  };
+
+  BinaryDefaultIterator iterator = BinaryDefaultIterator (m_os);
+  iterator.Iterate ();
+  m_os->flush ();
+}
+void
+BinaryConfigSave::Global (void)
+{
+  for (GlobalValue::Iterator i = GlobalValue::Begin (); i != GlobalValue::End (); ++i)
+    {
+      StringValue value;
+      (*i)->GetValue (value);
+      Write (m_os, BINARY_CONFIG_GLOBAL);
+      WriteString (m_os, (*i)->GetName ());
+      WriteString (m_os, value.Get ());
+    }
+  m_os->flush ();
+}
+void
+BinaryConfigSave::Attributes (void)
+{
+  class BinaryAttributeIterator : public AttributeIterator
+  {
+public:
+    BinaryAttributeIterator (std::ostream *os)
+      : m_os (os) {}
+private:
+    virtual void DoVisitAttribute (Ptr<Object> object, std::string name) {
+      TypeId tid = GetCurrentTypeId ();
+      uint32_t index = GetCurrentAttributeIndex ();
+      struct TypeId::AttributeInformation info = tid.GetAttribute (index);
+      Ptr<AttributeValue> value = info.checker->Create ();
+      if (!info.accessor->Get (PeekPointer (object), *value))
+        {
+          NS_LOG_DEBUG ("could not get " << name);
+          return;
+        }
+      BinaryConfigLoad::Key key = MakeKey (GetCurrentPath (), tid, index);
+      Write (m_os, BINARY_CONFIG_VALUE);
+      Write (m_os, key.first);
+      Write (m_os, key.second);
+
+      const AttributeValue *v = PeekPointer (value);
+      if (const BooleanValue *b = dynamic_cast<const BooleanValue *> (v))
+        {
+          Write<uint8_t> (m_os, BinaryConfigLoad::BOOLEAN);
+          Write<uint64_t> (m_os, b->Get () ? 1 : 0);
+        }
+      else if (const IntegerValue *i = dynamic_cast<const IntegerValue *> (v))
+        {
+          Write<uint8_t> (m_os, BinaryConfigLoad::INTEGER);
+          Write<int64_t> (m_os, i->Get ());
+        }
+      else if (const UintegerValue *u = dynamic_cast<const UintegerValue *> (v))
+        {
+          Write<uint8_t> (m_os, BinaryConfigLoad::UINTEGER);
+          Write<uint64_t> (m_os, u->Get ());
+        }
+      else if (const DoubleValue *d = dynamic_cast<const DoubleValue *> (v))
+        {
+          Write<uint8_t> (m_os, BinaryConfigLoad::DOUBLE);
+          Write<double> (m_os, d->Get ());
+        }
+      else if (const TimeValue *t = dynamic_cast<const TimeValue *> (v))
+        {
+          Write<uint8_t> (m_os, BinaryConfigLoad::TIME);
+          Write<int64_t> (m_os, t->Get ().GetTimeStep ());
+        }
+      else if (const EnumValue *e = dynamic_cast<const EnumValue *> (v))
+        {
+          Write<uint8_t> (m_os, BinaryConfigLoad::ENUM);
+          Write<int64_t> (m_os, e->Get ());
+        }
+      else
+        {
+          Write<uint8_t> (m_os, BinaryConfigLoad::STRING);
+          WriteString (m_os, value->SerializeToString (info.checker));
+        }
+    }
+    std::ostream *m_os;
+  };
+
+  BinaryAttributeIterator iter = BinaryAttributeIterator (m_os);
+  iter.Iterate ();
+  // The snapshot may be loaded before this object is destroyed
+  m_os->flush ();
+}
+
+BinaryConfigLoad::BinaryConfigLoad ()
+  : m_is (0)
+{
+}
+BinaryConfigLoad::~BinaryConfigLoad ()
+{
+  if (m_is != 0)
+    {
+      m_is->close ();
+      delete m_is;
+      m_is = 0;
+    }
+}
+
+size_t
+BinaryConfigLoad::KeyHash::operator () (const Key &key) const
+{
+  return key.first ^ (key.first >> 32) ^ (key.second * 2654435761U);
+}
+
+void
+BinaryConfigLoad::SetFilename (std::string filename)
+{
+  m_is = new std::ifstream ();
+  m_is->open (filename.c_str (), std::ios::in | std::ios::binary);
+  if (!ReadHeader ())
+    {
+      NS_FATAL_ERROR ("BinaryConfigLoad: " << filename << " is not a binary configuration snapshot");
+    }
+
+  // The whole snapshot is read once; Default, Global and Attributes
+  // then only apply their part of it.  A snapshot may only end between
+  // two records, a record cut off mid-way is an error.
+  bool inRecord = false;
+  uint8_t tag;
+  while (Read (m_is, tag))
+    {
+      inRecord = true;
+      if (tag == BINARY_CONFIG_DEFAULT || tag == BINARY_CONFIG_GLOBAL)
+        {
+          std::string name, value;
+          if (!ReadString (m_is, name) || !ReadString (m_is, value))
+            {
+              break;
+            }
+          if (tag == BINARY_CONFIG_DEFAULT)
+            {
+              m_defaults.push_back (std::make_pair (name, value));
+            }
+          else
+            {
+              m_globals.push_back (std::make_pair (name, value));
+            }
+        }
+      else if (tag == BINARY_CONFIG_VALUE)
+        {
+          Key key;
+          Value value;
+          if (!Read (m_is, key.first) || !Read (m_is, key.second) || !Read (m_is, value.type))
+            {
+              break;
+            }
+          bool ok;
+          if (value.type == STRING)
+            {
+              ok = ReadString (m_is, value.str);
+            }
+          else
+            {
+              ok = Read (m_is, value.u);
+            }
+          if (!ok)
+            {
+              break;
+            }
+          m_values[key] = value;
+        }
+      else
+        {
+          NS_FATAL_ERROR ("BinaryConfigLoad: unknown record " << (uint32_t)tag << " in " << filename);
+        }
+      inRecord = false;
+    }
+  if (inRecord || !m_is->eof ())
+    {
+      NS_FATAL_ERROR ("BinaryConfigLoad: truncated snapshot " << filename);
+    }
+  NS_LOG_DEBUG ("read " << m_defaults.size () << " defaults, " << m_globals.size () << " globals, "
+                        << m_values.size () << " values");
+}
+
+bool
+BinaryConfigLoad::ReadHeader (void)
+{
+  char magic[sizeof (BINARY_CONFIG_MAGIC)];
+  uint32_t version;
+  m_is->read (magic, sizeof (magic));
+  if (!m_is->good () || std::memcmp (magic, BINARY_CONFIG_MAGIC, sizeof (magic)) != 0)
+    {
+      return false;
+    }
+  return Read (m_is, version) && version == BINARY_CONFIG_VERSION;
+}
+
+void
+BinaryConfigLoad::Default (void)
+{
+  for (std::vector<std::pair<std::string, std::string> >::const_iterator i = m_defaults.begin ();
+       i != m_defaults.end (); ++i)
+    {
+      NS_LOG_DEBUG ("name=" << i->first << ", value=" << i->second);
+      Config::SetDefault (i->first, StringValue (i->second));
+    }
+}
+void
+BinaryConfigLoad::Global (void)
+{
+  for (std::vector<std::pair<std::string, std::string> >::const_iterator i = m_globals.begin ();
+       i != m_globals.end (); ++i)
+    {
+      NS_LOG_DEBUG ("name=" << i->first << ", value=" << i->second);
+      Config::SetGlobal (i->first, StringValue (i->second));
+    }
+}
+void
+BinaryConfigLoad::Attributes (void)
+{
+  class BinaryAttributeIterator : public AttributeIterator
+  {
+public:
+    BinaryAttributeIterator (const Values *values)
+      : m_values (values) {}
+private:
+    virtual void DoVisitAttribute (Ptr<Object> object, std::string name) {
+      TypeId tid = GetCurrentTypeId ();
+      uint32_t index = GetCurrentAttributeIndex ();
+      Values::const_iterator it = m_values->find (MakeKey (GetCurrentPath (), tid, index));
+      if (it == m_values->end ())
+        {
+          return;
+        }
+      const Value &v = it->second;
+      struct TypeId::AttributeInformation info = tid.GetAttribute (index);
+      Ptr<AttributeValue> value = info.checker->Create ();
+      AttributeValue *p = PeekPointer (value);
+      bool ok = false;
+      switch (v.type)
+        {
+        case BOOLEAN:
+          if (BooleanValue *b = dynamic_cast<BooleanValue *> (p))
+            {
+              b->Set (v.u != 0);
+              ok = true;
+            }
+          break;
+        case INTEGER:
+          if (IntegerValue *i = dynamic_cast<IntegerValue *> (p))
+            {
+              i->Set (v.i);
+              ok = true;
+            }
+          break;
+        case UINTEGER:
+          if (UintegerValue *u = dynamic_cast<UintegerValue *> (p))
+            {
+              u->Set (v.u);
+              ok = true;
+            }
+          break;
+        case DOUBLE:
+          if (DoubleValue *d = dynamic_cast<DoubleValue *> (p))
+            {
+              d->Set (v.d);
+              ok = true;
+            }
+          break;
+        case TIME:
+          if (TimeValue *t = dynamic_cast<TimeValue *> (p))
+            {
+              t->Set (TimeStep (v.i));
+              ok = true;
+            }
+          break;
+        case ENUM:
+          if (EnumValue *e = dynamic_cast<EnumValue *> (p))
+            {
+              e->Set (v.i);
+              ok = true;
+            }
+          break;
+        case STRING:
+          ok = value->DeserializeFromString (v.str, info.checker);
+          break;
+        }
+      if (!ok || !info.checker->Check (*value))
+        {
+          NS_LOG_WARN ("could not load " << GetCurrentPath ());
+          return;
+        }
+      NS_LOG_DEBUG ("path=" << GetCurrentPath ());
+      info.accessor->Set (PeekPointer (object), *value);
+    }
+    const Values *m_values;
+  };
+
+  BinaryAttributeIterator iter = BinaryAttributeIterator (&m_values);
+  iter.Iterate ();
+}
+
+
+} // namespace ns3
@@ -0,0 +1,118 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef BINARY_CONFIG_H
+#define BINARY_CONFIG_H
+
+#include <stdint.h>
+#include <string>
+#include <fstream>
+#include <vector>
+#include <utility>
+#include "ns3/sgi-hashmap.h"
+#include "file-config.h"
+
+namespace ns3 {
+
+/**
+ * \ingroup configstore
+ *
+ * Save the configuration as a binary snapshot.
+ *
+ * Defaults and globals are stored by name, as in the other formats.
+ * Attribute values are stored with their type (boolean, integer, double,
+ * time, enum, or string for any other type), keyed by a hash of the path
+ * of their object and their index in the TypeId that declares them, so
+ * that loading them does not go through Config::Set path resolution nor
+ * string parsing. The snapshot is written in host byte order and is only
+ * meant to be loaded by the same build on the same kind of host; use the
+ * Xml or RawText formats for files that humans read or edit.
+ */
+class BinaryConfigSave : public FileConfig
+{
+public:
+  BinaryConfigSave ();
+  virtual ~BinaryConfigSave ();
+  virtual void SetFilename (std::string filename);
+  virtual void Default (void);
+  virtual void Global (void);
+  virtual void Attributes (void);
+private:
+  std::ofstream *m_os;
+};
+
+/**
+ * \ingroup configstore
+ *
+ * Load a configuration saved by BinaryConfigSave.
+ *
+ * Attributes are applied in bulk: the object graph is walked once and
+ * each attribute found in the snapshot is set directly through its
+ * accessor. Attributes of objects which do not exist when loading are
+ * ignored, as Config::Set would do.
+ */
+class BinaryConfigLoad : public FileConfig
+{
+public:
+  BinaryConfigLoad ();
+  virtual ~BinaryConfigLoad ();
+  virtual void SetFilename (std::string filename);
+  virtual void Default (void);
+  virtual void Global (void);
+  virtual void Attributes (void);
+
+  /// The type tags of the attribute values in the snapshot.
+  enum ValueType
+  {
+    BOOLEAN,
+    INTEGER,
+    UINTEGER,
+    DOUBLE,
+    TIME,
+    ENUM,
+    STRING
+  };
+  /// An attribute value read from the snapshot.
+  struct Value
+  {
+    uint8_t type;
+    union
+    {
+      int64_t i;
+      uint64_t u;
+      double d;
+    };
+    std::string str;
+  };
+  /// Key of an attribute value: hash of its object path and declaring TypeId, attribute index
+  typedef std::pair<uint64_t, uint32_t> Key;
+  struct KeyHash : public std::unary_function<Key, size_t>
+  {
+    size_t operator () (const Key &key) const;
+  };
+  typedef sgi::hash_map<Key, Value, KeyHash> Values;
+private:
+  bool ReadHeader (void);
+
+  std::ifstream *m_is;
+  std::vector<std::pair<std::string, std::string> > m_defaults;
+  std::vector<std::pair<std::string, std::string> > m_globals;
+  Values m_values;
+};
+
+} // namespace ns3
+
+#endif /* BINARY_CONFIG_H */
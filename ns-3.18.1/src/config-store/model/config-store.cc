@@ -1,5 +1,6 @@
 #include "config-store.h"
 #include "raw-text-config.h"
+#include "binary-config.h"
 #include "ns3/abort.h"
 #include "ns3/string.h"
 #include "ns3/log.h"
@@ -47,7 +48,8 @@ ConfigStore::GetTypeId (void)
                    EnumValue (ConfigStore::RAW_TEXT),
                    MakeEnumAccessor (&ConfigStore::SetFileFormat),
                    MakeEnumChecker (ConfigStore::RAW_TEXT, "RawText",
-                                    ConfigStore::XML, "Xml"))
+                                    ConfigStore::XML, "Xml",
+                                    ConfigStore::BINARY, "Binary"))
   ;
   return tid;
 }
@@ -107,6 +109,21 @@ ConfigStore::ConfigStore ()
           m_file = new NoneFileConfig ();
         }
     }
+  if (m_fileFormat == ConfigStore::BINARY)
+    {
+      if (m_mode == ConfigStore::SAVE)
+        {
+          m_file = new BinaryConfigSave ();
+        }
+      else if (m_mode == ConfigStore::LOAD)
+        {
+          m_file = new BinaryConfigLoad ();
+        }
+      else
+        {
+          m_file = new NoneFileConfig ();
+        }
+    }
   m_file->SetFilename (m_filename);
 }
 
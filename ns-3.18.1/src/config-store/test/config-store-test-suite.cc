@@ -0,0 +1,149 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <string>
+#include <unistd.h>
+
+#include "ns3/test.h"
+#include "ns3/simulator.h"
+#include "ns3/config.h"
+#include "ns3/global-value.h"
+#include "ns3/string.h"
+#include "ns3/boolean.h"
+#include "ns3/integer.h"
+#include "ns3/uinteger.h"
+#include "ns3/double.h"
+#include "ns3/enum.h"
+#include "ns3/pointer.h"
+#include "ns3/node.h"
+#include "ns3/simple-net-device.h"
+#include "ns3/error-model.h"
+#include "ns3/drop-tail-queue.h"
+#include "ns3/config-store.h"
+
+using namespace ns3;
+
+// ===========================================================================
+// Test case for a binary snapshot saved and loaded back.
+// ===========================================================================
+
+class BinaryConfigRoundTripTestCase : public TestCase
+{
+public:
+  BinaryConfigRoundTripTestCase ();
+  virtual ~BinaryConfigRoundTripTestCase ();
+
+private:
+  virtual void DoRun (void);
+  static void Configure (std::string filename, enum ConfigStore::Mode mode);
+};
+
+BinaryConfigRoundTripTestCase::BinaryConfigRoundTripTestCase ()
+  : TestCase ("Binary snapshot of the defaults, globals and attributes")
+{
+}
+
+BinaryConfigRoundTripTestCase::~BinaryConfigRoundTripTestCase ()
+{
+}
+
+void
+BinaryConfigRoundTripTestCase::Configure (std::string filename, enum ConfigStore::Mode mode)
+{
+  // the file is opened when the store is constructed
+  Config::SetDefault ("ns3::ConfigStore::Filename", StringValue (filename));
+  Config::SetDefault ("ns3::ConfigStore::FileFormat", EnumValue (ConfigStore::BINARY));
+  Config::SetDefault ("ns3::ConfigStore::Mode", EnumValue (mode));
+  ConfigStore config;
+  config.ConfigureDefaults ();
+  config.ConfigureAttributes ();
+}
+
+void
+BinaryConfigRoundTripTestCase::DoRun (void)
+{
+  std::string filename = CreateTempDirFilename ("config-store-test.bin");
+
+  Config::SetDefault ("ns3::DropTailQueue::MaxPackets", UintegerValue (1234));
+  Config::SetDefault ("ns3::DropTailQueue::Mode", EnumValue (DropTailQueue::QUEUE_MODE_BYTES));
+  Config::SetDefault ("ns3::RateErrorModel::ErrorRate", DoubleValue (0.25));
+  Config::SetGlobal ("RngRun", IntegerValue (7));
+
+  Ptr<Node> node = CreateObject<Node> ();
+  Ptr<SimpleNetDevice> device = CreateObject<SimpleNetDevice> ();
+  node->AddDevice (device);
+  Ptr<RateErrorModel> em = CreateObject<RateErrorModel> ();
+  em->SetAttribute ("ErrorRate", DoubleValue (0.125));
+  em->SetAttribute ("ErrorUnit", EnumValue (RateErrorModel::ERROR_UNIT_BIT));
+  em->SetAttribute ("IsEnabled", BooleanValue (false));
+  device->SetAttribute ("ReceiveErrorModel", PointerValue (em));
+
+  Configure (filename, ConfigStore::SAVE);
+
+  Config::SetDefault ("ns3::DropTailQueue::MaxPackets", UintegerValue (1));
+  Config::SetDefault ("ns3::DropTailQueue::Mode", EnumValue (DropTailQueue::QUEUE_MODE_PACKETS));
+  Config::SetDefault ("ns3::RateErrorModel::ErrorRate", DoubleValue (0.5));
+  Config::SetGlobal ("RngRun", IntegerValue (1));
+  em->SetAttribute ("ErrorRate", DoubleValue (0.75));
+  em->SetAttribute ("ErrorUnit", EnumValue (RateErrorModel::ERROR_UNIT_PACKET));
+  em->SetAttribute ("IsEnabled", BooleanValue (true));
+
+  Configure (filename, ConfigStore::LOAD);
+
+  // the defaults, through a new object
+  Ptr<DropTailQueue> queue = CreateObject<DropTailQueue> ();
+  UintegerValue maxPackets;
+  queue->GetAttribute ("MaxPackets", maxPackets);
+  NS_TEST_EXPECT_MSG_EQ (maxPackets.Get (), 1234, "Wrong uinteger default");
+  NS_TEST_EXPECT_MSG_EQ (queue->GetMode (), DropTailQueue::QUEUE_MODE_BYTES, "Wrong enum default");
+  DoubleValue rate;
+  CreateObject<RateErrorModel> ()->GetAttribute ("ErrorRate", rate);
+  NS_TEST_EXPECT_MSG_EQ (rate.Get (), 0.25, "Wrong double default");
+
+  IntegerValue run;
+  GlobalValue::GetValueByName ("RngRun", run);
+  NS_TEST_EXPECT_MSG_EQ (run.Get (), 7, "Wrong global value");
+
+  // the attributes of the object graph
+  em->GetAttribute ("ErrorRate", rate);
+  NS_TEST_EXPECT_MSG_EQ (rate.Get (), 0.125, "Wrong double attribute");
+  EnumValue unit;
+  em->GetAttribute ("ErrorUnit", unit);
+  NS_TEST_EXPECT_MSG_EQ (unit.Get (), RateErrorModel::ERROR_UNIT_BIT, "Wrong enum attribute");
+  NS_TEST_EXPECT_MSG_EQ (em->IsEnabled (), false, "Wrong boolean attribute");
+
+  Config::Reset ();
+  Simulator::Destroy ();
+  unlink (filename.c_str ());
+}
+
+// ===========================================================================
+// Test suite
+// ===========================================================================
+
+class ConfigStoreTestSuite : public TestSuite
+{
+public:
+  ConfigStoreTestSuite ();
+};
+
+ConfigStoreTestSuite::ConfigStoreTestSuite ()
+  : TestSuite ("config-store", UNIT)
+{
+  AddTestCase (new BinaryConfigRoundTripTestCase, TestCase::QUICK);
+}
+
+static ConfigStoreTestSuite configStoreTestSuite;
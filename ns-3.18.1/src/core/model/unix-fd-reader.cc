@@ -208,20 +208,37 @@ void FdReader::Run (void)
 
       if (FD_ISSET (m_fd, &readfds))
         {
-          struct FdReader::Data data = DoRead ();
-          // reading stops when m_len is zero
-          if (data.m_len == 0)
+          bool done = false;
+          do
             {
-              break;
+              struct FdReader::Data data = DoRead ();
+              // reading stops when m_len is zero
+              if (data.m_len == 0)
+                {
+                  done = true;
+                  break;
+                }
+              // the callback is only called when m_len is positive (data
+              // is ignored if m_len is negative)
+              else if (data.m_len > 0)
+                {
+                  m_readCallback (data.m_buf, data.m_len);
+                }
             }
-          // the callback is only called when m_len is positive (data
-          // is ignored if m_len is negative)
-          else if (data.m_len > 0)
+          while (HasPendingData ());
+
+          if (done)
             {
-              m_readCallback (data.m_buf, data.m_len);
+              break;
             }
         }
     }
 }
 
+bool
+FdReader::HasPendingData (void) const
+{
+  return false;
+}
+
 } // namespace ns3
@@ -89,6 +89,19 @@ protected:
    */
   virtual FdReader::Data DoRead (void) = 0;
 
+  /**
+   * \internal
+   * \brief Whether DoRead() has more data to return without reading
+   * the file descriptor again.
+   *
+   * Subclasses that read several frames at once return them one by one
+   * from DoRead() and override this method, so that the read thread
+   * drains them before waiting on the file descriptor again.
+   *
+   * \return true if DoRead() should be called again right away
+   */
+  virtual bool HasPendingData (void) const;
+
   /**
    * \internal
    * \brief The file descriptor to read from.
@@ -0,0 +1,116 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+//
+// Large shared CSMA segment
+//
+// Network topology
+//
+//       n0   n1   n2  ...  nN-1
+//       |    |    |         |
+//     ===========================
+//                LAN
+//
+// Every node but n0 sends UDP packets with an OnOff application to a
+// packet sink on n0. At the end, the program prints the wall clock time
+// of the run and the number of packets received, so that the event
+// reduction modes of the channel and the devices can be compared:
+//
+//   ./waf --run "csma-large-lan --nNodes=500"
+//   ./waf --run "csma-large-lan --nNodes=500 --filterDelivery=1 --backoffUntilIdle=1"
+//
+
+#include <iostream>
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/csma-module.h"
+#include "ns3/applications-module.h"
+#include "ns3/internet-module.h"
+#include "ns3/system-wall-clock-ms.h"
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("CsmaLargeLanExample");
+
+int
+main (int argc, char *argv[])
+{
+  uint32_t nNodes = 500;
+  double simTime = 10.0;
+  bool filterDelivery = false;
+  bool backoffUntilIdle = false;
+  std::string rate = "10kbps";
+
+  CommandLine cmd;
+  cmd.AddValue ("nNodes", "Number of nodes on the LAN", nNodes);
+  cmd.AddValue ("simTime", "Simulation time in seconds", simTime);
+  cmd.AddValue ("filterDelivery", "Deliver each packet only to the devices that accept it", filterDelivery);
+  cmd.AddValue ("backoffUntilIdle", "Skip the backoff sensing events that find the channel busy", backoffUntilIdle);
+  cmd.AddValue ("rate", "Data rate of each sender", rate);
+  cmd.Parse (argc, argv);
+
+  NS_ABORT_MSG_IF (nNodes < 2, "At least two nodes are needed");
+
+  NodeContainer nodes;
+  nodes.Create (nNodes);
+
+  CsmaHelper csma;
+  csma.SetChannelAttribute ("DataRate", DataRateValue (DataRate (100000000)));
+  csma.SetChannelAttribute ("Delay", TimeValue (MicroSeconds (5)));
+  csma.SetChannelAttribute ("FilterDelivery", BooleanValue (filterDelivery));
+  csma.SetDeviceAttribute ("BackoffUntilIdle", BooleanValue (backoffUntilIdle));
+  NetDeviceContainer devices = csma.Install (nodes);
+
+  InternetStackHelper internet;
+  internet.Install (nodes);
+
+  Ipv4AddressHelper ipv4;
+  ipv4.SetBase ("10.1.0.0", "255.255.0.0");
+  Ipv4InterfaceContainer interfaces = ipv4.Assign (devices);
+
+  uint16_t port = 9;
+  PacketSinkHelper sink ("ns3::UdpSocketFactory", InetSocketAddress (Ipv4Address::GetAny (), port));
+  ApplicationContainer sinkApp = sink.Install (nodes.Get (0));
+  sinkApp.Start (Seconds (0.0));
+
+  OnOffHelper onoff ("ns3::UdpSocketFactory", Address (InetSocketAddress (interfaces.GetAddress (0), port)));
+  onoff.SetConstantRate (DataRate (rate), 512);
+  NodeContainer senders;
+  for (uint32_t i = 1; i < nNodes; ++i)
+    {
+      senders.Add (nodes.Get (i));
+    }
+  ApplicationContainer apps = onoff.Install (senders);
+  apps.Start (Seconds (1.0));
+  apps.Stop (Seconds (simTime));
+
+  SystemWallClockMs clock;
+  clock.Start ();
+  Simulator::Stop (Seconds (simTime));
+  Simulator::Run ();
+  int64_t elapsed = clock.End ();
+
+  std::cout << "nodes " << nNodes
+            << " filterDelivery " << filterDelivery
+            << " backoffUntilIdle " << backoffUntilIdle
+            << " wallclock(ms) " << elapsed
+            << " received " << DynamicCast<PacketSink> (sinkApp.Get (0))->GetTotalRx () / 512
+            << std::endl;
+
+  Simulator::Destroy ();
+  return 0;
+}
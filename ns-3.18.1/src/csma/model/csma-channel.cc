@@ -23,6 +23,9 @@
 #include "ns3/packet.h"
 #include "ns3/simulator.h"
 #include "ns3/log.h"
+#include "ns3/boolean.h"
+#include "ns3/node.h"
+#include "ns3/ethernet-header.h"
 
 NS_LOG_COMPONENT_DEFINE ("CsmaChannel");
 
@@ -45,6 +48,15 @@ CsmaChannel::GetTypeId (void)
                    TimeValue (Seconds (0)),
                    MakeTimeAccessor (&CsmaChannel::m_delay),
                    MakeTimeChecker ())
+    .AddAttribute ("FilterDelivery",
+                   "If true, the reception of a packet is only scheduled on the devices that "
+                   "pass it up to their node: the unicast destination, every device for "
+                   "broadcast and multicast packets, and the promiscuous devices.  The other "
+                   "devices do not see the packet, so their PhyRxEnd and sniffer traces do not "
+                   "fire for it.",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&CsmaChannel::m_filterDelivery),
+                   MakeBooleanChecker ())
   ;
   return tid;
 }
@@ -55,6 +67,7 @@ CsmaChannel::CsmaChannel ()
 {
   NS_LOG_FUNCTION_NOARGS ();
   m_state = IDLE;
+  m_filterDelivery = false;
   m_deviceList.clear ();
 }
 
@@ -190,6 +203,7 @@ CsmaChannel::TransmitStart (Ptr<Packet> p, uint32_t srcId)
   m_currentPkt = p;
   m_currentSrc = srcId;
   m_state = TRANSMITTING;
+  m_idleTime = Simulator::Now () + Seconds (m_bps.CalculateTxTime (p->GetSize ())) + m_delay;
   return true;
 }
 
@@ -221,11 +235,21 @@ CsmaChannel::TransmitEnd ()
 
   NS_LOG_LOGIC ("Receive");
 
+  m_idleTime = Simulator::Now () + m_delay;
+
+  Mac48Address destination;
+  if (m_filterDelivery)
+    {
+      EthernetHeader header (false);
+      m_currentPkt->PeekHeader (header);
+      destination = header.GetDestination ();
+    }
+
   std::vector<CsmaDeviceRec>::iterator it;
   uint32_t devId = 0;
   for (it = m_deviceList.begin (); it < m_deviceList.end (); it++)
     {
-      if (it->IsActive ())
+      if (it->IsActive () && (!m_filterDelivery || it->devicePtr->IsReceiver (destination)))
         {
           // schedule reception events
           Simulator::ScheduleWithContext (it->devicePtr->GetNode ()->GetId (),
@@ -242,6 +266,16 @@ CsmaChannel::TransmitEnd ()
   return retVal;
 }
 
+Time
+CsmaChannel::GetIdleTime (void)
+{
+  if (m_state == IDLE || m_idleTime < Simulator::Now ())
+    {
+      return Simulator::Now ();
+    }
+  return m_idleTime;
+}
+
 void
 CsmaChannel::PropagationCompleteEvent ()
 {
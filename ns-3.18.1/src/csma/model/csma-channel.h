@@ -192,6 +192,16 @@ public:
    */
   void PropagationCompleteEvent ();
 
+  /**
+   * \brief Get the time at which the channel is expected to become idle
+   *
+   * While a packet is being transmitted or propagated, this is the end
+   * of its propagation. If the channel is idle, this is the current time.
+   *
+   * \return the time the channel becomes idle
+   */
+  Time GetIdleTime (void);
+
   /**
    * \return Returns the device number assigned to a net device by the
    * channel
@@ -319,6 +329,17 @@ private:
    * Current state of the channel
    */
   WireState          m_state;
+
+  /**
+   * Time at which the packet currently on the channel will have
+   * propagated to all the net devices
+   */
+  Time          m_idleTime;
+
+  /**
+   * Deliver each packet only to the devices that pass it up to their node
+   */
+  bool          m_filterDelivery;
 };
 
 } // namespace ns3
@@ -71,6 +71,16 @@ CsmaNetDevice::GetTypeId (void)
                    BooleanValue (true),
                    MakeBooleanAccessor (&CsmaNetDevice::m_receiveEnable),
                    MakeBooleanChecker ())
+    .AddAttribute ("BackoffUntilIdle",
+                   "If true, a device that finds the channel busy skips the sensing events that "
+                   "would find it still busy and senses it again at the end of the first backoff "
+                   "period that expires once the channel is idle.  The backoffs and the retries "
+                   "are the same as when sensing after each backoff period, so transmission times "
+                   "only differ when a backoff expires exactly when the channel becomes idle or "
+                   "in the same time step as the backoff of another device.",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&CsmaNetDevice::m_backoffUntilIdle),
+                   MakeBooleanChecker ())
     .AddAttribute ("ReceiveErrorModel", 
                    "The receiver error model used to simulate packet loss",
                    PointerValue (),
@@ -241,6 +251,12 @@ CsmaNetDevice::SetReceiveEnable (bool receiveEnable)
   m_receiveEnable = receiveEnable;
 }
 
+bool
+CsmaNetDevice::IsReceiver (Mac48Address destination) const
+{
+  return destination.IsGroup () || destination == m_address || !m_promiscRxCallback.IsNull ();
+}
+
 bool
 CsmaNetDevice::IsSendEnabled (void)
 {
@@ -462,6 +478,22 @@ CsmaNetDevice::TransmitStart (void)
 
           m_backoff.IncrNumRetries ();
           Time backoffTime = m_backoff.GetBackoffTime ();
+          if (m_backoffUntilIdle)
+            {
+              //
+              // Nobody can start transmitting before the current packet has
+              // propagated, so every sensing before that time finds the channel
+              // busy.  Skip these sensing events, but draw the same backoffs and
+              // count the same retries as they would.
+              //
+              Time idleTime = m_channel->GetIdleTime ();
+              while (Simulator::Now () + backoffTime < idleTime && !m_backoff.MaxRetriesReached ())
+                {
+                  m_macTxBackoffTrace (m_currentPkt);
+                  m_backoff.IncrNumRetries ();
+                  backoffTime += m_backoff.GetBackoffTime ();
+                }
+            }
 
           NS_LOG_LOGIC ("Channel busy, backing off for " << backoffTime.GetSeconds () << " sec");
 
@@ -162,6 +162,15 @@ public:
    */
   void Receive (Ptr<Packet> p, Ptr<CsmaNetDevice> sender);
 
+  /**
+   * Does the device pass the packets sent to an address up to its node?
+   *
+   * \param destination the destination address of a packet
+   * \returns True if the address is the address of the device, a broadcast
+   * or multicast address, or if the device is promiscuous.
+   */
+  bool IsReceiver (Mac48Address destination) const;
+
   /**
    * Is the send side of the network device enabled?
    *
@@ -502,6 +511,11 @@ private:
    */
   Backoff m_backoff;
 
+  /**
+   * Skip the sensing events that would find the channel busy
+   */
+  bool m_backoffUntilIdle;
+
   /**
    * Next packet that will be transmitted (if transmitter is not
    * currently transmitting) or packet that is currently being
@@ -0,0 +1,168 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <sstream>
+#include "ns3/test.h"
+#include "ns3/simulator.h"
+#include "ns3/log.h"
+#include "ns3/boolean.h"
+#include "ns3/data-rate.h"
+#include "ns3/nstime.h"
+#include "ns3/packet.h"
+#include "ns3/node-container.h"
+#include "ns3/net-device-container.h"
+#include "ns3/csma-helper.h"
+#include "ns3/csma-net-device.h"
+
+NS_LOG_COMPONENT_DEFINE ("CsmaTest");
+
+namespace ns3 {
+
+/**
+ * Checks that the FilterDelivery attribute of the channel and the
+ * BackoffUntilIdle attribute of the devices do not change the times at
+ * which the nodes receive the unicast and broadcast packets, on a channel
+ * where the devices contend for the medium.
+ */
+class CsmaEventReductionTestCase : public TestCase
+{
+public:
+  /**
+   * \param filterDelivery the value of the FilterDelivery attribute
+   * \param backoffUntilIdle the value of the BackoffUntilIdle attribute
+   */
+  CsmaEventReductionTestCase (bool filterDelivery, bool backoffUntilIdle);
+  virtual ~CsmaEventReductionTestCase ();
+
+private:
+  virtual void DoRun (void);
+  static std::string RunSimulation (bool filterDelivery, bool backoffUntilIdle,
+                                    uint32_t *backoffs);
+  static void SendPacket (Ptr<NetDevice> device, Address destination, uint32_t size);
+  static void MacRx (std::ostringstream *trace, uint32_t nodeId, Ptr<const Packet> p);
+  static void MacTxBackoff (uint32_t *backoffs, Ptr<const Packet> p);
+
+  bool m_filterDelivery;
+  bool m_backoffUntilIdle;
+};
+
+CsmaEventReductionTestCase::CsmaEventReductionTestCase (bool filterDelivery, bool backoffUntilIdle)
+  : TestCase ("Receive times with FilterDelivery " + std::string (filterDelivery ? "on" : "off")
+              + " and BackoffUntilIdle " + std::string (backoffUntilIdle ? "on" : "off")),
+    m_filterDelivery (filterDelivery),
+    m_backoffUntilIdle (backoffUntilIdle)
+{
+}
+
+CsmaEventReductionTestCase::~CsmaEventReductionTestCase ()
+{
+}
+
+void
+CsmaEventReductionTestCase::SendPacket (Ptr<NetDevice> device, Address destination, uint32_t size)
+{
+  device->Send (Create<Packet> (size), destination, 0x800);
+}
+
+void
+CsmaEventReductionTestCase::MacRx (std::ostringstream *trace, uint32_t nodeId, Ptr<const Packet> p)
+{
+  *trace << nodeId << " " << Simulator::Now ().GetNanoSeconds () << " " << p->GetSize () << "\n";
+}
+
+void
+CsmaEventReductionTestCase::MacTxBackoff (uint32_t *backoffs, Ptr<const Packet> p)
+{
+  ++*backoffs;
+}
+
+std::string
+CsmaEventReductionTestCase::RunSimulation (bool filterDelivery, bool backoffUntilIdle,
+                                           uint32_t *backoffs)
+{
+  NodeContainer nodes;
+  nodes.Create (6);
+
+  CsmaHelper csma;
+  csma.SetChannelAttribute ("DataRate", DataRateValue (DataRate (10000000)));
+  csma.SetChannelAttribute ("Delay", TimeValue (NanoSeconds (6560)));
+  csma.SetChannelAttribute ("FilterDelivery", BooleanValue (filterDelivery));
+  csma.SetDeviceAttribute ("BackoffUntilIdle", BooleanValue (backoffUntilIdle));
+  NetDeviceContainer devices = csma.Install (nodes);
+  // both runs must draw the same backoffs
+  csma.AssignStreams (devices, 0);
+
+  std::ostringstream trace;
+  *backoffs = 0;
+  for (uint32_t i = 0; i < devices.GetN (); ++i)
+    {
+      devices.Get (i)->TraceConnectWithoutContext ("MacRx",
+                                                   MakeBoundCallback (&CsmaEventReductionTestCase::MacRx,
+                                                                      &trace, i));
+      devices.Get (i)->TraceConnectWithoutContext ("MacTxBackoff",
+                                                   MakeBoundCallback (&CsmaEventReductionTestCase::MacTxBackoff,
+                                                                      backoffs));
+      // the devices start sending a few nanoseconds apart, so that they
+      // contend for the channel but never sense it at the same time; every
+      // third packet is a broadcast, the others go to the next device
+      for (uint32_t j = 0; j < 10; ++j)
+        {
+          Address destination = devices.Get ((i + 1) % devices.GetN ())->GetAddress ();
+          if (j % 3 == 0)
+            {
+              destination = devices.Get (i)->GetBroadcast ();
+            }
+          Simulator::Schedule (Seconds (1.0) + NanoSeconds (137 * i) + MicroSeconds (300 * j),
+                               &CsmaEventReductionTestCase::SendPacket, devices.Get (i),
+                               destination, 100 + 100 * i);
+        }
+    }
+
+  Simulator::Run ();
+  Simulator::Destroy ();
+  return trace.str ();
+}
+
+void
+CsmaEventReductionTestCase::DoRun (void)
+{
+  uint32_t referenceBackoffs;
+  uint32_t backoffs;
+  std::string reference = RunSimulation (false, false, &referenceBackoffs);
+  std::string trace = RunSimulation (m_filterDelivery, m_backoffUntilIdle, &backoffs);
+
+  NS_TEST_ASSERT_MSG_EQ (reference.empty (), false, "No packet was received");
+  NS_TEST_ASSERT_MSG_GT (referenceBackoffs, 0, "The devices did not contend for the channel");
+  NS_TEST_EXPECT_MSG_EQ (trace, reference, "The receive times differ");
+  NS_TEST_EXPECT_MSG_EQ (backoffs, referenceBackoffs, "The number of backoffs differs");
+}
+
+
+static class CsmaTestSuite : public TestSuite
+{
+public:
+  CsmaTestSuite ();
+} g_csmaTestSuite;
+
+CsmaTestSuite::CsmaTestSuite ()
+  : TestSuite ("csma", UNIT)
+{
+  AddTestCase (new CsmaEventReductionTestCase (true, false), TestCase::QUICK);
+  AddTestCase (new CsmaEventReductionTestCase (false, true), TestCase::QUICK);
+  AddTestCase (new CsmaEventReductionTestCase (true, true), TestCase::QUICK);
+}
+
+} // namespace ns3
@@ -0,0 +1,180 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/*
+ * DSR scalability benchmark.
+ *
+ * nWifis nodes move with the random waypoint model in a square area whose
+ * side grows with the square root of the number of nodes, so the node
+ * density stays constant. nFlows CBR flows run between random node pairs.
+ * At the end the simulation prints the wall clock time and the packet
+ * delivery ratio, e.g.
+ *
+ *   ./waf --run "dsr-scalability --nWifis=100"
+ *   ./waf --run "dsr-scalability --nWifis=500 --cacheType=PathCache"
+ */
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/applications-module.h"
+#include "ns3/mobility-module.h"
+#include "ns3/wifi-module.h"
+#include "ns3/internet-module.h"
+#include "ns3/dsr-module.h"
+#include "ns3/system-wall-clock-ms.h"
+#include <cmath>
+#include <iostream>
+#include <sstream>
+
+using namespace ns3;
+NS_LOG_COMPONENT_DEFINE ("DsrScalability");
+
+int
+main (int argc, char *argv[])
+{
+  uint32_t nWifis = 100;
+  uint32_t nFlows = 10;
+  double totalTime = 100.0;
+  double dataStart = 10.0;
+  double nodeSpeed = 5.0;
+  double pauseTime = 0.0;
+  double txpDistance = 250.0;
+  double density = 100.0 * 100.0; // square meters per node
+  uint32_t packetSize = 64;
+  std::string rate = "2048bps";
+  std::string cacheType = "LinkCache";
+  std::string phyMode ("DsssRate11Mbps");
+
+  CommandLine cmd;
+  cmd.AddValue ("nWifis", "Number of wifi nodes", nWifis);
+  cmd.AddValue ("nFlows", "Number of CBR flows", nFlows);
+  cmd.AddValue ("totalTime", "Simulation time in seconds", totalTime);
+  cmd.AddValue ("nodeSpeed", "Maximum node speed in RandomWayPoint model", nodeSpeed);
+  cmd.AddValue ("pauseTime", "pauseTime for mobility model", pauseTime);
+  cmd.AddValue ("txpDistance", "Specify node's transmit range", txpDistance);
+  cmd.AddValue ("density", "Area per node in square meters", density);
+  cmd.AddValue ("rate", "CBR traffic rate of each flow", rate);
+  cmd.AddValue ("cacheType", "DSR route cache, LinkCache or PathCache", cacheType);
+  cmd.Parse (argc, argv);
+
+  NS_ABORT_MSG_IF (nWifis < 2, "At least two nodes are needed");
+
+  SeedManager::SetSeed (10);
+  SeedManager::SetRun (1);
+
+  NodeContainer adhocNodes;
+  adhocNodes.Create (nWifis);
+
+  Config::SetDefault ("ns3::WifiRemoteStationManager::NonUnicastMode", StringValue (phyMode));
+  Config::SetDefault ("ns3::WifiRemoteStationManager::RtsCtsThreshold", StringValue ("2200"));
+  Config::SetDefault ("ns3::WifiRemoteStationManager::FragmentationThreshold", StringValue ("2200"));
+  Config::SetDefault ("ns3::dsr::DsrRouting::CacheType", StringValue (cacheType));
+
+  WifiHelper wifi;
+  wifi.SetStandard (WIFI_PHY_STANDARD_80211b);
+  YansWifiPhyHelper wifiPhy = YansWifiPhyHelper::Default ();
+  YansWifiChannelHelper wifiChannel;
+  wifiChannel.SetPropagationDelay ("ns3::ConstantSpeedPropagationDelayModel");
+  wifiChannel.AddPropagationLoss ("ns3::RangePropagationLossModel", "MaxRange", DoubleValue (txpDistance));
+  wifiPhy.SetChannel (wifiChannel.Create ());
+  NqosWifiMacHelper wifiMac = NqosWifiMacHelper::Default ();
+  wifi.SetRemoteStationManager ("ns3::ConstantRateWifiManager", "DataMode", StringValue (phyMode),
+                                "ControlMode", StringValue (phyMode));
+  wifiMac.SetType ("ns3::AdhocWifiMac");
+  NetDeviceContainer allDevices = wifi.Install (wifiPhy, wifiMac, adhocNodes);
+
+  // Keep the node density constant as the network grows
+  double side = std::sqrt (density * nWifis);
+  std::ostringstream coordinate;
+  coordinate << "ns3::UniformRandomVariable[Min=0.0|Max=" << side << "]";
+  ObjectFactory pos;
+  pos.SetTypeId ("ns3::RandomRectanglePositionAllocator");
+  pos.Set ("X", StringValue (coordinate.str ()));
+  pos.Set ("Y", StringValue (coordinate.str ()));
+  Ptr<PositionAllocator> positionAlloc = pos.Create ()->GetObject<PositionAllocator> ();
+
+  std::ostringstream speed;
+  speed << "ns3::UniformRandomVariable[Min=0.0|Max=" << nodeSpeed << "]";
+  std::ostringstream pause;
+  pause << "ns3::ConstantRandomVariable[Constant=" << pauseTime << "]";
+
+  MobilityHelper adhocMobility;
+  adhocMobility.SetMobilityModel ("ns3::RandomWaypointMobilityModel",
+                                  "Speed", StringValue (speed.str ()),
+                                  "Pause", StringValue (pause.str ()),
+                                  "PositionAllocator", PointerValue (positionAlloc));
+  adhocMobility.SetPositionAllocator (positionAlloc);
+  adhocMobility.Install (adhocNodes);
+
+  InternetStackHelper internet;
+  DsrMainHelper dsrMain;
+  DsrHelper dsr;
+  internet.Install (adhocNodes);
+  dsrMain.Install (dsr, adhocNodes);
+
+  Ipv4AddressHelper address;
+  address.SetBase ("10.1.0.0", "255.255.0.0");
+  Ipv4InterfaceContainer allInterfaces = address.Assign (allDevices);
+
+  uint16_t port = 9;
+  Ptr<UniformRandomVariable> pick = CreateObject<UniformRandomVariable> ();
+  ApplicationContainer sinks;
+  for (uint32_t i = 0; i < nFlows; ++i)
+    {
+      uint32_t src = pick->GetInteger (0, nWifis - 1);
+      uint32_t dst = pick->GetInteger (0, nWifis - 2);
+      if (dst >= src)
+        {
+          dst++;
+        }
+      PacketSinkHelper sink ("ns3::UdpSocketFactory", InetSocketAddress (Ipv4Address::GetAny (), port + i));
+      sinks.Add (sink.Install (adhocNodes.Get (dst)));
+
+      OnOffHelper onoff ("ns3::UdpSocketFactory", Address (InetSocketAddress (allInterfaces.GetAddress (dst), port + i)));
+      onoff.SetAttribute ("OnTime", StringValue ("ns3::ConstantRandomVariable[Constant=1.0]"));
+      onoff.SetAttribute ("OffTime", StringValue ("ns3::ConstantRandomVariable[Constant=0.0]"));
+      onoff.SetAttribute ("PacketSize", UintegerValue (packetSize));
+      onoff.SetAttribute ("DataRate", DataRateValue (DataRate (rate)));
+      ApplicationContainer source = onoff.Install (adhocNodes.Get (src));
+      source.Start (Seconds (dataStart + pick->GetValue (0.0, 1.0)));
+      source.Stop (Seconds (totalTime));
+    }
+  sinks.Start (Seconds (0.0));
+  sinks.Stop (Seconds (totalTime));
+
+  SystemWallClockMs clock;
+  clock.Start ();
+  Simulator::Stop (Seconds (totalTime));
+  Simulator::Run ();
+  int64_t elapsed = clock.End ();
+
+  uint64_t received = 0;
+  for (ApplicationContainer::Iterator i = sinks.Begin (); i != sinks.End (); ++i)
+    {
+      received += DynamicCast<PacketSink> (*i)->GetTotalRx ();
+    }
+  double expected = DataRate (rate).GetBitRate () / 8.0 * (totalTime - dataStart) * nFlows;
+
+  std::cout << "nodes " << nWifis
+            << " flows " << nFlows
+            << " cache " << cacheType
+            << " wallclock(ms) " << elapsed
+            << " pdr " << (expected > 0 ? received / expected : 0)
+            << std::endl;
+
+  Simulator::Destroy ();
+  return 0;
+}
@@ -74,7 +74,16 @@ MaintainBuffer::Enqueue (MaintainBuffEntry & entry)
       NS_LOG_DEBUG ("Drop the most aged packet");
       m_maintainBuffer.erase (m_maintainBuffer.begin ());        // Drop the most aged packet
     }
-  m_maintainBuffer.push_back (entry);
+  /*
+   * Keep the buffer ordered by expire time so that Purge only has to look at
+   * the front. With a constant timeout this is a plain push_back.
+   */
+  std::vector<MaintainBuffEntry>::iterator pos = m_maintainBuffer.end ();
+  while (pos != m_maintainBuffer.begin () && (pos - 1)->GetExpireTime () > entry.GetExpireTime ())
+    {
+      --pos;
+    }
+  m_maintainBuffer.insert (pos, entry);
   return true;
 }
 
@@ -222,9 +231,14 @@ void
 MaintainBuffer::Purge ()
 {
   NS_LOG_DEBUG ("Purging Maintenance Buffer");
+  // The buffer is kept in expire time order, only the front can be expired
   IsExpired pred;
-  m_maintainBuffer.erase (std::remove_if (m_maintainBuffer.begin (), m_maintainBuffer.end (), pred),
-                          m_maintainBuffer.end ());
+  std::vector<MaintainBuffEntry>::iterator i = m_maintainBuffer.begin ();
+  while (i != m_maintainBuffer.end () && pred (*i))
+    {
+      ++i;
+    }
+  m_maintainBuffer.erase (m_maintainBuffer.begin (), i);
 }
 
 }  // namespace dsr
@@ -260,7 +260,7 @@ public:
   // \}
 
 private:
-  // / The vector of maintain buffer entries
+  // / The vector of maintain buffer entries, in expire time order
   std::vector<MaintainBuffEntry> m_maintainBuffer;
   std::vector<NetworkKey> m_allNetworkKey;
   // / Remove all expired entries
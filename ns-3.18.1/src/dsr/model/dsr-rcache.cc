@@ -146,6 +146,7 @@ RouteCache::RouteCache ()
   : m_vector (0),
     m_maxEntriesEachDst (3),
     m_isLinkCache (false),
+    m_linkCacheChanged (false),
     m_ntimer (Timer::CANCEL_ON_DESTROY),
     m_delay (MilliSeconds (100))
 {
@@ -364,7 +365,8 @@ RouteCache::RebuildBestRouteTable (Ipv4Address source)
       if (!tempip.IsBroadcast ())
         {
           s[tempip] = true;
-          for (std::map<Ipv4Address, uint32_t>::const_iterator k = m_netGraph[tempip].begin (); k != m_netGraph[tempip].end (); ++k)
+          std::map<Ipv4Address, uint32_t> const & neighbors = m_netGraph[tempip];
+          for (std::map<Ipv4Address, uint32_t>::const_iterator k = neighbors.begin (); k != neighbors.end (); ++k)
             {
               if (s.find (k->first) == s.end () && d[k->first] > d[tempip] + k->second)
                 {
@@ -433,6 +435,11 @@ RouteCache::LookupRoute_Link (Ipv4Address id, RouteCacheEntry & rt)
   NS_LOG_FUNCTION (this << id);
   /// We need to purge the link node cache
   PurgeLinkNode ();
+  if (m_linkCacheChanged && !m_bestRoutesTable_link.empty ())
+    {
+      // Expired links have been purged, the cached best routes may use them
+      UpdateBestRoutes (m_bestRoutesSource);
+    }
   std::map<Ipv4Address, RouteCacheEntry::IP_VECTOR>::const_iterator i = m_bestRoutesTable_link.find (id);
   if (i == m_bestRoutesTable_link.end ())
     {
@@ -471,6 +478,7 @@ RouteCache::PurgeLinkNode ()
         {
           ++i;
           m_linkCache.erase (itmp);
+          m_linkCacheChanged = true;
         }
       else
         {
@@ -509,6 +517,21 @@ RouteCache::UpdateNetGraph ()
     }
 }
 
+void
+RouteCache::UpdateBestRoutes (Ipv4Address source)
+{
+  NS_LOG_FUNCTION (this << source);
+  if (!m_linkCacheChanged && source == m_bestRoutesSource)
+    {
+      NS_LOG_LOGIC ("The link cache has not changed, keep the best routes");
+      return;
+    }
+  UpdateNetGraph ();
+  RebuildBestRouteTable (source);
+  m_bestRoutesSource = source;
+  m_linkCacheChanged = false;
+}
+
 bool
 RouteCache::IncStability (Ipv4Address node)
 {
@@ -594,14 +617,21 @@ RouteCache::AddRoute_Link (RouteCacheEntry::IP_VECTOR nodelist, Ipv4Address sour
           /// Set the link stability as the m)minLifeTime, default is 1 second
           stab.SetLinkStability (m_minLifeTime);
         }
+      // the best routes prefer the most stable links, so a new stability
+      // changes them as much as a new link
+      std::map<Link, LinkStab>::iterator oldStab = m_linkCache.find (link);
+      if (oldStab == m_linkCache.end ()
+          || oldStab->second.GetLinkStability () != stab.GetLinkStability ())
+        {
+          m_linkCacheChanged = true;
+        }
       m_linkCache[link] = stab;
       NS_LOG_DEBUG ("Add a new link");
       link.Print ();
       NS_LOG_DEBUG ("Link Info");
       stab.Print ();
     }
-  UpdateNetGraph ();
-  RebuildBestRouteTable (source);
+  UpdateBestRoutes (source);
   return true;
 }
 
@@ -624,6 +654,7 @@ RouteCache::UseExtends (RouteCacheEntry::IP_VECTOR rt)
           if (m_linkCache[link].GetLinkStability () < m_useExtends)
             {
               m_linkCache[link].SetLinkStability (m_useExtends);
+              m_linkCacheChanged = true;
               /// \todo remove after debug
               NS_LOG_INFO ("The time of the link " << m_linkCache[link].GetLinkStability ().GetSeconds ());
             }
@@ -784,10 +815,16 @@ RouteCache::DeleteAllRoutesIncludeLink (Ipv4Address errorSrc, Ipv4Address unreac
       Link link2 (unreachNode, errorSrc);
       // erase the two kind of links to make sure the link is removed from the link cache
       NS_LOG_DEBUG ("Erase the route");
-      m_linkCache.erase (link1);
+      if (m_linkCache.erase (link1))
+        {
+          m_linkCacheChanged = true;
+        }
       /// \todo get rid of this one
       NS_LOG_DEBUG ("The link cache size " << m_linkCache.size());
-      m_linkCache.erase (link2);
+      if (m_linkCache.erase (link2))
+        {
+          m_linkCacheChanged = true;
+        }
       NS_LOG_DEBUG ("The link cache size " << m_linkCache.size());
 
       std::map<Ipv4Address, NodeStab>::iterator i = m_nodeCache.find (errorSrc);
@@ -808,8 +845,7 @@ RouteCache::DeleteAllRoutesIncludeLink (Ipv4Address errorSrc, Ipv4Address unreac
         {
           DecStability (i->first);
         }
-      UpdateNetGraph ();
-      RebuildBestRouteTable (node);
+      UpdateBestRoutes (node);
     }
   else
     {
@@ -606,6 +606,8 @@ private:
   std::map<Ipv4Address, RouteCacheEntry::IP_VECTOR> m_bestRoutesTable_link;     ///< for link route cache
   std::map<Link, LinkStab> m_linkCache;                                         ///< The data structure to store link info
   std::map<Ipv4Address, NodeStab> m_nodeCache;                                  ///< The data structure to store node info
+  bool m_linkCacheChanged;                                                      ///< A link was added, removed or changed stability since the last rebuild
+  Ipv4Address m_bestRoutesSource;                                               ///< The source m_bestRoutesTable_link was computed for
   /**
    * \brief used by LookupRoute when LinkCache
    * \param id the ip address we are looking for
@@ -637,6 +639,12 @@ public:
    *  \param The source address the routes based on
    */
   void RebuildBestRouteTable (Ipv4Address source);
+  /**
+   *  \brief Update the net graph and rebuild the best route table, only when a link has been added or
+   *  removed since the last rebuild or the source has changed
+   *  \param source The source address the routes based on
+   */
+  void UpdateBestRoutes (Ipv4Address source);
   void PurgeLinkNode ();
   /**
    * When a link from the Route Cache is used in routing a packet originated or salvaged
@@ -74,8 +74,16 @@ SendBuffer::Enqueue (SendBuffEntry & entry)
       Drop (m_sendBuffer.front (), "Drop the most aged packet");         // Drop the most aged packet
       m_sendBuffer.erase (m_sendBuffer.begin ());
     }
-  // enqueue the entry
-  m_sendBuffer.push_back (entry);
+  /*
+   * Keep the buffer ordered by expire time so that Purge only has to look at
+   * the front. With a constant timeout this is a plain push_back.
+   */
+  std::vector<SendBuffEntry>::iterator pos = m_sendBuffer.end ();
+  while (pos != m_sendBuffer.begin () && (pos - 1)->GetExpireTime () > entry.GetExpireTime ())
+    {
+      --pos;
+    }
+  m_sendBuffer.insert (pos, entry);
   return true;
 }
 
@@ -151,21 +159,18 @@ void
 SendBuffer::Purge ()
 {
   /*
-   * Purge the buffer to eliminate expired entries
+   * Purge the buffer to eliminate expired entries, the buffer is kept in
+   * expire time order so the expired entries are all at the front
    */
   NS_LOG_INFO ("The send buffer size " << m_sendBuffer.size ());
   IsExpired pred;
-  for (std::vector<SendBuffEntry>::iterator i = m_sendBuffer.begin (); i
-       != m_sendBuffer.end (); ++i)
+  std::vector<SendBuffEntry>::iterator i = m_sendBuffer.begin ();
+  for (; i != m_sendBuffer.end () && pred (*i); ++i)
     {
-      if (pred (*i))
-        {
-          NS_LOG_DEBUG ("Dropping Queue Packets");
-          Drop (*i, "Drop out-dated packet ");
-        }
+      NS_LOG_DEBUG ("Dropping Queue Packets");
+      Drop (*i, "Drop out-dated packet ");
     }
-  m_sendBuffer.erase (std::remove_if (m_sendBuffer.begin (), m_sendBuffer.end (), pred),
-                      m_sendBuffer.end ());
+  m_sendBuffer.erase (m_sendBuffer.begin (), i);
 }
 
 void
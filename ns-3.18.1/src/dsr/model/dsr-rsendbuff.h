@@ -157,7 +157,7 @@ public:
 
 private:
 
-  std::vector<SendBuffEntry> m_sendBuffer;                      ///< The send buffer to cache unsent packet
+  std::vector<SendBuffEntry> m_sendBuffer;                      ///< The send buffer to cache unsent packet, in expire time order
   void Purge ();                                                ///< Remove all expired entries
   void Drop (SendBuffEntry en, std::string reason);             ///< Notify that packet is dropped from queue by timeout
   uint32_t m_maxLen;                                            ///< The maximum number of packets that we allow a routing protocol to buffer.
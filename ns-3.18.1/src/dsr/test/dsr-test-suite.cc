@@ -384,6 +384,141 @@ DsrCacheEntryTest::DoRun ()
   NS_TEST_EXPECT_MSG_EQ (rcache->DeleteRoute (Ipv4Address ("1.1.1.1")), false, "trivial");
 }
 // -----------------------------------------------------------------------------
+// / Unit test for DSR link cache
+class DsrLinkCacheTest : public TestCase
+{
+public:
+  DsrLinkCacheTest ();
+  ~DsrLinkCacheTest ();
+  virtual void
+  DoRun (void);
+};
+DsrLinkCacheTest::DsrLinkCacheTest ()
+  : TestCase ("DSR link cache")
+{
+}
+DsrLinkCacheTest::~DsrLinkCacheTest ()
+{
+}
+void
+DsrLinkCacheTest::DoRun ()
+{
+  Ptr<dsr::RouteCache> rcache = CreateObject<dsr::RouteCache> ();
+  rcache->SetCacheType ("LinkCache");
+  rcache->SetInitStability (Seconds (25));
+  rcache->SetMinLifeTime (Seconds (1));
+  rcache->SetStabilityDecrFactor (2);
+  rcache->SetStabilityIncrFactor (4);
+
+  Ipv4Address a ("10.1.1.1");
+  Ipv4Address b ("10.1.1.2");
+  Ipv4Address c ("10.1.1.3");
+  Ipv4Address d ("10.1.1.4");
+  std::vector<Ipv4Address> path;
+  path.push_back (a);
+  path.push_back (b);
+  path.push_back (c);
+  path.push_back (d);
+  NS_TEST_EXPECT_MSG_EQ (rcache->AddRoute_Link (path, a), true, "trivial");
+
+  dsr::RouteCacheEntry entry;
+  NS_TEST_EXPECT_MSG_EQ (rcache->LookupRoute (d, entry), true, "Route through the link cache");
+  NS_TEST_EXPECT_MSG_EQ (entry.GetVector ().size (), 4, "a-b-c-d");
+
+  // Adding the same links again keeps the best routes
+  NS_TEST_EXPECT_MSG_EQ (rcache->AddRoute_Link (path, a), true, "trivial");
+  NS_TEST_EXPECT_MSG_EQ (rcache->LookupRoute (d, entry), true, "trivial");
+  NS_TEST_EXPECT_MSG_EQ (entry.GetVector ().size (), 4, "a-b-c-d");
+
+  // A new link gives a shorter route
+  std::vector<Ipv4Address> shortcut;
+  shortcut.push_back (a);
+  shortcut.push_back (d);
+  NS_TEST_EXPECT_MSG_EQ (rcache->AddRoute_Link (shortcut, a), true, "trivial");
+  NS_TEST_EXPECT_MSG_EQ (rcache->LookupRoute (d, entry), true, "trivial");
+  NS_TEST_EXPECT_MSG_EQ (entry.GetVector ().size (), 2, "a-d");
+
+  // Removing the link falls back to the long route
+  rcache->DeleteAllRoutesIncludeLink (a, d, a);
+  NS_TEST_EXPECT_MSG_EQ (rcache->LookupRoute (d, entry), true, "trivial");
+  NS_TEST_EXPECT_MSG_EQ (entry.GetVector ().size (), 4, "a-b-c-d");
+
+  rcache->DeleteAllRoutesIncludeLink (b, c, a);
+  NS_TEST_EXPECT_MSG_EQ (rcache->LookupRoute (d, entry), false, "No route after the link is removed");
+  NS_TEST_EXPECT_MSG_EQ (rcache->LookupRoute (b, entry), true, "trivial");
+}
+// -----------------------------------------------------------------------------
+// / Unit test for the link stability in the DSR link cache
+class DsrLinkStabilityTest : public TestCase
+{
+public:
+  DsrLinkStabilityTest ();
+  ~DsrLinkStabilityTest ();
+  virtual void
+  DoRun (void);
+};
+DsrLinkStabilityTest::DsrLinkStabilityTest ()
+  : TestCase ("DSR link cache route choice on a link stability change")
+{
+}
+DsrLinkStabilityTest::~DsrLinkStabilityTest ()
+{
+}
+void
+DsrLinkStabilityTest::DoRun ()
+{
+  Ptr<dsr::RouteCache> rcache = CreateObject<dsr::RouteCache> ();
+  rcache->SetCacheType ("LinkCache");
+  rcache->SetInitStability (Seconds (25));
+  rcache->SetMinLifeTime (Seconds (1));
+  rcache->SetStabilityDecrFactor (2);
+  rcache->SetStabilityIncrFactor (4);
+  rcache->SetUseExtends (Seconds (50));
+
+  // two routes of the same length, a-b-d and a-c-d
+  Ipv4Address a ("10.1.1.1");
+  Ipv4Address b ("10.1.1.2");
+  Ipv4Address c ("10.1.1.3");
+  Ipv4Address d ("10.1.1.4");
+  std::vector<Ipv4Address> viaB;
+  viaB.push_back (a);
+  viaB.push_back (b);
+  viaB.push_back (d);
+  std::vector<Ipv4Address> viaC;
+  viaC.push_back (a);
+  viaC.push_back (c);
+  viaC.push_back (d);
+  NS_TEST_EXPECT_MSG_EQ (rcache->AddRoute_Link (viaB, a), true, "trivial");
+  NS_TEST_EXPECT_MSG_EQ (rcache->AddRoute_Link (viaC, a), true, "trivial");
+  dsr::RouteCacheEntry entry;
+  NS_TEST_EXPECT_MSG_EQ (rcache->LookupRoute (d, entry), true, "trivial");
+  NS_TEST_ASSERT_MSG_EQ (entry.GetVector ().size (), 3, "trivial");
+  // the links are equally stable, so either route may be chosen first
+  bool firstViaB = (entry.GetVector ()[1] == b);
+  std::vector<Ipv4Address> first = firstViaB ? viaB : viaC;
+  std::vector<Ipv4Address> other = firstViaB ? viaC : viaB;
+
+  // extending the links of the other route makes it the most stable one;
+  // it also makes the stability of its nodes grow to 100 s
+  rcache->UseExtends (other);
+  NS_TEST_EXPECT_MSG_EQ (rcache->LookupRoute (d, entry), true, "trivial");
+  NS_TEST_EXPECT_MSG_EQ (entry.GetVector ()[1], other[1], "Route not updated after UseExtends");
+
+  // make the stability of the middle node of the first route grow to
+  // 100 s too, without changing the links
+  rcache->SetUseExtends (Seconds (1));
+  std::vector<Ipv4Address> firstHop (first.begin (), first.begin () + 2);
+  rcache->UseExtends (firstHop);
+  NS_TEST_EXPECT_MSG_EQ (rcache->LookupRoute (d, entry), true, "trivial");
+  NS_TEST_EXPECT_MSG_EQ (entry.GetVector ()[1], other[1], "Link stabilities did not change");
+
+  // adding the first route again gives its links the 100 s stability of
+  // its nodes, more than the 50 s of the links of the other route
+  NS_TEST_EXPECT_MSG_EQ (rcache->AddRoute_Link (first, a), true, "trivial");
+  NS_TEST_EXPECT_MSG_EQ (rcache->LookupRoute (d, entry), true, "trivial");
+  NS_TEST_EXPECT_MSG_EQ (entry.GetVector ()[1], first[1], "Route not updated after a stability change in AddRoute_Link");
+}
+// -----------------------------------------------------------------------------
 // / Unit test for Send Buffer
 class DsrSendBuffTest : public TestCase
 {
@@ -516,6 +651,8 @@ public:
     AddTestCase (new DsrAckReqHeaderTest, TestCase::QUICK);
     AddTestCase (new DsrAckHeaderTest, TestCase::QUICK);
     AddTestCase (new DsrCacheEntryTest, TestCase::QUICK);
+    AddTestCase (new DsrLinkCacheTest, TestCase::QUICK);
+    AddTestCase (new DsrLinkStabilityTest, TestCase::QUICK);
     AddTestCase (new DsrSendBuffTest, TestCase::QUICK);
   }
 } g_dsrTestSuite;
@@ -36,6 +36,8 @@
 #include "ns3/trace-source-accessor.h"
 #include "ns3/uinteger.h"
 
+#include <algorithm>
+#include <cerrno>
 #include <unistd.h>
 #include <arpa/inet.h>
 #include <net/ethernet.h>
@@ -45,28 +47,185 @@ NS_LOG_COMPONENT_DEFINE ("FdNetDevice");
 namespace ns3 {
 
 FdNetDeviceFdReader::FdNetDeviceFdReader ()
-  : m_bufferSize (65536) // Defaults to maximum TCP window size
+  : m_bufferSize (65536), // Defaults to maximum TCP window size
+    m_batchSize (1),
+    m_poolSize (0),
+    m_useBatch (true),
+    m_batchNext (0)
 {
 }
 
+FdNetDeviceFdReader::~FdNetDeviceFdReader ()
+{
+  // stop the read thread before releasing the buffers it uses
+  Stop ();
+  for (uint32_t i = m_batchNext; i < m_batch.size (); ++i)
+    {
+      free (m_batch[i].m_buf);
+    }
+  for (std::vector<uint8_t *>::iterator i = m_slots.begin (); i != m_slots.end (); ++i)
+    {
+      free (*i);
+    }
+  for (std::vector<uint8_t *>::iterator i = m_pool.begin (); i != m_pool.end (); ++i)
+    {
+      free (*i);
+    }
+}
+
 void
 FdNetDeviceFdReader::SetBufferSize (uint32_t bufferSize)
 {
+  NS_ASSERT_MSG (m_pool.empty () && m_slots.empty (), "buffer size changed after buffers were allocated");
   m_bufferSize = bufferSize;
 }
 
-FdReader::Data FdNetDeviceFdReader::DoRead (void)
+void
+FdNetDeviceFdReader::SetBatchSize (uint32_t batchSize)
 {
-  NS_LOG_FUNCTION (this);
+  NS_ASSERT_MSG (m_slots.empty (), "batch size changed after the reader started");
+  m_batchSize = std::max<uint32_t> (batchSize, 1);
+}
+
+void
+FdNetDeviceFdReader::SetPoolSize (uint32_t poolSize)
+{
+  m_poolSize = poolSize;
+
+  // preallocate the buffers of a full batch
+  CriticalSection cs (m_poolMutex);
+  while (m_pool.size () < std::min (m_poolSize, m_batchSize))
+    {
+      uint8_t *buf = (uint8_t *)malloc (m_bufferSize);
+      NS_ABORT_MSG_IF (buf == 0, "malloc() failed");
+      m_pool.push_back (buf);
+    }
+}
 
+uint8_t *
+FdNetDeviceFdReader::AllocateBuffer (void)
+{
+  {
+    CriticalSection cs (m_poolMutex);
+    if (!m_pool.empty ())
+      {
+        uint8_t *buf = m_pool.back ();
+        m_pool.pop_back ();
+        return buf;
+      }
+  }
   uint8_t *buf = (uint8_t *)malloc (m_bufferSize);
   NS_ABORT_MSG_IF (buf == 0, "malloc() failed");
+  return buf;
+}
+
+void
+FdNetDeviceFdReader::ReleaseBuffer (uint8_t *buf)
+{
+  CriticalSection cs (m_poolMutex);
+  if (m_pool.size () < m_poolSize)
+    {
+      m_pool.push_back (buf);
+    }
+  else
+    {
+      free (buf);
+    }
+}
+
+ssize_t
+FdNetDeviceFdReader::ReadBatch (void)
+{
+  NS_LOG_FUNCTION (this);
+
+  if (m_slots.empty ())
+    {
+      m_slots.resize (m_batchSize, 0);
+      m_msgs.resize (m_batchSize);
+      m_iovs.resize (m_batchSize);
+    }
+
+  // buffers left over from the previous batch are reused as they are
+  for (uint32_t i = 0; i < m_batchSize; ++i)
+    {
+      if (m_slots[i] == 0)
+        {
+          m_slots[i] = AllocateBuffer ();
+        }
+      m_iovs[i].iov_base = m_slots[i];
+      m_iovs[i].iov_len = m_bufferSize;
+      memset (&m_msgs[i], 0, sizeof (struct mmsghdr));
+      m_msgs[i].msg_hdr.msg_iov = &m_iovs[i];
+      m_msgs[i].msg_hdr.msg_iovlen = 1;
+    }
+
+  NS_LOG_LOGIC ("Calling recvmmsg on fd " << m_fd);
+  int n = recvmmsg (m_fd, &m_msgs[0], m_batchSize, MSG_WAITFORONE, 0);
+  if (n < 0)
+    {
+      return -1;
+    }
+  if (n == 1 && m_msgs[0].msg_len == 0)
+    {
+      // like read(), an empty frame ends the reading
+      return 0;
+    }
+
+  m_batch.clear ();
+  m_batchNext = 0;
+  for (int i = 0; i < n; ++i)
+    {
+      if (m_msgs[i].msg_len > 0)
+        {
+          m_batch.push_back (FdReader::Data (m_slots[i], m_msgs[i].msg_len));
+          m_slots[i] = 0;
+        }
+    }
+  NS_LOG_LOGIC ("Read " << m_batch.size () << " frames");
+  return m_batch.size ();
+}
+
+FdReader::Data FdNetDeviceFdReader::DoRead (void)
+{
+  NS_LOG_FUNCTION (this);
+
+  if (m_batchNext < m_batch.size ())
+    {
+      return m_batch[m_batchNext++];
+    }
+
+  if (m_batchSize > 1 && m_useBatch)
+    {
+      ssize_t n = ReadBatch ();
+      if (n > 0)
+        {
+          return m_batch[m_batchNext++];
+        }
+      else if (n == 0)
+        {
+          return FdReader::Data (0, 0);
+        }
+      else if (errno == EINTR || errno == EAGAIN || errno == EWOULDBLOCK)
+        {
+          return FdReader::Data (0, -1);
+        }
+      else if (errno != ENOTSOCK && errno != ENOSYS && errno != EOPNOTSUPP)
+        {
+          return FdReader::Data (0, 0);
+        }
+      // tap devices and the like are not sockets, and some kernels or
+      // socket types lack recvmmsg, read them one frame at a time from now on
+      NS_LOG_LOGIC ("recvmmsg not supported on fd " << m_fd << ", falling back to read");
+      m_useBatch = false;
+    }
+
+  uint8_t *buf = AllocateBuffer ();
 
   NS_LOG_LOGIC ("Calling read on fd " << m_fd);
   ssize_t len = read (m_fd, buf, m_bufferSize);
   if (len <= 0)
     {
-      free (buf);
+      ReleaseBuffer (buf);
       buf = 0;
       len = 0;
     }
@@ -74,6 +233,12 @@ FdReader::Data FdNetDeviceFdReader::DoRead (void)
   return FdReader::Data (buf, len);
 }
 
+bool
+FdNetDeviceFdReader::HasPendingData (void) const
+{
+  return m_batchNext < m_batch.size ();
+}
+
 NS_OBJECT_ENSURE_REGISTERED (FdNetDevice);
 
 TypeId
@@ -111,6 +276,12 @@ FdNetDevice::GetTypeId (void)
                    UintegerValue (1000),
                    MakeUintegerAccessor (&FdNetDevice::m_maxPendingReads),
                    MakeUintegerChecker<uint32_t> ())
+    .AddAttribute ("RxBatchSize", "Maximum number of frames read with a single "
+                   "system call when the file descriptor is a socket.  All the frames "
+                   "read while the simulator is busy are forwarded up by a single event.",
+                   UintegerValue (32),
+                   MakeUintegerAccessor (&FdNetDevice::m_rxBatchSize),
+                   MakeUintegerChecker<uint32_t> (1))
     //
     // Trace sources at the "top" of the net device, where packets transition
     // to/from higher layers.  These points do not really correspond to the
@@ -156,6 +327,7 @@ FdNetDevice::FdNetDevice ()
     m_isBroadcast (true),
     m_isMulticast (false),
     m_pendingReadCount (0),
+    m_forwardUpScheduled (false),
     m_startEvent (),
     m_stopEvent ()
 {
@@ -177,6 +349,16 @@ FdNetDevice::DoDispose (void)
 {
   NS_LOG_FUNCTION (this);
   StopDevice ();
+
+  // frames still waiting for ForwardUpBatch
+  for (std::vector<std::pair<uint8_t *, ssize_t> >::iterator i = m_pendingReads.begin ();
+       i != m_pendingReads.end (); ++i)
+    {
+      free (i->first);
+    }
+  m_pendingReads.clear ();
+  m_pendingReadCount = 0;
+
   NetDevice::DoDispose ();
 }
 
@@ -231,6 +413,8 @@ FdNetDevice::StartDevice (void)
 
   m_fdReader = Create<FdNetDeviceFdReader> ();
   m_fdReader->SetBufferSize(m_mtu);
+  m_fdReader->SetBatchSize (m_rxBatchSize);
+  m_fdReader->SetPoolSize (m_maxPendingReads);
   m_fdReader->Start (m_fd, MakeCallback (&FdNetDevice::ReceiveCallback, this));
 
   NotifyLinkUp ();
@@ -259,6 +443,7 @@ FdNetDevice::ReceiveCallback (uint8_t *buf, ssize_t len)
 {
   NS_LOG_FUNCTION (this << buf << len);
   bool skip = false;
+  bool schedule = false;
 
   {
     CriticalSection cs (m_pendingReadMutex);
@@ -270,18 +455,43 @@ FdNetDevice::ReceiveCallback (uint8_t *buf, ssize_t len)
     else
       {
         ++m_pendingReadCount;
+        m_pendingReads.push_back (std::make_pair (buf, len));
+        // frames received before the scheduled event runs join its batch
+        schedule = !m_forwardUpScheduled;
+        m_forwardUpScheduled = true;
       }
   }
 
   if (skip)
     {
+      m_fdReader->ReleaseBuffer (buf);
       struct timespec time = { 0, 100000000L }; // 100 ms
       nanosleep (&time, NULL);
     }
-  else
+  else if (schedule)
+    {
+      Simulator::ScheduleWithContext (m_nodeId, Time (0), MakeEvent (&FdNetDevice::ForwardUpBatch, this));
+    }
+}
+
+void
+FdNetDevice::ForwardUpBatch (void)
+{
+  NS_LOG_FUNCTION (this);
+
+  std::vector<std::pair<uint8_t *, ssize_t> > batch;
+  {
+    CriticalSection cs (m_pendingReadMutex);
+    batch.swap (m_pendingReads);
+    m_pendingReadCount = 0;
+    m_forwardUpScheduled = false;
+  }
+
+  NS_LOG_LOGIC ("Forwarding " << batch.size () << " frames");
+  for (std::vector<std::pair<uint8_t *, ssize_t> >::iterator i = batch.begin (); i != batch.end (); ++i)
     {
-      Simulator::ScheduleWithContext (m_nodeId, Time (0), MakeEvent (&FdNetDevice::ForwardUp, this, buf, len));
-   }
+      ForwardUp (i->first, i->second);
+    }
 }
 
 /// \todo Consider having a instance member m_packetBuffer and using memmove
@@ -323,42 +533,31 @@ AddPIHeader (uint8_t *&buf, ssize_t &len)
   buf = buf2;
 }
 
-static void
-RemovePIHeader (uint8_t *&buf, ssize_t &len)
-{
-  // strip PI header if present, shrink buffer
-  if (len >= 4)
-    {
-      len -= 4;
-      memmove (buf, buf + 4, len);
-      buf = (uint8_t*)realloc (buf, len);
-    }
-}
-
 void
 FdNetDevice::ForwardUp (uint8_t *buf, ssize_t len)
 {
   NS_LOG_FUNCTION (this << buf << len);
 
-  if (m_pendingReadCount > 0)
-    {
-      {
-        CriticalSection cs (m_pendingReadMutex);
-        --m_pendingReadCount;
-      }
-    }
-
-  // We need to remove the PI header and ignore it
-  if (m_encapMode == DIXPI)
+  // We need to skip the PI header and ignore it
+  ssize_t offset = 0;
+  if (m_encapMode == DIXPI && len >= 4)
     {
-      RemovePIHeader (buf, len);
+      offset = 4;
     }
 
   //
-  // Create a packet out of the buffer we received and free that buffer.
+  // Create a packet out of the buffer we received and give that buffer
+  // back to the reader.
   //
-  Ptr<Packet> packet = Create<Packet> (reinterpret_cast<const uint8_t *> (buf), len);
-  free (buf);
+  Ptr<Packet> packet = Create<Packet> (reinterpret_cast<const uint8_t *> (buf + offset), len - offset);
+  if (m_fdReader != 0)
+    {
+      m_fdReader->ReleaseBuffer (buf);
+    }
+  else
+    {
+      free (buf);
+    }
   buf = 0;
 
   //
@@ -37,6 +37,10 @@
 #include "ns3/system-mutex.h"
 
 #include <string.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <vector>
+#include <utility>
 
 namespace ns3 {
 
@@ -47,6 +51,7 @@ public:
    * Constructor for the FdNetDevice.
    */
   FdNetDeviceFdReader ();
+  virtual ~FdNetDeviceFdReader ();
 
   /**
    * Set size of the read buffer.
@@ -54,10 +59,51 @@ public:
    */
   void SetBufferSize (uint32_t bufferSize);
 
+  /**
+   * Set the maximum number of frames read with a single system call.
+   *
+   * Frames are read in batches with recvmmsg() when the file descriptor
+   * is a socket, and one by one with read() otherwise.
+   */
+  void SetBatchSize (uint32_t batchSize);
+
+  /**
+   * Set the maximum number of free read buffers kept for reuse.
+   */
+  void SetPoolSize (uint32_t poolSize);
+
+  /**
+   * Give back a buffer returned by a previous read, so that it can be
+   * reused for the next frames.  It is safe to call this method from
+   * the simulator thread while the read thread is running.
+   */
+  void ReleaseBuffer (uint8_t *buf);
+
 private:
   FdReader::Data DoRead (void);
-  
+  bool HasPendingData (void) const;
+
+  uint8_t *AllocateBuffer (void);
+  ssize_t ReadBatch (void);
+
   uint32_t m_bufferSize;
+  uint32_t m_batchSize;
+  uint32_t m_poolSize;
+  /// false once recvmmsg() failed because the descriptor is not a socket
+  bool m_useBatch;
+
+  /// receive buffers for the next batch, kept across calls
+  std::vector<uint8_t *> m_slots;
+  std::vector<struct mmsghdr> m_msgs;
+  std::vector<struct iovec> m_iovs;
+
+  /// frames read by the last batch and not yet returned by DoRead()
+  std::vector<FdReader::Data> m_batch;
+  uint32_t m_batchNext;
+
+  /// free read buffers, shared with the simulator thread
+  std::vector<uint8_t *> m_pool;
+  SystemMutex m_poolMutex;
 };
 
 class Node;
@@ -209,6 +255,13 @@ private:
    */
   void ForwardUp (uint8_t *buf, ssize_t len);
 
+  /**
+   * \internal
+   *
+   * Forward all the frames received since the last batch was forwarded
+   */
+  void ForwardUpBatch (void);
+
   /**
    * Start Sending a Packet Down the Wire.
    * @param p packet to send
@@ -329,6 +382,29 @@ private:
    */
   SystemMutex m_pendingReadMutex;
 
+  /**
+   * \internal
+   *
+   * Frames received by the read thread and not yet forwarded up,
+   * protected by m_pendingReadMutex.
+   */
+  std::vector<std::pair<uint8_t *, ssize_t> > m_pendingReads;
+
+  /**
+   * \internal
+   *
+   * Whether a ForwardUpBatch event is scheduled, protected by
+   * m_pendingReadMutex.
+   */
+  bool m_forwardUpScheduled;
+
+  /**
+   * \internal
+   *
+   * Maximum number of frames read with a single system call.
+   */
+  uint32_t m_rxBatchSize;
+
   /**
    * \internal
    *
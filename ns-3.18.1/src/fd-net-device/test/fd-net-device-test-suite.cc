@@ -0,0 +1,191 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <string>
+#include <vector>
+#include <unistd.h>
+#include <sys/socket.h>
+#include "ns3/simulator.h"
+#include "ns3/log.h"
+#include "ns3/abort.h"
+#include "ns3/test.h"
+#include "ns3/system-mutex.h"
+#include "ns3/fd-net-device.h"
+
+NS_LOG_COMPONENT_DEFINE ("FdNetDeviceTest");
+
+namespace ns3 {
+
+/**
+ * Checks that the frames read with recvmmsg() in batches of RxBatchSize
+ * frames are the frames, in the same order, that are read one by one
+ * with read().  Over a pipe, recvmmsg() fails and the reader must fall
+ * back to read().
+ */
+class FdNetDeviceFdReaderTestCase : public TestCase
+{
+public:
+  /**
+   * \param name the name of the test case
+   * \param socket if true, the frames are read from a datagram socket,
+   * otherwise from a pipe
+   */
+  FdNetDeviceFdReaderTestCase (std::string name, bool socket);
+  virtual ~FdNetDeviceFdReaderTestCase ();
+
+private:
+  virtual void DoRun (void);
+  std::vector<std::string> ReadFrames (uint32_t batchSize);
+  void Receive (uint8_t *buf, ssize_t len);
+  uint32_t GetReceivedCount (void);
+  bool WaitForFrames (uint32_t count);
+
+  bool m_socket;
+  std::vector<std::string> m_frames;
+  Ptr<FdNetDeviceFdReader> m_reader;
+  SystemMutex m_mutex;
+  std::vector<std::string> m_received;
+};
+
+FdNetDeviceFdReaderTestCase::FdNetDeviceFdReaderTestCase (std::string name, bool socket)
+  : TestCase (name),
+    m_socket (socket)
+{
+}
+
+FdNetDeviceFdReaderTestCase::~FdNetDeviceFdReaderTestCase ()
+{
+}
+
+void
+FdNetDeviceFdReaderTestCase::Receive (uint8_t *buf, ssize_t len)
+{
+  // called by the read thread
+  CriticalSection cs (m_mutex);
+  m_received.push_back (std::string (reinterpret_cast<char *> (buf), len));
+  m_reader->ReleaseBuffer (buf);
+}
+
+uint32_t
+FdNetDeviceFdReaderTestCase::GetReceivedCount (void)
+{
+  CriticalSection cs (m_mutex);
+  return m_received.size ();
+}
+
+bool
+FdNetDeviceFdReaderTestCase::WaitForFrames (uint32_t count)
+{
+  for (uint32_t i = 0; i < 5000; ++i)
+    {
+      if (GetReceivedCount () >= count)
+        {
+          return true;
+        }
+      usleep (1000);
+    }
+  return false;
+}
+
+std::vector<std::string>
+FdNetDeviceFdReaderTestCase::ReadFrames (uint32_t batchSize)
+{
+  int fds[2];
+  int status = m_socket ? socketpair (AF_UNIX, SOCK_DGRAM, 0, fds) : pipe (fds);
+  NS_ABORT_MSG_IF (status == -1, "Could not create the file descriptors");
+
+  m_received.clear ();
+  m_reader = Create<FdNetDeviceFdReader> ();
+  m_reader->SetBufferSize (1500);
+  m_reader->SetBatchSize (batchSize);
+  m_reader->SetPoolSize (2 * batchSize);
+
+  if (m_socket)
+    {
+      // queue all the frames, so that recvmmsg() returns full batches
+      for (uint32_t i = 0; i < m_frames.size (); ++i)
+        {
+          NS_ABORT_IF (write (fds[1], m_frames[i].data (), m_frames[i].size ()) == -1);
+        }
+      m_reader->Start (fds[0], MakeCallback (&FdNetDeviceFdReaderTestCase::Receive, this));
+      WaitForFrames (m_frames.size ());
+    }
+  else
+    {
+      // a pipe does not keep the frame boundaries, write the next frame
+      // only once the previous one was read
+      m_reader->Start (fds[0], MakeCallback (&FdNetDeviceFdReaderTestCase::Receive, this));
+      for (uint32_t i = 0; i < m_frames.size (); ++i)
+        {
+          NS_ABORT_IF (write (fds[1], m_frames[i].data (), m_frames[i].size ()) == -1);
+          if (!WaitForFrames (i + 1))
+            {
+              break;
+            }
+        }
+    }
+
+  m_reader->Stop ();
+  Simulator::Destroy ();
+  m_reader = 0;
+  close (fds[0]);
+  close (fds[1]);
+  return m_received;
+}
+
+void
+FdNetDeviceFdReaderTestCase::DoRun (void)
+{
+  m_frames.clear ();
+  for (uint32_t i = 0; i < 50; ++i)
+    {
+      // frames of different lengths and contents
+      std::string frame (60 + (i * 37) % 1400, 'a' + i % 26);
+      frame[0] = i;
+      m_frames.push_back (frame);
+    }
+
+  std::vector<std::string> single = ReadFrames (1);
+  std::vector<std::string> batched = ReadFrames (8);
+
+  NS_TEST_ASSERT_MSG_EQ (single.size (), m_frames.size (), "Wrong number of frames read one by one");
+  NS_TEST_ASSERT_MSG_EQ (batched.size (), m_frames.size (), "Wrong number of frames read in batches");
+  for (uint32_t i = 0; i < m_frames.size (); ++i)
+    {
+      NS_TEST_EXPECT_MSG_EQ ((single[i] == m_frames[i]), true, "Wrong frame " << i << " read one by one");
+      NS_TEST_EXPECT_MSG_EQ ((batched[i] == single[i]), true, "Wrong frame " << i << " read in batches");
+    }
+}
+
+
+static class FdNetDeviceTestSuite : public TestSuite
+{
+public:
+  FdNetDeviceTestSuite ();
+} g_fdNetDeviceTestSuite;
+
+FdNetDeviceTestSuite::FdNetDeviceTestSuite ()
+  : TestSuite ("fd-net-device", UNIT)
+{
+  AddTestCase (new FdNetDeviceFdReaderTestCase ("Frames read from a socket in batches and one by one",
+                                                true),
+               TestCase::QUICK);
+  AddTestCase (new FdNetDeviceFdReaderTestCase ("Frames read from a pipe in batches and one by one",
+                                                false),
+               TestCase::QUICK);
+}
+
+} // namespace ns3
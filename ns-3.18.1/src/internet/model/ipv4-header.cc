@@ -41,6 +41,7 @@ Ipv4Header::Ipv4Header ()
     m_fragmentOffset (0),
     m_checksum (0),
     m_goodChecksum (true),
+    m_checksumValid (false),
     m_headerSize(5*4)
 {
 }
@@ -56,6 +57,7 @@ void
 Ipv4Header::SetPayloadSize (uint16_t size)
 {
   NS_LOG_FUNCTION (this << size);
+  m_checksumValid = false;
   m_payloadSize = size;
 }
 uint16_t
@@ -75,6 +77,7 @@ void
 Ipv4Header::SetIdentification (uint16_t identification)
 {
   NS_LOG_FUNCTION (this << identification);
+  m_checksumValid = false;
   m_identification = identification;
 }
 
@@ -82,6 +85,7 @@ void
 Ipv4Header::SetTos (uint8_t tos)
 {
   NS_LOG_FUNCTION (this << static_cast<uint32_t> (tos));
+  m_checksumValid = false;
   m_tos = tos;
 }
 
@@ -89,6 +93,7 @@ void
 Ipv4Header::SetDscp (DscpType dscp)
 {
   NS_LOG_FUNCTION (this << dscp);
+  m_checksumValid = false;
   m_tos &= 0x3; // Clear out the DSCP part, retain 2 bits of ECN
   m_tos |= dscp;
 }
@@ -97,6 +102,7 @@ void
 Ipv4Header::SetEcn (EcnType ecn)
 {
   NS_LOG_FUNCTION (this << ecn);
+  m_checksumValid = false;
   m_tos &= 0xFC; // Clear out the ECN part, retain 6 bits of DSCP
   m_tos |= ecn;
 }
@@ -200,12 +206,14 @@ void
 Ipv4Header::SetMoreFragments (void)
 {
   NS_LOG_FUNCTION (this);
+  m_checksumValid = false;
   m_flags |= MORE_FRAGMENTS;
 }
 void
 Ipv4Header::SetLastFragment (void)
 {
   NS_LOG_FUNCTION (this);
+  m_checksumValid = false;
   m_flags &= ~MORE_FRAGMENTS;
 }
 bool 
@@ -219,12 +227,14 @@ void
 Ipv4Header::SetDontFragment (void)
 {
   NS_LOG_FUNCTION (this);
+  m_checksumValid = false;
   m_flags |= DONT_FRAGMENT;
 }
 void 
 Ipv4Header::SetMayFragment (void)
 {
   NS_LOG_FUNCTION (this);
+  m_checksumValid = false;
   m_flags &= ~DONT_FRAGMENT;
 }
 bool 
@@ -238,6 +248,7 @@ void
 Ipv4Header::SetFragmentOffset (uint16_t offsetBytes)
 {
   NS_LOG_FUNCTION (this << offsetBytes);
+  m_checksumValid = false;
   // check if the user is trying to set an invalid offset
   NS_ABORT_MSG_IF ((offsetBytes & 0x7), "offsetBytes must be multiple of 8 bytes");
   m_fragmentOffset = offsetBytes;
@@ -258,6 +269,22 @@ void
 Ipv4Header::SetTtl (uint8_t ttl)
 {
   NS_LOG_FUNCTION (this << static_cast<uint32_t> (ttl));
+  if (m_checksumValid)
+    {
+      // Update the checksum of the word holding the ttl and the protocol
+      // incrementally, as routers do when decrementing the ttl (RFC 1624,
+      // eqn. 3). Words are in the byte order of Buffer::Iterator::ReadU16.
+      uint16_t oldWord = m_ttl | (m_protocol << 8);
+      uint16_t newWord = ttl | (m_protocol << 8);
+      uint32_t sum = static_cast<uint16_t> (~m_checksum);
+      sum += static_cast<uint16_t> (~oldWord);
+      sum += newWord;
+      while (sum >> 16)
+        {
+          sum = (sum & 0xffff) + (sum >> 16);
+        }
+      m_checksum = ~sum;
+    }
   m_ttl = ttl;
 }
 uint8_t 
@@ -277,6 +304,7 @@ void
 Ipv4Header::SetProtocol (uint8_t protocol)
 {
   NS_LOG_FUNCTION (this << static_cast<uint32_t> (protocol));
+  m_checksumValid = false;
   m_protocol = protocol;
 }
 
@@ -284,6 +312,7 @@ void
 Ipv4Header::SetSource (Ipv4Address source)
 {
   NS_LOG_FUNCTION (this << source);
+  m_checksumValid = false;
   m_source = source;
 }
 Ipv4Address
@@ -297,6 +326,7 @@ void
 Ipv4Header::SetDestination (Ipv4Address dst)
 {
   NS_LOG_FUNCTION (this << dst);
+  m_checksumValid = false;
   m_destination = dst;
 }
 Ipv4Address
@@ -409,8 +439,16 @@ Ipv4Header::Serialize (Buffer::Iterator start) const
 
   if (m_calcChecksum) 
     {
-      i = start;
-      uint16_t checksum = i.CalculateIpChecksum (20);
+      uint16_t checksum;
+      if (m_checksumValid)
+        {
+          checksum = m_checksum;
+        }
+      else
+        {
+          i = start;
+          checksum = i.CalculateIpChecksum (20);
+        }
       NS_LOG_LOGIC ("checksum=" <<checksum);
       i = start;
       i.Next (10);
@@ -460,6 +498,12 @@ Ipv4Header::Deserialize (Buffer::Iterator start)
       NS_LOG_LOGIC ("checksum=" <<checksum);
 
       m_goodChecksum = (checksum == 0);
+      // without options, the received checksum can be written back as is
+      m_checksumValid = m_goodChecksum && headerSize == 5*4;
+    }
+  else
+    {
+      m_checksumValid = false;
     }
   return GetSerializedSize ();
 }
@@ -141,6 +141,10 @@ public:
   void SetFragmentOffset (uint16_t offsetBytes);
   /**
    * \param ttl the ipv4 TTL
+   *
+   * If the header was deserialized with a correct checksum and no other
+   * field was changed since, the checksum is updated incrementally
+   * instead of being computed again on serialization.
    */
   void SetTtl (uint8_t ttl);
   /**
@@ -246,6 +250,7 @@ private:
   Ipv4Address m_destination;
   uint16_t m_checksum;
   bool m_goodChecksum;
+  bool m_checksumValid; // m_checksum matches the header fields, see SetTtl
   uint16_t m_headerSize;
 };
 
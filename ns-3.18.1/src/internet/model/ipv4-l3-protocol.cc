@@ -470,7 +470,7 @@ Ipv4L3Protocol::Receive ( Ptr<NetDevice> device, Ptr<const Packet> p, uint16_t p
         {
           if (ipv4Interface->IsUp ())
             {
-              m_rxTrace (packet, m_node->GetObject<Ipv4> (), interface);
+              m_rxTrace (packet, this, interface);
               break;
             }
           else
@@ -478,7 +478,7 @@ Ipv4L3Protocol::Receive ( Ptr<NetDevice> device, Ptr<const Packet> p, uint16_t p
               NS_LOG_LOGIC ("Dropping received packet -- interface is down");
               Ipv4Header ipHeader;
               packet->RemoveHeader (ipHeader);
-              m_dropTrace (ipHeader, packet, DROP_INTERFACE_DOWN, m_node->GetObject<Ipv4> (), interface);
+              m_dropTrace (ipHeader, packet, DROP_INTERFACE_DOWN, this, interface);
               return;
             }
         }
@@ -500,7 +500,7 @@ Ipv4L3Protocol::Receive ( Ptr<NetDevice> device, Ptr<const Packet> p, uint16_t p
   if (!ipHeader.IsChecksumOk ()) 
     {
       NS_LOG_LOGIC ("Dropping received packet -- checksum not ok");
-      m_dropTrace (ipHeader, packet, DROP_BAD_CHECKSUM, m_node->GetObject<Ipv4> (), interface);
+      m_dropTrace (ipHeader, packet, DROP_BAD_CHECKSUM, this, interface);
       return;
     }
 
@@ -520,7 +520,7 @@ Ipv4L3Protocol::Receive ( Ptr<NetDevice> device, Ptr<const Packet> p, uint16_t p
                                       ))
     {
       NS_LOG_WARN ("No route found for forwarding packet.  Drop.");
-      m_dropTrace (ipHeader, packet, DROP_NO_ROUTE, m_node->GetObject<Ipv4> (), interface);
+      m_dropTrace (ipHeader, packet, DROP_NO_ROUTE, this, interface);
     }
 }
 
@@ -609,7 +609,7 @@ Ipv4L3Protocol::Send (Ptr<Packet> packet,
 
           m_sendOutgoingTrace (ipHeader, packetCopy, ifaceIndex);
           packetCopy->AddHeader (ipHeader);
-          m_txTrace (packetCopy, m_node->GetObject<Ipv4> (), ifaceIndex);
+          m_txTrace (packetCopy, this, ifaceIndex);
           outInterface->Send (packetCopy, destination);
         }
       return;
@@ -633,7 +633,7 @@ Ipv4L3Protocol::Send (Ptr<Packet> packet,
               Ptr<Packet> packetCopy = packet->Copy ();
               m_sendOutgoingTrace (ipHeader, packetCopy, ifaceIndex);
               packetCopy->AddHeader (ipHeader);
-              m_txTrace (packetCopy, m_node->GetObject<Ipv4> (), ifaceIndex);
+              m_txTrace (packetCopy, this, ifaceIndex);
               outInterface->Send (packetCopy, destination);
               return;
             }
@@ -683,7 +683,7 @@ Ipv4L3Protocol::Send (Ptr<Packet> packet,
   else
     {
       NS_LOG_WARN ("No route to host.  Drop.");
-      m_dropTrace (ipHeader, packet, DROP_NO_ROUTE, m_node->GetObject<Ipv4> (), 0);
+      m_dropTrace (ipHeader, packet, DROP_NO_ROUTE, this, 0);
     }
 }
 
@@ -737,7 +737,7 @@ Ipv4L3Protocol::SendRealOut (Ptr<Ipv4Route> route,
   if (route == 0)
     {
       NS_LOG_WARN ("No route to host.  Drop.");
-      m_dropTrace (ipHeader, packet, DROP_NO_ROUTE, m_node->GetObject<Ipv4> (), 0);
+      m_dropTrace (ipHeader, packet, DROP_NO_ROUTE, this, 0);
       return;
     }
   packet->AddHeader (ipHeader);
@@ -758,13 +758,13 @@ Ipv4L3Protocol::SendRealOut (Ptr<Ipv4Route> route,
               DoFragmentation (packet, outInterface->GetDevice ()->GetMtu (), listFragments);
               for ( std::list<Ptr<Packet> >::iterator it = listFragments.begin (); it != listFragments.end (); it++ )
                 {
-                  m_txTrace (*it, m_node->GetObject<Ipv4> (), interface);
+                  m_txTrace (*it, this, interface);
                   outInterface->Send (*it, route->GetGateway ());
                 }
             }
           else
             {
-              m_txTrace (packet, m_node->GetObject<Ipv4> (), interface);
+              m_txTrace (packet, this, interface);
               outInterface->Send (packet, route->GetGateway ());
             }
         }
@@ -773,7 +773,7 @@ Ipv4L3Protocol::SendRealOut (Ptr<Ipv4Route> route,
           NS_LOG_LOGIC ("Dropping -- outgoing interface is down: " << route->GetGateway ());
           Ipv4Header ipHeader;
           packet->RemoveHeader (ipHeader);
-          m_dropTrace (ipHeader, packet, DROP_INTERFACE_DOWN, m_node->GetObject<Ipv4> (), interface);
+          m_dropTrace (ipHeader, packet, DROP_INTERFACE_DOWN, this, interface);
         }
     } 
   else 
@@ -788,13 +788,13 @@ Ipv4L3Protocol::SendRealOut (Ptr<Ipv4Route> route,
               for ( std::list<Ptr<Packet> >::iterator it = listFragments.begin (); it != listFragments.end (); it++ )
                 {
                   NS_LOG_LOGIC ("Sending fragment " << **it );
-                  m_txTrace (*it, m_node->GetObject<Ipv4> (), interface);
+                  m_txTrace (*it, this, interface);
                   outInterface->Send (*it, ipHeader.GetDestination ());
                 }
             }
           else
             {
-              m_txTrace (packet, m_node->GetObject<Ipv4> (), interface);
+              m_txTrace (packet, this, interface);
               outInterface->Send (packet, ipHeader.GetDestination ());
             }
         }
@@ -803,7 +803,7 @@ Ipv4L3Protocol::SendRealOut (Ptr<Ipv4Route> route,
           NS_LOG_LOGIC ("Dropping -- outgoing interface is down: " << ipHeader.GetDestination ());
           Ipv4Header ipHeader;
           packet->RemoveHeader (ipHeader);
-          m_dropTrace (ipHeader, packet, DROP_INTERFACE_DOWN, m_node->GetObject<Ipv4> (), interface);
+          m_dropTrace (ipHeader, packet, DROP_INTERFACE_DOWN, this, interface);
         }
     }
 }
@@ -829,7 +829,7 @@ Ipv4L3Protocol::IpMulticastForward (Ptr<Ipv4MulticastRoute> mrtentry, Ptr<const
       if (h.GetTtl () == 0)
         {
           NS_LOG_WARN ("TTL exceeded.  Drop.");
-          m_dropTrace (header, packet, DROP_TTL_EXPIRED, m_node->GetObject<Ipv4> (), interfaceId);
+          m_dropTrace (header, packet, DROP_TTL_EXPIRED, this, interfaceId);
           return;
         }
       NS_LOG_LOGIC ("Forward multicast via interface " << interfaceId);
@@ -865,7 +865,7 @@ Ipv4L3Protocol::IpForward (Ptr<Ipv4Route> rtentry, Ptr<const Packet> p, const Ip
           icmp->SendTimeExceededTtl (ipHeader, packet);
         }
       NS_LOG_WARN ("TTL exceeded.  Drop.");
-      m_dropTrace (header, packet, DROP_TTL_EXPIRED, m_node->GetObject<Ipv4> (), interface);
+      m_dropTrace (header, packet, DROP_TTL_EXPIRED, this, interface);
       return;
     }
   m_unicastForwardTrace (ipHeader, packet, interface);
@@ -1174,7 +1174,7 @@ Ipv4L3Protocol::RouteInputError (Ptr<const Packet> p, const Ipv4Header & ipHeade
 {
   NS_LOG_FUNCTION (this << p << ipHeader << sockErrno);
   NS_LOG_LOGIC ("Route input failure-- dropping packet to " << ipHeader << " with errno " << sockErrno); 
-  m_dropTrace (ipHeader, p, DROP_ROUTE_ERROR, m_node->GetObject<Ipv4> (), 0);
+  m_dropTrace (ipHeader, p, DROP_ROUTE_ERROR, this, 0);
 }
 
 void
@@ -1471,7 +1471,7 @@ Ipv4L3Protocol::HandleFragmentsTimeout (std::pair<uint64_t, uint32_t> key, Ipv4H
       Ptr<Icmpv4L4Protocol> icmp = GetIcmp ();
       icmp->SendTimeExceededTtl (ipHeader, packet);
     }
-  m_dropTrace (ipHeader, packet, DROP_FRAGMENT_TIMEOUT, m_node->GetObject<Ipv4> (), iif);
+  m_dropTrace (ipHeader, packet, DROP_FRAGMENT_TIMEOUT, this, iif);
 
   // clear the buffers
   it->second = 0;
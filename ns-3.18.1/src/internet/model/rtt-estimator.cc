@@ -193,6 +193,21 @@ Time RttEstimator::AckSeq (SequenceNumber32 ackSeq)
   return m;
 }
 
+Time RttEstimator::AckSeq (SequenceNumber32 ackSeq, Time rtt)
+{
+  NS_LOG_FUNCTION (this << ackSeq << rtt);
+  Measurement (rtt);
+  ResetMultiplier ();
+  // Drop the history this ack covers, it is not needed for this sample
+  while(m_history.size () > 0)
+    {
+      RttHistory& h = m_history.front ();
+      if ((h.seq + SequenceNumber32 (h.count)) > ackSeq) break;
+      m_history.pop_front ();
+    }
+  return rtt;
+}
+
 void RttEstimator::ClearSent ()
 { 
   NS_LOG_FUNCTION (this);
@@ -80,6 +80,20 @@ public:
    */
   virtual Time AckSeq (SequenceNumber32 ackSeq);
 
+  /**
+   * \brief Note that a particular ack sequence has been received, with
+   * an RTT measured from the timestamps option (RTTM, RFC 7323)
+   *
+   * Unlike AckSeq (SequenceNumber32), the measurement is taken even when
+   * the acknowledged data was retransmitted, since the echoed timestamp
+   * tells which transmission is acknowledged.
+   *
+   * \param ackSeq the ack sequence number.
+   * \param rtt the RTT measured from the echoed timestamp.
+   * \return The measured RTT for this ack.
+   */
+  virtual Time AckSeq (SequenceNumber32 ackSeq, Time rtt);
+
   /**
    * \brief Clear all history entries
    */
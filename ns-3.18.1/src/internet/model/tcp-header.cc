@@ -21,6 +21,7 @@
 #include <stdint.h>
 #include <iostream>
 #include "tcp-header.h"
+#include "ns3/assert.h"
 #include "ns3/buffer.h"
 #include "ns3/address-utils.h"
 
@@ -37,6 +38,10 @@ TcpHeader::TcpHeader ()
     m_flags (0),
     m_windowSize (0xffff),
     m_urgentPointer (0),
+    m_options (0),
+    m_windowScale (0),
+    m_timestamp (0),
+    m_timestampEcho (0),
     m_calcChecksum (false),
     m_goodChecksum (true)
 {
@@ -118,6 +123,61 @@ uint16_t TcpHeader::GetUrgentPointer () const
   return m_urgentPointer;
 }
 
+void TcpHeader::SetWindowScale (uint8_t shift)
+{
+  m_windowScale = shift;
+  m_options |= HAS_WINSCALE;
+  UpdateLength ();
+}
+bool TcpHeader::HasWindowScale () const
+{
+  return (m_options & HAS_WINSCALE) != 0;
+}
+uint8_t TcpHeader::GetWindowScale () const
+{
+  return m_windowScale;
+}
+void TcpHeader::SetTimestamp (uint32_t value, uint32_t echo)
+{
+  m_timestamp = value;
+  m_timestampEcho = echo;
+  m_options |= HAS_TIMESTAMP;
+  UpdateLength ();
+}
+bool TcpHeader::HasTimestamp () const
+{
+  return (m_options & HAS_TIMESTAMP) != 0;
+}
+uint32_t TcpHeader::GetTimestamp () const
+{
+  return m_timestamp;
+}
+uint32_t TcpHeader::GetTimestampEcho () const
+{
+  return m_timestampEcho;
+}
+void TcpHeader::ClearOptions (void)
+{
+  m_options = 0;
+  UpdateLength ();
+}
+
+void
+TcpHeader::UpdateLength (void)
+{
+  // Both options are laid out on 32-bit boundaries, as RFC 7323
+  // Appendix A suggests: NOP, WS (4 bytes) and NOP, NOP, TS (12 bytes)
+  m_length = 5;
+  if (HasWindowScale ())
+    {
+      m_length += 1;
+    }
+  if (HasTimestamp ())
+    {
+      m_length += 3;
+    }
+}
+
 void 
 TcpHeader::InitializeChecksum (Ipv4Address source, 
                                Ipv4Address destination,
@@ -159,36 +219,41 @@ TcpHeader::CalculateHeaderChecksum (uint16_t size) const
   /* Zero                   3 bytes                                        */
   /* Next header            1 byte                                         */
 
-  uint32_t maxHdrSz = (2 * Address::MAX_SIZE) + 8;
-  Buffer buf = Buffer (maxHdrSz);
-  buf.AddAtStart (maxHdrSz);
-  Buffer::Iterator it = buf.Begin ();
-  uint32_t hdrSize = 0;
-
-  WriteTo (it, m_source);
-  WriteTo (it, m_destination);
+  // The pseudo header is summed in place rather than serialized in a
+  // Buffer, in the byte order CalculateIpChecksum reads it.
+  uint8_t buf[(2 * Address::MAX_SIZE) + 8];
+  uint32_t hdrSize = m_source.CopyTo (buf);
+  hdrSize += m_destination.CopyTo (buf + hdrSize);
   if (Ipv4Address::IsMatchingType(m_source))
     {
-      it.WriteU8 (0); /* protocol */
-      it.WriteU8 (m_protocol); /* protocol */
-      it.WriteU8 (size >> 8); /* length */
-      it.WriteU8 (size & 0xff); /* length */
-      hdrSize = 12;
+      buf[hdrSize++] = 0;
+      buf[hdrSize++] = m_protocol; /* protocol */
+      buf[hdrSize++] = size >> 8; /* length */
+      buf[hdrSize++] = size & 0xff; /* length */
     }
   else
     {
-      it.WriteU16 (0);
-      it.WriteU8 (size >> 8); /* length */
-      it.WriteU8 (size & 0xff); /* length */
-      it.WriteU16 (0);
-      it.WriteU8 (0);
-      it.WriteU8 (m_protocol); /* protocol */
-      hdrSize = 40;
+      buf[hdrSize++] = 0;
+      buf[hdrSize++] = 0;
+      buf[hdrSize++] = size >> 8; /* length */
+      buf[hdrSize++] = size & 0xff; /* length */
+      buf[hdrSize++] = 0;
+      buf[hdrSize++] = 0;
+      buf[hdrSize++] = 0;
+      buf[hdrSize++] = m_protocol; /* protocol */
     }
 
-  it = buf.Begin ();
+  uint32_t sum = 0;
+  for (uint32_t i = 0; i + 1 < hdrSize; i += 2)
+    {
+      sum += buf[i] | (buf[i + 1] << 8);
+    }
+  while (sum >> 16)
+    {
+      sum = (sum & 0xffff) + (sum >> 16);
+    }
   /* we don't CompleteChecksum ( ~ ) now */
-  return ~(it.CalculateIpChecksum (hdrSize));
+  return sum;
 }
 
 bool
@@ -252,6 +317,14 @@ void TcpHeader::Print (std::ostream &os)  const
       os<<"]";
     }
   os<<" Seq="<<m_sequenceNumber<<" Ack="<<m_ackNumber<<" Win="<<m_windowSize;
+  if (HasWindowScale ())
+    {
+      os<<" WS="<<(uint32_t)m_windowScale;
+    }
+  if (HasTimestamp ())
+    {
+      os<<" TSval="<<m_timestamp<<" TSecr="<<m_timestampEcho;
+    }
 }
 uint32_t TcpHeader::GetSerializedSize (void)  const
 {
@@ -269,6 +342,31 @@ void TcpHeader::Serialize (Buffer::Iterator start)  const
   i.WriteHtonU16 (0);
   i.WriteHtonU16 (m_urgentPointer);
 
+  uint32_t optionSize = 0;
+  if (HasWindowScale ())
+    {
+      i.WriteU8 (OPTION_NOP);
+      i.WriteU8 (OPTION_WINSCALE);
+      i.WriteU8 (3);
+      i.WriteU8 (m_windowScale);
+      optionSize += 4;
+    }
+  if (HasTimestamp ())
+    {
+      i.WriteU8 (OPTION_NOP);
+      i.WriteU8 (OPTION_NOP);
+      i.WriteU8 (OPTION_TIMESTAMP);
+      i.WriteU8 (10);
+      i.WriteHtonU32 (m_timestamp);
+      i.WriteHtonU32 (m_timestampEcho);
+      optionSize += 12;
+    }
+  NS_ASSERT_MSG (20 + optionSize <= GetSerializedSize (), "TCP options do not fit in the header length");
+  if (20 + optionSize < GetSerializedSize ())
+    { // pad up to the header length with end of option list
+      i.WriteU8 (OPTION_END, GetSerializedSize () - 20 - optionSize);
+    }
+
   if(m_calcChecksum)
     {
       uint16_t headerChecksum = CalculateHeaderChecksum (start.GetSize ());
@@ -294,6 +392,48 @@ uint32_t TcpHeader::Deserialize (Buffer::Iterator start)
   i.Next (2);
   m_urgentPointer = i.ReadNtohU16 ();
 
+  m_options = 0;
+  uint32_t optionSize = m_length > 5 ? 4 * (m_length - 5) : 0;
+  while (optionSize > 0)
+    {
+      uint8_t kind = i.ReadU8 ();
+      optionSize--;
+      if (kind == OPTION_END)
+        {
+          break;
+        }
+      if (kind == OPTION_NOP)
+        {
+          continue;
+        }
+      if (optionSize == 0)
+        {
+          break;
+        }
+      uint8_t size = i.ReadU8 ();
+      optionSize--;
+      if (size < 2 || size - 2u > optionSize)
+        { // malformed option, ignore the rest of the list
+          break;
+        }
+      if (kind == OPTION_WINSCALE && size == 3)
+        {
+          m_windowScale = i.ReadU8 ();
+          m_options |= HAS_WINSCALE;
+        }
+      else if (kind == OPTION_TIMESTAMP && size == 10)
+        {
+          m_timestamp = i.ReadNtohU32 ();
+          m_timestampEcho = i.ReadNtohU32 ();
+          m_options |= HAS_TIMESTAMP;
+        }
+      else
+        {
+          i.Next (size - 2);
+        }
+      optionSize -= size - 2;
+    }
+
   if(m_calcChecksum)
     {
       uint16_t headerChecksum = CalculateHeaderChecksum (start.GetSize ());
@@ -38,6 +38,10 @@ namespace ns3 {
  * This class has fields corresponding to those in a network TCP header
  * (port numbers, sequence and acknowledgement numbers, flags, etc) as well
  * as methods for serialization to and deserialization from a byte buffer.
+ *
+ * The window scale and timestamps options of RFC 7323 are supported.
+ * Setting an option updates the header length; other options found when
+ * deserializing are skipped.
  */
 
 class TcpHeader : public Header 
@@ -121,6 +125,43 @@ public:
    */
   uint16_t GetUrgentPointer () const;
 
+//Options
+  /**
+   * \brief Add the window scale option (RFC 7323) to this TcpHeader
+   * \param shift the shift count advertised by the option
+   */
+  void SetWindowScale (uint8_t shift);
+  /**
+   * \return true if this TcpHeader carries the window scale option
+   */
+  bool HasWindowScale () const;
+  /**
+   * \return the shift count of the window scale option
+   */
+  uint8_t GetWindowScale () const;
+  /**
+   * \brief Add the timestamps option (RFC 7323) to this TcpHeader
+   * \param value the timestamp value (TSval)
+   * \param echo the timestamp echo reply (TSecr)
+   */
+  void SetTimestamp (uint32_t value, uint32_t echo);
+  /**
+   * \return true if this TcpHeader carries the timestamps option
+   */
+  bool HasTimestamp () const;
+  /**
+   * \return the timestamp value (TSval) of the timestamps option
+   */
+  uint32_t GetTimestamp () const;
+  /**
+   * \return the timestamp echo reply (TSecr) of the timestamps option
+   */
+  uint32_t GetTimestampEcho () const;
+  /**
+   * \brief Remove all the options from this TcpHeader
+   */
+  void ClearOptions (void);
+
   /**
    * \param source the ip source to use in the underlying
    *        ip packet.
@@ -160,6 +201,21 @@ public:
 
 private:
   uint16_t CalculateHeaderChecksum (uint16_t size) const;
+  void UpdateLength (void);
+
+  enum
+  {
+    OPTION_END = 0,        // End of option list
+    OPTION_NOP = 1,        // No operation
+    OPTION_WINSCALE = 3,   // Window scale, RFC 7323
+    OPTION_TIMESTAMP = 8   // Timestamps, RFC 7323
+  };
+  enum
+  {
+    HAS_WINSCALE = 1,
+    HAS_TIMESTAMP = 2
+  };
+
   uint16_t m_sourcePort;
   uint16_t m_destinationPort;
   SequenceNumber32 m_sequenceNumber;
@@ -169,6 +225,14 @@ private:
   uint16_t m_windowSize;
   uint16_t m_urgentPointer;
 
+  // The options are kept in plain fields rather than in a list of
+  // option objects, so that copying and serializing a header allocates
+  // nothing.
+  uint8_t m_options;    // bitmask of the options present
+  uint8_t m_windowScale;
+  uint32_t m_timestamp;
+  uint32_t m_timestampEcho;
+
   Address m_source;
   Address m_destination;
   uint8_t m_protocol;
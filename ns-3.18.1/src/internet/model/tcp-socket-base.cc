@@ -39,6 +39,7 @@
 #include "ns3/packet.h"
 #include "ns3/uinteger.h"
 #include "ns3/double.h"
+#include "ns3/boolean.h"
 #include "ns3/trace-source-accessor.h"
 #include "tcp-socket-base.h"
 #include "tcp-l4-protocol.h"
@@ -75,6 +76,14 @@ TcpSocketBase::GetTypeId (void)
                    UintegerValue (65535),
                    MakeUintegerAccessor (&TcpSocketBase::m_maxWinSize),
                    MakeUintegerChecker<uint16_t> ())
+    .AddAttribute ("WindowScaling", "Enable the window scale option (RFC 7323)",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&TcpSocketBase::m_winScalingEnabled),
+                   MakeBooleanChecker ())
+    .AddAttribute ("Timestamp", "Enable the timestamps option (RFC 7323)",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&TcpSocketBase::m_timestampEnabled),
+                   MakeBooleanChecker ())
     .AddAttribute ("IcmpCallback", "Callback invoked whenever an icmp error is received on this socket.",
                    CallbackValue (),
                    MakeCallbackAccessor (&TcpSocketBase::m_icmpCallback),
@@ -127,7 +136,10 @@ TcpSocketBase::TcpSocketBase (void)
     m_connected (false),
     m_segmentSize (0),
     // For attribute initialization consistency (quiet valgrind)
-    m_rWnd (0)
+    m_rWnd (0),
+    m_sndScaleFactor (0),
+    m_rcvScaleFactor (0),
+    m_timestampToEcho (0)
 {
   NS_LOG_FUNCTION (this);
 }
@@ -162,7 +174,12 @@ TcpSocketBase::TcpSocketBase (const TcpSocketBase& sock)
     m_msl (sock.m_msl),
     m_segmentSize (sock.m_segmentSize),
     m_maxWinSize (sock.m_maxWinSize),
-    m_rWnd (sock.m_rWnd)
+    m_rWnd (sock.m_rWnd),
+    m_winScalingEnabled (sock.m_winScalingEnabled),
+    m_sndScaleFactor (sock.m_sndScaleFactor),
+    m_rcvScaleFactor (sock.m_rcvScaleFactor),
+    m_timestampEnabled (sock.m_timestampEnabled),
+    m_timestampToEcho (sock.m_timestampToEcho)
 {
   NS_LOG_FUNCTION (this);
   NS_LOG_LOGIC ("Invoked the copy constructor");
@@ -871,7 +888,14 @@ TcpSocketBase::DoForwardUp (Ptr<Packet> packet, Ipv4Header header, uint16_t port
       NS_LOG_LOGIC (this << " Leaving zerowindow persist state");
       m_persistEvent.Cancel ();
     }
-  m_rWnd = tcpHeader.GetWindowSize ();
+  if (tcpHeader.GetFlags () & TcpHeader::SYN)
+    { // The window of a SYN segment is never scaled (RFC 7323)
+      m_rWnd = tcpHeader.GetWindowSize ();
+    }
+  else
+    {
+      m_rWnd = (uint32_t)tcpHeader.GetWindowSize () << m_sndScaleFactor;
+    }
 
   // Discard fully out of range data packets
   if (packet->GetSize ()
@@ -966,7 +990,14 @@ TcpSocketBase::DoForwardUp (Ptr<Packet> packet, Ipv6Header header, uint16_t port
       NS_LOG_LOGIC (this << " Leaving zerowindow persist state");
       m_persistEvent.Cancel ();
     }
-  m_rWnd = tcpHeader.GetWindowSize ();
+  if (tcpHeader.GetFlags () & TcpHeader::SYN)
+    { // The window of a SYN segment is never scaled (RFC 7323)
+      m_rWnd = tcpHeader.GetWindowSize ();
+    }
+  else
+    {
+      m_rWnd = (uint32_t)tcpHeader.GetWindowSize () << m_sndScaleFactor;
+    }
 
   // Discard fully out of range packets
   if (packet->GetSize ()
@@ -1801,8 +1832,9 @@ TcpSocketBase::CompleteFork (Ptr<Packet> p, const TcpHeader& h,
   m_state = SYN_RCVD;
   m_cnCount = m_cnRetries;
   SetupCallback ();
-  // Set the sequence number and send SYN+ACK
+  // Set the sequence number, negotiate the options and send SYN+ACK
   m_rxBuffer.SetNextRxSequence (h.GetSequenceNumber () + SequenceNumber32 (1));
+  ReadOptions (h);
   SendEmptyPacket (TcpHeader::SYN | TcpHeader::ACK);
 }
 
@@ -2011,7 +2043,14 @@ TcpSocketBase::AvailableWindow ()
 uint16_t
 TcpSocketBase::AdvertisedWindowSize ()
 {
-  return std::min (m_rxBuffer.MaxBufferSize () - m_rxBuffer.Size (), (uint32_t)m_maxWinSize);
+  uint32_t w = m_rxBuffer.MaxBufferSize () - m_rxBuffer.Size ();
+  // Only SYN segments are sent before the connection is synchronized, and
+  // their window is never scaled (RFC 7323)
+  if (m_state != SYN_SENT && m_state != SYN_RCVD)
+    {
+      w >>= m_rcvScaleFactor;
+    }
+  return std::min (w, (uint32_t)m_maxWinSize);
 }
 
 // Receipt of new packet, put into Rx buffer
@@ -2076,9 +2115,24 @@ void
 TcpSocketBase::EstimateRtt (const TcpHeader& tcpHeader)
 {
   // Use m_rtt for the estimation. Note, RTT of duplicated acknowledgement
-  // (which should be ignored) is handled by m_rtt. Once timestamp option
-  // is implemented, this function would be more elaborated.
-  Time nextRtt =  m_rtt->AckSeq (tcpHeader.GetAckNumber () );
+  // (which should be ignored) is handled by m_rtt. With the timestamps
+  // option, an ack which advances the window gives an RTT sample from the
+  // echoed timestamp (RTTM, RFC 7323), even for retransmitted data.
+  uint32_t echoRtt = 0;
+  if (m_timestampEnabled && tcpHeader.HasTimestamp ()
+      && tcpHeader.GetAckNumber () > m_txBuffer.HeadSequence ())
+    {
+      echoRtt = (uint32_t)Simulator::Now ().GetMilliSeconds () - tcpHeader.GetTimestampEcho ();
+    }
+  Time nextRtt;
+  if (echoRtt != 0)
+    {
+      nextRtt = m_rtt->AckSeq (tcpHeader.GetAckNumber (), MilliSeconds (echoRtt));
+    }
+  else
+    { // No timestamp, or an RTT below the 1 ms timestamp clock tick
+      nextRtt = m_rtt->AckSeq (tcpHeader.GetAckNumber ());
+    }
 
   //nextRtt will be zero for dup acks.  Don't want to update lastRtt in that case
   //but still needed to do list clearing that is done in AckSeq. 
@@ -2418,16 +2472,76 @@ TcpSocketBase::GetAllowBroadcast (void) const
   return false;
 }
 
-/** Placeholder function for future extension that reads more from the TCP header */
+/** Read the window scale and timestamps options of the incoming header */
 void
-TcpSocketBase::ReadOptions (const TcpHeader&)
+TcpSocketBase::ReadOptions (const TcpHeader& header)
 {
+  NS_LOG_FUNCTION (this << header);
+  if (m_state == LISTEN)
+    { // The forked socket negotiates the options in CompleteFork()
+      return;
+    }
+  if (header.GetFlags () & TcpHeader::SYN)
+    { // An option is used only if both ends offer it in their SYN
+      if (m_winScalingEnabled)
+        {
+          if (header.HasWindowScale ())
+            { // Shifts above 14 are used as 14 (RFC 7323 sec. 2.3)
+              m_sndScaleFactor = std::min (header.GetWindowScale (), (uint8_t)14);
+              m_rcvScaleFactor = CalculateWScale ();
+            }
+          else
+            {
+              NS_LOG_LOGIC (this << " Peer does not support window scaling");
+              m_winScalingEnabled = false;
+              m_sndScaleFactor = 0;
+              m_rcvScaleFactor = 0;
+            }
+        }
+      if (m_timestampEnabled && !header.HasTimestamp ())
+        {
+          NS_LOG_LOGIC (this << " Peer does not support timestamps");
+          m_timestampEnabled = false;
+        }
+    }
+  if (m_timestampEnabled && header.HasTimestamp ()
+      && ((header.GetFlags () & TcpHeader::SYN)
+          || header.GetSequenceNumber () <= m_rxBuffer.NextRxSequence ()))
+    { // Echo the timestamp of the segment at the left edge of the window
+      // (TS.Recent, RFC 7323 sec. 4.3)
+      m_timestampToEcho = header.GetTimestamp ();
+    }
 }
 
-/** Placeholder function for future extension that changes the TCP header */
+/** Add the window scale and timestamps options to the outgoing header */
 void
-TcpSocketBase::AddOptions (TcpHeader&)
+TcpSocketBase::AddOptions (TcpHeader& header)
 {
+  NS_LOG_FUNCTION (this << header);
+  // On a SYN+ACK, the enabled options are those the peer offered, as
+  // ReadOptions() cleared the others
+  if ((header.GetFlags () & TcpHeader::SYN) && m_winScalingEnabled)
+    {
+      header.SetWindowScale (CalculateWScale ());
+    }
+  if (m_timestampEnabled)
+    { // The timestamp clock ticks every millisecond
+      header.SetTimestamp ((uint32_t)Simulator::Now ().GetMilliSeconds (), m_timestampToEcho);
+    }
+}
+
+/** Smallest shift which makes the Rx buffer size fit in the window field */
+uint8_t
+TcpSocketBase::CalculateWScale (void) const
+{
+  uint32_t maxSpace = m_rxBuffer.MaxBufferSize ();
+  uint8_t scale = 0;
+  while (maxSpace > 0xffff && scale < 14)
+    {
+      maxSpace >>= 1;
+      ++scale;
+    }
+  return scale;
 }
 
 } // namespace ns3
@@ -189,6 +189,7 @@ protected:
   virtual void DoRetransmit (void); // Retransmit the oldest packet
   virtual void ReadOptions (const TcpHeader&); // Read option from incoming packets
   virtual void AddOptions (TcpHeader&); // Add option to outgoing packets
+  uint8_t CalculateWScale (void) const; // Window scale shift to offer for the Rx buffer size
 
 protected:
   // Counters and events
@@ -240,6 +241,13 @@ protected:
   uint32_t              m_segmentSize; //< Segment size
   uint16_t              m_maxWinSize;  //< Maximum window size to advertise
   TracedValue<uint32_t> m_rWnd;        //< Flow control window at remote side
+
+  // Options (RFC 7323)
+  bool     m_winScalingEnabled; //< Window scale option enabled, cleared if the peer does not support it
+  uint8_t  m_sndScaleFactor;    //< Shift applied to the windows received from the peer
+  uint8_t  m_rcvScaleFactor;    //< Shift applied to the windows advertised to the peer
+  bool     m_timestampEnabled;  //< Timestamps option enabled, cleared if the peer does not support it
+  uint32_t m_timestampToEcho;   //< Timestamp to echo to the peer (TS.Recent)
 };
 
 } // namespace ns3
@@ -100,35 +100,45 @@ UdpHeader::InitializeChecksum (Ipv6Address source,
 uint16_t
 UdpHeader::CalculateHeaderChecksum (uint16_t size) const
 {
-  Buffer buf = Buffer ((2 * Address::MAX_SIZE) + 8);
-  buf.AddAtStart ((2 * Address::MAX_SIZE) + 8);
-  Buffer::Iterator it = buf.Begin ();
-  uint32_t hdrSize = 0;
-
-  WriteTo (it, m_source);
-  WriteTo (it, m_destination);
+  // The pseudo header is summed in place rather than serialized in a
+  // Buffer, in the byte order CalculateIpChecksum reads it.
+  uint8_t buf[(2 * Address::MAX_SIZE) + 8];
+  uint32_t hdrSize = m_source.CopyTo (buf);
+  hdrSize += m_destination.CopyTo (buf + hdrSize);
   if (Ipv4Address::IsMatchingType(m_source))
     {
-      it.WriteU8 (0); /* protocol */
-      it.WriteU8 (m_protocol); /* protocol */
-      it.WriteU8 (size >> 8); /* length */
-      it.WriteU8 (size & 0xff); /* length */
-      hdrSize = 12;
+      buf[hdrSize++] = 0;
+      buf[hdrSize++] = m_protocol; /* protocol */
+      buf[hdrSize++] = size >> 8; /* length */
+      buf[hdrSize++] = size & 0xff; /* length */
     }
   else if (Ipv6Address::IsMatchingType(m_source))
     {
-      it.WriteU16 (0);
-      it.WriteU8 (size >> 8); /* length */
-      it.WriteU8 (size & 0xff); /* length */
-      it.WriteU16 (0);
-      it.WriteU8 (0);
-      it.WriteU8 (m_protocol); /* protocol */
-      hdrSize = 40;
+      buf[hdrSize++] = 0;
+      buf[hdrSize++] = 0;
+      buf[hdrSize++] = size >> 8; /* length */
+      buf[hdrSize++] = size & 0xff; /* length */
+      buf[hdrSize++] = 0;
+      buf[hdrSize++] = 0;
+      buf[hdrSize++] = 0;
+      buf[hdrSize++] = m_protocol; /* protocol */
+    }
+  else
+    {
+      hdrSize = 0;
     }
 
-  it = buf.Begin ();
+  uint32_t sum = 0;
+  for (uint32_t i = 0; i + 1 < hdrSize; i += 2)
+    {
+      sum += buf[i] | (buf[i + 1] << 8);
+    }
+  while (sum >> 16)
+    {
+      sum = (sum & 0xffff) + (sum >> 16);
+    }
   /* we don't CompleteChecksum ( ~ ) now */
-  return ~(it.CalculateIpChecksum (hdrSize));
+  return sum;
 }
 
 bool
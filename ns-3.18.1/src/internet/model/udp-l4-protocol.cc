@@ -358,7 +358,8 @@ UdpL4Protocol::Receive (Ptr<Packet> packet,
       return IpL4Protocol::RX_ENDPOINT_UNREACH;
     }
 
-  packet->RemoveHeader(udpHeader);
+  // the header has already been parsed above, just strip it
+  packet->RemoveAtStart (udpHeader.GetSerializedSize ());
   for (Ipv4EndPointDemux::EndPointsI endPoint = endPoints.begin ();
        endPoint != endPoints.end (); endPoint++)
     {
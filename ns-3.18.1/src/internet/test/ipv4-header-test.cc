@@ -42,6 +42,7 @@
 #include <string>
 #include <sstream>
 #include <limits>
+#include <cstring>
 #include <netinet/in.h>
 #include <sys/socket.h>
 #include <sys/types.h>
@@ -256,11 +257,72 @@ Ipv4HeaderTest::DoRun (void)
   Simulator::Destroy ();
 }
 //-----------------------------------------------------------------------------
+class Ipv4HeaderTtlChecksumTest : public TestCase
+{
+public:
+  virtual void DoRun (void);
+  Ipv4HeaderTtlChecksumTest ();
+private:
+  Ipv4Header MakeHeader (uint8_t ttl, uint8_t protocol);
+};
+
+Ipv4HeaderTtlChecksumTest::Ipv4HeaderTtlChecksumTest ()
+  : TestCase ("Ipv4 header checksum update on TTL decrement")
+{
+}
+
+Ipv4Header
+Ipv4HeaderTtlChecksumTest::MakeHeader (uint8_t ttl, uint8_t protocol)
+{
+  Ipv4Header header;
+  header.EnableChecksum ();
+  header.SetSource (Ipv4Address ("10.1.2.3"));
+  header.SetDestination (Ipv4Address ("192.168.200.17"));
+  header.SetPayloadSize (1234);
+  header.SetIdentification (0xbeef);
+  header.SetDontFragment ();
+  header.SetTos (0xb8);
+  header.SetProtocol (protocol);
+  header.SetTtl (ttl);
+  return header;
+}
+
+void
+Ipv4HeaderTtlChecksumTest::DoRun (void)
+{
+  uint8_t protocols[] = { 1, 6, 17, 0, 255 };
+  for (uint32_t p = 0; p < sizeof (protocols); p++)
+    {
+      Ptr<Packet> packet = Create<Packet> (10);
+      packet->AddHeader (MakeHeader (255, protocols[p]));
+      for (uint32_t ttl = 254; ttl > 0; ttl--)
+        {
+          // forward the packet as a router does
+          Ipv4Header header;
+          header.EnableChecksum ();
+          packet->RemoveHeader (header);
+          NS_TEST_ASSERT_MSG_EQ (header.IsChecksumOk (), true, "Bad checksum with ttl " << ttl + 1);
+          header.SetTtl (header.GetTtl () - 1);
+          packet->AddHeader (header);
+
+          Ptr<Packet> reference = Create<Packet> (10);
+          reference->AddHeader (MakeHeader (ttl, protocols[p]));
+          uint8_t bytes[30];
+          uint8_t referenceBytes[30];
+          packet->CopyData (bytes, 30);
+          reference->CopyData (referenceBytes, 30);
+          NS_TEST_ASSERT_MSG_EQ (std::memcmp (bytes, referenceBytes, 30), 0,
+                                 "Header differs from a new one with ttl " << ttl);
+        }
+    }
+}
+//-----------------------------------------------------------------------------
 class Ipv4HeaderTestSuite : public TestSuite
 {
 public:
   Ipv4HeaderTestSuite () : TestSuite ("ipv4-header", UNIT)
   {
     AddTestCase (new Ipv4HeaderTest, TestCase::QUICK);
+    AddTestCase (new Ipv4HeaderTtlChecksumTest, TestCase::QUICK);
   }
 } g_ipv4HeaderTestSuite;
@@ -93,6 +93,48 @@ RttTestCase::DoTeardown (void)
 {
 }
 
+// Check that an RTT measured from the timestamps option is taken for
+// retransmitted data, which Karn's algorithm skips otherwise
+class RttTimestampTestCase : public TestCase
+{
+public:
+  RttTimestampTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+RttTimestampTestCase::RttTimestampTestCase ()
+  : TestCase ("Rtt measurement from timestamps test")
+{
+}
+
+void
+RttTimestampTestCase::DoRun (void)
+{
+  Ptr<RttMeanDeviation> rtt = CreateObject<RttMeanDeviation> ();
+  rtt->SetCurrentEstimate (Seconds (1));
+  rtt->SetMinRto (Seconds (0));
+
+  // Without the timestamps option, the ack of a retransmitted segment
+  // does not give a sample
+  rtt->SentSeq (SequenceNumber32 (1), 100);
+  rtt->SentSeq (SequenceNumber32 (1), 100);
+  NS_TEST_EXPECT_MSG_EQ (rtt->AckSeq (SequenceNumber32 (101)), Seconds (0), "Retransmitted segment was sampled");
+  NS_TEST_EXPECT_MSG_EQ (rtt->GetCurrentEstimate (), Seconds (1), "Estimate changed without a sample");
+
+  // With it, the echoed timestamp gives the sample
+  rtt->SentSeq (SequenceNumber32 (101), 100);
+  rtt->SentSeq (SequenceNumber32 (101), 100);
+  rtt->IncreaseMultiplier ();
+  Time sample = rtt->AckSeq (SequenceNumber32 (201), MilliSeconds (50));
+  NS_TEST_EXPECT_MSG_EQ (sample, MilliSeconds (50), "Unexpected sample");
+  NS_TEST_EXPECT_MSG_EQ (rtt->GetCurrentEstimate (), MilliSeconds (50), "First sample should set the estimate");
+  NS_TEST_EXPECT_MSG_EQ (rtt->RetransmitTimeout (), MilliSeconds (250), "Multiplier was not reset");
+
+  // The history covered by the ack is gone
+  NS_TEST_EXPECT_MSG_EQ (rtt->AckSeq (SequenceNumber32 (201)), Seconds (0), "History was not cleared");
+}
 
 static class RttTestSuite : public TestSuite
 {
@@ -103,6 +145,7 @@ public:
     AddTestCase (new RttTestCase (150.0, 10.0, .1), TestCase::QUICK);
     AddTestCase (new RttTestCase (5000.0, 5.0, .5), TestCase::QUICK);
     AddTestCase (new RttTestCase (200.0, 25.0, .7), TestCase::QUICK);
+    AddTestCase (new RttTimestampTestCase (), TestCase::QUICK);
   }
 
 } g_tcpTestSuite;
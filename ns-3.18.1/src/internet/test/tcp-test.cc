@@ -36,7 +36,11 @@
 #include "ns3/inet-socket-address.h"
 #include "ns3/inet6-socket-address.h"
 #include "ns3/uinteger.h"
+#include "ns3/boolean.h"
 #include "ns3/log.h"
+#include "ns3/tcp-header.h"
+#include "ns3/internet-stack-helper.h"
+#include "ns3/ipv4-address-helper.h"
 
 #include "ns3/ipv4-end-point.h"
 #include "ns3/arp-l3-protocol.h"
@@ -425,6 +429,184 @@ TcpTestCase::AddSimpleNetDevice6 (Ptr<Node> node, Ipv6Address ipaddr, Ipv6Prefix
   return dev;
 }
 
+// Check the serialization of the window scale and timestamps options
+class TcpHeaderOptionsTestCase : public TestCase
+{
+public:
+  TcpHeaderOptionsTestCase ();
+private:
+  virtual void DoRun (void);
+};
+
+TcpHeaderOptionsTestCase::TcpHeaderOptionsTestCase ()
+  : TestCase ("Serialize and deserialize TCP header options")
+{
+}
+
+void
+TcpHeaderOptionsTestCase::DoRun (void)
+{
+  TcpHeader header;
+  header.SetFlags (TcpHeader::SYN);
+  header.SetWindowScale (7);
+  header.SetTimestamp (0x01020304, 0xa0b0c0d0);
+  NS_TEST_EXPECT_MSG_EQ (header.GetSerializedSize (), 36, "Unexpected header size with options");
+
+  Ptr<Packet> p = Create<Packet> (100);
+  p->AddHeader (header);
+  TcpHeader received;
+  p->RemoveHeader (received);
+  NS_TEST_EXPECT_MSG_EQ (p->GetSize (), 100, "Options were not removed with the header");
+  NS_TEST_EXPECT_MSG_EQ (received.HasWindowScale (), true, "Window scale option lost");
+  NS_TEST_EXPECT_MSG_EQ ((uint32_t)received.GetWindowScale (), 7, "Unexpected window scale");
+  NS_TEST_EXPECT_MSG_EQ (received.HasTimestamp (), true, "Timestamps option lost");
+  NS_TEST_EXPECT_MSG_EQ (received.GetTimestamp (), 0x01020304, "Unexpected timestamp");
+  NS_TEST_EXPECT_MSG_EQ (received.GetTimestampEcho (), 0xa0b0c0d0, "Unexpected timestamp echo");
+
+  received.ClearOptions ();
+  NS_TEST_EXPECT_MSG_EQ (received.GetSerializedSize (), 20, "Unexpected header size without options");
+
+  // Unknown options are skipped: MSS and SACK permitted, then the
+  // timestamps option, then the end of the list
+  const uint8_t raw[] = {
+    0x00, 0x50, 0x13, 0x88, 0, 0, 0, 1, 0, 0, 0, 0, 0xa0, TcpHeader::SYN, 0xff, 0xff, 0, 0, 0, 0,
+    2, 4, 0x05, 0xb4, 4, 2, 8, 10, 0, 0, 0, 42, 0, 0, 0, 0, 0, 0, 0, 0
+  };
+  Buffer buffer;
+  buffer.AddAtStart (sizeof (raw));
+  buffer.Begin ().Write (raw, sizeof (raw));
+  NS_TEST_EXPECT_MSG_EQ (received.Deserialize (buffer.Begin ()), sizeof (raw), "Unexpected header size");
+  NS_TEST_EXPECT_MSG_EQ (received.GetDestinationPort (), 5000, "Unexpected destination port");
+  NS_TEST_EXPECT_MSG_EQ (received.HasWindowScale (), false, "Unexpected window scale option");
+  NS_TEST_EXPECT_MSG_EQ (received.HasTimestamp (), true, "Timestamps option not found");
+  NS_TEST_EXPECT_MSG_EQ (received.GetTimestamp (), 42, "Unexpected timestamp");
+}
+
+// Check that a window larger than 64 KB is advertised when both ends
+// enable window scaling, and only then
+class TcpWindowScalingTestCase : public TestCase
+{
+public:
+  TcpWindowScalingTestCase (bool serverOptions, bool sourceOptions);
+private:
+  virtual void DoRun (void);
+  void ServerHandleConnectionCreated (Ptr<Socket> s, const Address & addr);
+  void ServerHandleRecv (Ptr<Socket> sock);
+  void SourceHandleSend (Ptr<Socket> sock, uint32_t available);
+  void RwndTrace (uint32_t oldValue, uint32_t newValue);
+
+  bool m_serverOptions;
+  bool m_sourceOptions;
+  uint32_t m_totalBytes;
+  uint32_t m_sentBytes;
+  uint32_t m_receivedBytes;
+  uint32_t m_maxRwnd;
+};
+
+TcpWindowScalingTestCase::TcpWindowScalingTestCase (bool serverOptions, bool sourceOptions)
+  : TestCase ("Window scaling and timestamps, server options=" + std::string (serverOptions ? "on" : "off")
+              + " source options=" + std::string (sourceOptions ? "on" : "off")),
+    m_serverOptions (serverOptions),
+    m_sourceOptions (sourceOptions),
+    m_totalBytes (1000000)
+{
+}
+
+void
+TcpWindowScalingTestCase::DoRun (void)
+{
+  m_sentBytes = 0;
+  m_receivedBytes = 0;
+  m_maxRwnd = 0;
+
+  NodeContainer nodes;
+  nodes.Create (2);
+  InternetStackHelper internet;
+  internet.Install (nodes);
+  Ptr<SimpleChannel> channel = CreateObject<SimpleChannel> ();
+  NetDeviceContainer devices;
+  for (uint32_t i = 0; i < 2; ++i)
+    {
+      Ptr<SimpleNetDevice> dev = CreateObject<SimpleNetDevice> ();
+      dev->SetAddress (Mac48Address::Allocate ());
+      dev->SetChannel (channel);
+      nodes.Get (i)->AddDevice (dev);
+      devices.Add (dev);
+    }
+  Ipv4AddressHelper ipv4;
+  ipv4.SetBase ("10.1.1.0", "255.255.255.0");
+  Ipv4InterfaceContainer interfaces = ipv4.Assign (devices);
+
+  Ptr<Socket> server = Socket::CreateSocket (nodes.Get (0), TcpSocketFactory::GetTypeId ());
+  Ptr<Socket> source = Socket::CreateSocket (nodes.Get (1), TcpSocketFactory::GetTypeId ());
+  server->SetAttribute ("RcvBufSize", UintegerValue (1 << 20));
+  server->SetAttribute ("WindowScaling", BooleanValue (m_serverOptions));
+  server->SetAttribute ("Timestamp", BooleanValue (m_serverOptions));
+  source->SetAttribute ("SndBufSize", UintegerValue (1 << 20));
+  source->SetAttribute ("WindowScaling", BooleanValue (m_sourceOptions));
+  source->SetAttribute ("Timestamp", BooleanValue (m_sourceOptions));
+  source->TraceConnectWithoutContext ("RWND", MakeCallback (&TcpWindowScalingTestCase::RwndTrace, this));
+
+  uint16_t port = 50000;
+  server->Bind (InetSocketAddress (Ipv4Address::GetAny (), port));
+  server->Listen ();
+  server->SetAcceptCallback (MakeNullCallback<bool, Ptr< Socket >, const Address &> (),
+                             MakeCallback (&TcpWindowScalingTestCase::ServerHandleConnectionCreated, this));
+  source->SetSendCallback (MakeCallback (&TcpWindowScalingTestCase::SourceHandleSend, this));
+  source->Connect (InetSocketAddress (interfaces.GetAddress (0), port));
+
+  Simulator::Run ();
+
+  NS_TEST_EXPECT_MSG_EQ (m_receivedBytes, m_totalBytes, "Server did not receive all bytes");
+  if (m_serverOptions && m_sourceOptions)
+    {
+      NS_TEST_EXPECT_MSG_GT (m_maxRwnd, 65535, "Window was not scaled");
+    }
+  else
+    {
+      NS_TEST_EXPECT_MSG_LT (m_maxRwnd, 65536, "Window was scaled without negotiation");
+    }
+  Simulator::Destroy ();
+}
+
+void
+TcpWindowScalingTestCase::ServerHandleConnectionCreated (Ptr<Socket> s, const Address & addr)
+{
+  s->SetRecvCallback (MakeCallback (&TcpWindowScalingTestCase::ServerHandleRecv, this));
+}
+
+void
+TcpWindowScalingTestCase::ServerHandleRecv (Ptr<Socket> sock)
+{
+  Ptr<Packet> p;
+  while ((p = sock->Recv ()) && p->GetSize () > 0)
+    {
+      m_receivedBytes += p->GetSize ();
+    }
+}
+
+void
+TcpWindowScalingTestCase::SourceHandleSend (Ptr<Socket> sock, uint32_t available)
+{
+  while (sock->GetTxAvailable () > 0 && m_sentBytes < m_totalBytes)
+    {
+      uint32_t toSend = std::min (m_totalBytes - m_sentBytes, sock->GetTxAvailable ());
+      int sent = sock->Send (Create<Packet> (toSend));
+      NS_TEST_EXPECT_MSG_EQ ((sent != -1), true, "Error during send ?");
+      m_sentBytes += sent;
+    }
+  if (m_sentBytes == m_totalBytes)
+    {
+      sock->Close ();
+    }
+}
+
+void
+TcpWindowScalingTestCase::RwndTrace (uint32_t oldValue, uint32_t newValue)
+{
+  m_maxRwnd = std::max (m_maxRwnd, newValue);
+}
+
 static class TcpTestSuite : public TestSuite
 {
 public:
@@ -442,6 +624,11 @@ public:
     AddTestCase (new TcpTestCase (13, 200, 200, 200, 200, true), TestCase::QUICK);
     AddTestCase (new TcpTestCase (13, 1, 1, 1, 1, true), TestCase::QUICK);
     AddTestCase (new TcpTestCase (100000, 100, 50, 100, 20, true), TestCase::QUICK);
+
+    AddTestCase (new TcpHeaderOptionsTestCase (), TestCase::QUICK);
+    AddTestCase (new TcpWindowScalingTestCase (true, true), TestCase::QUICK);
+    AddTestCase (new TcpWindowScalingTestCase (true, false), TestCase::QUICK);
+    AddTestCase (new TcpWindowScalingTestCase (false, true), TestCase::QUICK);
   }
 
 } g_tcpTestSuite;
@@ -178,6 +178,17 @@ LteHelper::DoDispose ()
   NS_LOG_FUNCTION (this);
   m_downlinkChannel = 0;
   m_uplinkChannel = 0;
+  // the stats calculators keep their output files open and buffered;
+  // they are created in DoInitialize and when the traces are enabled
+  Ptr<LteStatsCalculator> stats[] = { m_phyStats, m_phyTxStats, m_phyRxStats,
+                                      m_macStats, m_rlcStats, m_pdcpStats };
+  for (uint32_t i = 0; i < sizeof (stats) / sizeof (stats[0]); ++i)
+    {
+      if (stats[i] != 0)
+        {
+          stats[i]->Dispose ();
+        }
+    }
   Object::DoDispose ();
 }
 
@@ -22,6 +22,9 @@
 
 #include <ns3/log.h>
 #include <ns3/config.h>
+#include <ns3/simulator.h>
+#include <ns3/uinteger.h>
+#include <ns3/boolean.h>
 #include <ns3/lte-enb-rrc.h>
 #include <ns3/lte-ue-rrc.h>
 #include <ns3/lte-enb-net-device.h>
@@ -33,7 +36,8 @@ NS_LOG_COMPONENT_DEFINE ("LteStatsCalculator");
 
 LteStatsCalculator::LteStatsCalculator ()
   : m_dlOutputFilename (""),
-    m_ulOutputFilename ("")
+    m_ulOutputFilename (""),
+    m_flushOnDestroy (false)
 {
   // Nothing to do here
 
@@ -41,7 +45,12 @@ LteStatsCalculator::LteStatsCalculator ()
 
 LteStatsCalculator::~LteStatsCalculator ()
 {
-  // Nothing to do here
+  for (std::map<std::string, OutputFile>::iterator it = m_outputFiles.begin ();
+       it != m_outputFiles.end (); ++it)
+    {
+      delete it->second.stream;
+      delete [] it->second.buffer;
+    }
 }
 
 
@@ -51,10 +60,116 @@ LteStatsCalculator::GetTypeId (void)
   static TypeId tid = TypeId ("ns3::LteStatsCalculator")
     .SetParent<Object> ()
     .AddConstructor<LteStatsCalculator> ()
+    .AddAttribute ("OutputBufferSize",
+                   "Size in bytes of the buffer of each output file.",
+                   UintegerValue (1 << 20),
+                   MakeUintegerAccessor (&LteStatsCalculator::m_outputBufferSize),
+                   MakeUintegerChecker<uint32_t> ())
+    .AddAttribute ("FlushInterval",
+                   "If not zero, the output files are flushed at this interval "
+                   "while records are written to them.  If zero, nothing is "
+                   "written before a buffer is full or the simulation ends, so "
+                   "a crash loses up to OutputBufferSize bytes of records of "
+                   "each file.",
+                   TimeValue (Seconds (0)),
+                   MakeTimeAccessor (&LteStatsCalculator::m_flushInterval),
+                   MakeTimeChecker ())
+    .AddAttribute ("BinaryOutput",
+                   "If true, the records are written as raw doubles in host "
+                   "byte order, without heading, instead of as text.",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&LteStatsCalculator::m_binaryOutput),
+                   MakeBooleanChecker ())
   ;
   return tid;
 }
 
+void
+LteStatsCalculator::DoDispose ()
+{
+  NS_LOG_FUNCTION (this);
+  Flush ();
+  m_flushEvent.Cancel ();
+  for (std::map<std::string, OutputFile>::iterator it = m_outputFiles.begin ();
+       it != m_outputFiles.end (); ++it)
+    {
+      it->second.stream->close ();
+    }
+  Object::DoDispose ();
+}
+
+std::ofstream*
+LteStatsCalculator::GetOutputStream (std::string filename, std::string heading)
+{
+  std::map<std::string, OutputFile>::iterator it = m_outputFiles.find (filename);
+  if (it == m_outputFiles.end ())
+    {
+      OutputFile file;
+      file.stream = new std::ofstream ();
+      file.buffer = 0;
+      if (m_outputBufferSize > 0)
+        {
+          // the buffer has to be set before the file is opened
+          file.buffer = new char[m_outputBufferSize];
+          file.stream->rdbuf ()->pubsetbuf (file.buffer, m_outputBufferSize);
+        }
+      file.stream->open (filename.c_str (), m_binaryOutput ? std::ios_base::out | std::ios_base::binary : std::ios_base::out);
+      if (!file.stream->is_open ())
+        {
+          NS_LOG_ERROR ("Can't open file " << filename.c_str ());
+          delete file.stream;
+          delete [] file.buffer;
+          return 0;
+        }
+      if (!m_binaryOutput)
+        {
+          *file.stream << heading << "\n";
+        }
+      it = m_outputFiles.insert (std::make_pair (filename, file)).first;
+      ScheduleFlushOnDestroy ();
+    }
+  if (!m_flushInterval.IsZero () && !m_flushEvent.IsRunning ())
+    {
+      m_flushEvent = Simulator::Schedule (m_flushInterval, &LteStatsCalculator::Flush, this);
+    }
+  return it->second.stream;
+}
+
+void
+LteStatsCalculator::ScheduleFlushOnDestroy (void)
+{
+  if (!m_flushOnDestroy)
+    {
+      // the calculators usually live as long as their helper, which
+      // may outlive the simulation
+      Simulator::ScheduleDestroy (&LteStatsCalculator::Flush, Ptr<LteStatsCalculator> (this));
+      m_flushOnDestroy = true;
+    }
+}
+
+bool
+LteStatsCalculator::IsBinaryOutput (void) const
+{
+  return m_binaryOutput;
+}
+
+void
+LteStatsCalculator::WriteBinaryRecord (std::ostream *out, const double *fields, uint32_t n)
+{
+  out->write (reinterpret_cast<const char *> (fields), n * sizeof (double));
+}
+
+void
+LteStatsCalculator::Flush (void)
+{
+  NS_LOG_FUNCTION (this);
+  for (std::map<std::string, OutputFile>::iterator it = m_outputFiles.begin ();
+       it != m_outputFiles.end (); ++it)
+    {
+      it->second.stream->flush ();
+    }
+}
+
 
 void
 LteStatsCalculator::SetUlOutputFilename (std::string outputFilename)
@@ -23,7 +23,10 @@
 
 #include "ns3/object.h"
 #include "ns3/string.h"
+#include "ns3/nstime.h"
+#include "ns3/event-id.h"
 #include <map>
+#include <fstream>
 
 namespace ns3 {
 
@@ -104,7 +107,51 @@ public:
    */
   uint16_t GetCellIdPath (std::string path);
 
+  /**
+   * Writes the buffered records to the output files.  This is done
+   * when a buffer is full, every FlushInterval if it is not zero, when
+   * the simulator is destroyed and when the calculator is disposed.
+   * The records still buffered when the program crashes are lost.
+   */
+  virtual void Flush (void);
+
 protected:
+  virtual void DoDispose (void);
+
+  /**
+   * Returns the output stream of a file, which is kept open and
+   * buffered until the calculator is disposed.  The file is created and
+   * the heading is written (unless the output is binary) on the first
+   * call for this file name.
+   *
+   * \param filename name of the file
+   * \param heading heading line of the file
+   * \return the stream, or 0 if the file can't be opened
+   */
+  std::ofstream* GetOutputStream (std::string filename, std::string heading);
+
+  /**
+   * Makes sure that Flush is called when the simulator is destroyed.
+   * GetOutputStream does this when it opens a file; calculators that
+   * hold records back before opening their files call it on the first
+   * record.
+   */
+  void ScheduleFlushOnDestroy (void);
+
+  /**
+   * \return true if the records are written in binary form, as
+   * WriteBinaryRecord does, rather than as text
+   */
+  bool IsBinaryOutput (void) const;
+
+  /**
+   * Writes a record as raw doubles in host byte order, one per field.
+   *
+   * \param out the output stream
+   * \param fields the values of the fields of the record
+   * \param n the number of fields
+   */
+  static void WriteBinaryRecord (std::ostream *out, const double *fields, uint32_t n);
 
   static uint64_t FindImsiFromEnbRlcPath (std::string path);
   static uint64_t FindImsiFromUePhy (std::string path);
@@ -122,6 +169,18 @@ private:
 
   std::string m_dlOutputFilename;
   std::string m_ulOutputFilename;
+
+  struct OutputFile
+  {
+    std::ofstream *stream;
+    char *buffer;
+  };
+  std::map<std::string, OutputFile> m_outputFiles;
+  uint32_t m_outputBufferSize;
+  Time m_flushInterval;
+  bool m_binaryOutput;
+  bool m_flushOnDestroy;
+  EventId m_flushEvent;
 };
 
 } // namespace ns3
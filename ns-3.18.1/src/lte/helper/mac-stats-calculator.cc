@@ -30,8 +30,8 @@ NS_LOG_COMPONENT_DEFINE ("MacStatsCalculator");
 NS_OBJECT_ENSURE_REGISTERED (MacStatsCalculator);
 
 MacStatsCalculator::MacStatsCalculator ()
-  : m_dlFirstWrite (true),
-    m_ulFirstWrite (true)
+  : m_dlEpochIndex (0),
+    m_ulEpochIndex (0)
 {
   NS_LOG_FUNCTION (this);
 
@@ -58,6 +58,12 @@ MacStatsCalculator::GetTypeId (void)
                    StringValue ("UlMacStats.txt"),
                    MakeStringAccessor (&MacStatsCalculator::SetUlOutputFilename),
                    MakeStringChecker ())
+    .AddAttribute ("AggregationEpoch",
+                   "If not zero, one record is written per UE and per epoch of "
+                   "this duration instead of one per scheduled subframe.",
+                   TimeValue (Seconds (0)),
+                   MakeTimeAccessor (&MacStatsCalculator::m_epoch),
+                   MakeTimeChecker ())
   ;
   return tid;
 }
@@ -86,6 +92,20 @@ MacStatsCalculator::GetDlOutputFilename (void)
   return LteStatsCalculator::GetDlOutputFilename ();
 }
 
+bool
+MacStatsCalculator::UeKey::operator < (const UeKey &o) const
+{
+  if (cellId != o.cellId)
+    {
+      return cellId < o.cellId;
+    }
+  if (imsi != o.imsi)
+    {
+      return imsi < o.imsi;
+    }
+  return rnti < o.rnti;
+}
+
 void
 MacStatsCalculator::DlScheduling (uint16_t cellId, uint64_t imsi, uint32_t frameNo, uint32_t subframeNo,
                                   uint16_t rnti, uint8_t mcsTb1, uint16_t sizeTb1, uint8_t mcsTb2, uint16_t sizeTb2)
@@ -93,40 +113,38 @@ MacStatsCalculator::DlScheduling (uint16_t cellId, uint64_t imsi, uint32_t frame
   NS_LOG_FUNCTION (this << cellId << imsi << frameNo << subframeNo << rnti << (uint32_t) mcsTb1 << sizeTb1 << (uint32_t) mcsTb2 << sizeTb2);
   NS_LOG_INFO ("Write DL Mac Stats in " << GetDlOutputFilename ().c_str ());
 
-  std::ofstream outFile;
-  if ( m_dlFirstWrite == true )
+  if (!m_epoch.IsZero ())
     {
-      outFile.open (GetDlOutputFilename ().c_str ());
-      if (!outFile.is_open ())
-        {
-          NS_LOG_ERROR ("Can't open file " << GetDlOutputFilename ().c_str ());
-          return;
-        }
-      m_dlFirstWrite = false;
-      outFile << "% time\tcellId\tIMSI\tframe\tsframe\tRNTI\tmcsTb1\tsizeTb1\tmcsTb2\tsizeTb2";
-      outFile << std::endl;
+      Aggregate (m_dlEpochStats, true, cellId, imsi, rnti, mcsTb1, sizeTb1, mcsTb2, sizeTb2);
+      return;
     }
-  else
+
+  std::ofstream *outFile = GetOutputStream (GetDlOutputFilename (),
+                                            "% time\tcellId\tIMSI\tframe\tsframe\tRNTI\tmcsTb1\tsizeTb1\tmcsTb2\tsizeTb2");
+  if (outFile == 0)
     {
-      outFile.open (GetDlOutputFilename ().c_str (),  std::ios_base::app);
-      if (!outFile.is_open ())
-        {
-          NS_LOG_ERROR ("Can't open file " << GetDlOutputFilename ().c_str ());
-          return;
-        }
+      return;
+    }
+
+  if (IsBinaryOutput ())
+    {
+      double fields[] = { Simulator::Now ().GetSeconds (), (double) cellId, (double) imsi,
+                          (double) frameNo, (double) subframeNo, (double) rnti,
+                          (double) mcsTb1, (double) sizeTb1, (double) mcsTb2, (double) sizeTb2 };
+      WriteBinaryRecord (outFile, fields, 10);
+      return;
     }
 
-  outFile << Simulator::Now ().GetNanoSeconds () / (double) 1e9 << "\t";
-  outFile << (uint32_t) cellId << "\t";
-  outFile << imsi << "\t";
-  outFile << frameNo << "\t";
-  outFile << subframeNo << "\t";
-  outFile << rnti << "\t";
-  outFile << (uint32_t) mcsTb1 << "\t";
-  outFile << sizeTb1 << "\t";
-  outFile << (uint32_t) mcsTb2 << "\t";
-  outFile << sizeTb2 << std::endl;
-  outFile.close ();
+  *outFile << Simulator::Now ().GetNanoSeconds () / (double) 1e9 << "\t";
+  *outFile << (uint32_t) cellId << "\t";
+  *outFile << imsi << "\t";
+  *outFile << frameNo << "\t";
+  *outFile << subframeNo << "\t";
+  *outFile << rnti << "\t";
+  *outFile << (uint32_t) mcsTb1 << "\t";
+  *outFile << sizeTb1 << "\t";
+  *outFile << (uint32_t) mcsTb2 << "\t";
+  *outFile << sizeTb2 << "\n";
 }
 
 void
@@ -136,38 +154,143 @@ MacStatsCalculator::UlScheduling (uint16_t cellId, uint64_t imsi, uint32_t frame
   NS_LOG_FUNCTION (this << cellId << imsi << frameNo << subframeNo << rnti << (uint32_t) mcs << size);
   NS_LOG_INFO ("Write UL Mac Stats in " << GetUlOutputFilename ().c_str ());
 
-  std::ofstream outFile;
-  if ( m_ulFirstWrite == true )
+  if (!m_epoch.IsZero ())
     {
-      outFile.open (GetUlOutputFilename ().c_str ());
-      if (!outFile.is_open ())
-        {
-          NS_LOG_ERROR ("Can't open file " << GetUlOutputFilename ().c_str ());
-          return;
-        }
-      m_ulFirstWrite = false;
-      outFile << "% time\tcellId\tIMSI\tframe\tsframe\tRNTI\tmcs\tsize";
-      outFile << std::endl;
+      Aggregate (m_ulEpochStats, false, cellId, imsi, rnti, mcs, size, 0, 0);
+      return;
+    }
+
+  std::ofstream *outFile = GetOutputStream (GetUlOutputFilename (),
+                                            "% time\tcellId\tIMSI\tframe\tsframe\tRNTI\tmcs\tsize");
+  if (outFile == 0)
+    {
+      return;
+    }
+
+  if (IsBinaryOutput ())
+    {
+      double fields[] = { Simulator::Now ().GetSeconds (), (double) cellId, (double) imsi,
+                          (double) frameNo, (double) subframeNo, (double) rnti,
+                          (double) mcs, (double) size };
+      WriteBinaryRecord (outFile, fields, 8);
+      return;
+    }
+
+  *outFile << Simulator::Now ().GetNanoSeconds () / (double) 1e9 << "\t";
+  *outFile << (uint32_t) cellId << "\t";
+  *outFile << imsi << "\t";
+  *outFile << frameNo << "\t";
+  *outFile << subframeNo << "\t";
+  *outFile << rnti << "\t";
+  *outFile << (uint32_t) mcs << "\t";
+  *outFile << size << "\n";
+}
+
+void
+MacStatsCalculator::Aggregate (EpochStatsMap &stats, bool dl, uint16_t cellId, uint64_t imsi, uint16_t rnti,
+                               uint8_t mcsTb1, uint16_t sizeTb1, uint8_t mcsTb2, uint16_t sizeTb2)
+{
+  // the records of a run shorter than one epoch are only written on destroy
+  ScheduleFlushOnDestroy ();
+  int64_t &epochIndex = dl ? m_dlEpochIndex : m_ulEpochIndex;
+  int64_t index = Simulator::Now ().GetTimeStep () / m_epoch.GetTimeStep ();
+  if (index != epochIndex)
+    {
+      WriteEpoch (stats, dl);
+      epochIndex = index;
+    }
+
+  UeKey key;
+  key.cellId = cellId;
+  key.imsi = imsi;
+  key.rnti = rnti;
+  EpochStatsMap::iterator it = stats.find (key);
+  if (it == stats.end ())
+    {
+      EpochStats zero = { 0, 0, 0, 0, 0 };
+      it = stats.insert (std::make_pair (key, zero)).first;
+    }
+  it->second.nTb++;
+  it->second.mcsTb1 += mcsTb1;
+  it->second.sizeTb1 += sizeTb1;
+  it->second.mcsTb2 += mcsTb2;
+  it->second.sizeTb2 += sizeTb2;
+}
+
+void
+MacStatsCalculator::WriteEpoch (EpochStatsMap &stats, bool dl)
+{
+  if (stats.empty ())
+    {
+      return;
+    }
+  std::ofstream *outFile;
+  if (dl)
+    {
+      outFile = GetOutputStream (GetDlOutputFilename (),
+                                 "% time\tcellId\tIMSI\tRNTI\tnTb\tmcsTb1\tsizeTb1\tmcsTb2\tsizeTb2");
     }
   else
     {
-      outFile.open (GetUlOutputFilename ().c_str (),  std::ios_base::app);
-      if (!outFile.is_open ())
+      outFile = GetOutputStream (GetUlOutputFilename (),
+                                 "% time\tcellId\tIMSI\tRNTI\tnTb\tmcs\tsize");
+    }
+  if (outFile == 0)
+    {
+      stats.clear ();
+      return;
+    }
+
+  double end = ((dl ? m_dlEpochIndex : m_ulEpochIndex) + 1) * m_epoch.GetSeconds ();
+  for (EpochStatsMap::const_iterator it = stats.begin (); it != stats.end (); ++it)
+    {
+      const EpochStats &s = it->second;
+      double mcsTb1 = s.mcsTb1 / (double) s.nTb;
+      double mcsTb2 = s.mcsTb2 / (double) s.nTb;
+      if (IsBinaryOutput ())
+        {
+          double fields[] = { end, (double) it->first.cellId, (double) it->first.imsi,
+                              (double) it->first.rnti, (double) s.nTb,
+                              mcsTb1, (double) s.sizeTb1, mcsTb2, (double) s.sizeTb2 };
+          WriteBinaryRecord (outFile, fields, dl ? 9 : 7);
+          continue;
+        }
+      *outFile << end << "\t";
+      *outFile << it->first.cellId << "\t";
+      *outFile << it->first.imsi << "\t";
+      *outFile << it->first.rnti << "\t";
+      *outFile << s.nTb << "\t";
+      *outFile << mcsTb1 << "\t";
+      *outFile << s.sizeTb1;
+      if (dl)
         {
-          NS_LOG_ERROR ("Can't open file " << GetUlOutputFilename ().c_str ());
-          return;
+          *outFile << "\t" << mcsTb2 << "\t" << s.sizeTb2;
         }
+      *outFile << "\n";
     }
+  stats.clear ();
+}
 
-  outFile << Simulator::Now ().GetNanoSeconds () / (double) 1e9 << "\t";
-  outFile << (uint32_t) cellId << "\t";
-  outFile << imsi << "\t";
-  outFile << frameNo << "\t";
-  outFile << subframeNo << "\t";
-  outFile << rnti << "\t";
-  outFile << (uint32_t) mcs << "\t";
-  outFile << size << std::endl;
-  outFile.close ();
+void
+MacStatsCalculator::DoDispose ()
+{
+  NS_LOG_FUNCTION (this);
+  WriteEpoch (m_dlEpochStats, true);
+  WriteEpoch (m_ulEpochStats, false);
+  LteStatsCalculator::DoDispose ();
+}
+
+void
+MacStatsCalculator::Flush (void)
+{
+  NS_LOG_FUNCTION (this);
+  if (Simulator::IsFinished ())
+    {
+      // the epoch in progress will not get any more records
+      WriteEpoch (m_dlEpochStats, true);
+      WriteEpoch (m_ulEpochStats, false);
+    }
+  LteStatsCalculator::Flush ();
 }
 
 void
@@ -26,6 +26,7 @@
 #include "ns3/uinteger.h"
 #include <string>
 #include <fstream>
+#include <map>
 
 namespace ns3 {
 
@@ -39,6 +40,14 @@ namespace ns3 {
  *   - Size of transport block 1
  *   - MCS for transport block 2 (0 if not used)
  *   - Size of transport block 2 (0 if not used)
+ *
+ * If the AggregationEpoch attribute is not zero, one record is instead
+ * saved per UE and per epoch, with:
+ *   - End of the epoch (in seconds)
+ *   - Cell ID, IMSI and C-RNTI
+ *   - Number of scheduled subframes
+ *   - Average MCS and total size of transport block 1
+ *   - Average MCS and total size of transport block 2 (downlink only)
  */
 class MacStatsCalculator : public LteStatsCalculator
 {
@@ -144,12 +153,47 @@ public:
                              uint32_t frameNo, uint32_t subframeNo, uint16_t rnti,
                              uint8_t mcs, uint16_t size);
 
+  // inherited from LteStatsCalculator
+  virtual void Flush (void);
 
-private:
+protected:
+  virtual void DoDispose (void);
 
-  bool m_dlFirstWrite;
-  bool m_ulFirstWrite;
+private:
+  /// Statistics of a UE during the current aggregation epoch
+  struct EpochStats
+  {
+    uint32_t nTb;
+    uint64_t mcsTb1;
+    uint64_t sizeTb1;
+    uint64_t mcsTb2;
+    uint64_t sizeTb2;
+  };
+  /// Key of the statistics of a UE: cell ID, IMSI and RNTI
+  struct UeKey
+  {
+    uint16_t cellId;
+    uint64_t imsi;
+    uint16_t rnti;
+    bool operator < (const UeKey &o) const;
+  };
+  typedef std::map<UeKey, EpochStats> EpochStatsMap;
 
+  /**
+   * Adds a scheduled transport block to the statistics of the current
+   * epoch, writing the statistics of the previous epoch first if it is
+   * over.
+   */
+  void Aggregate (EpochStatsMap &stats, bool dl, uint16_t cellId, uint64_t imsi, uint16_t rnti,
+                  uint8_t mcsTb1, uint16_t sizeTb1, uint8_t mcsTb2, uint16_t sizeTb2);
+  /// Writes the statistics of the current epoch and clears them
+  void WriteEpoch (EpochStatsMap &stats, bool dl);
+
+  Time m_epoch;
+  int64_t m_dlEpochIndex;
+  int64_t m_ulEpochIndex;
+  EpochStatsMap m_dlEpochStats;
+  EpochStatsMap m_ulEpochStats;
 };
 
 } // namespace ns3
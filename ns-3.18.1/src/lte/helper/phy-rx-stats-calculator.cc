@@ -32,8 +32,6 @@ NS_LOG_COMPONENT_DEFINE ("PhyRxStatsCalculator");
 NS_OBJECT_ENSURE_REGISTERED (PhyRxStatsCalculator);
 
 PhyRxStatsCalculator::PhyRxStatsCalculator ()
-  : m_dlRxFirstWrite (true),
-    m_ulRxFirstWrite (true)
 {
   NS_LOG_FUNCTION (this);
 
@@ -94,42 +92,35 @@ PhyRxStatsCalculator::DlPhyReception (PhyReceptionStatParameters params)
   NS_LOG_FUNCTION (this << params.m_cellId << params.m_imsi << params.m_timestamp << params.m_rnti << params.m_layer << params.m_mcs << params.m_size << params.m_rv << params.m_ndi << params.m_correctness);
   NS_LOG_INFO ("Write DL Rx Phy Stats in " << GetDlRxOutputFilename ().c_str ());
 
-  std::ofstream outFile;
-  if ( m_dlRxFirstWrite == true )
+  std::ofstream *outFile = GetOutputStream (GetDlRxOutputFilename (), "% time\tcellId\tIMSI\tRNTI\ttxMode\tlayer\tmcs\tsize\trv\tndi\tcorrect");
+  if (outFile == 0)
     {
-      outFile.open (GetDlRxOutputFilename ().c_str ());
-      if (!outFile.is_open ())
-        {
-          NS_LOG_ERROR ("Can't open file " << GetDlRxOutputFilename ().c_str ());
-          return;
-        }
-      m_dlRxFirstWrite = false;
-      outFile << "% time\tcellId\tIMSI\tRNTI\ttxMode\tlayer\tmcs\tsize\trv\tndi\tcorrect";
-      outFile << std::endl;
+      return;
     }
-  else
+
+  if (IsBinaryOutput ())
     {
-      outFile.open (GetDlRxOutputFilename ().c_str (),  std::ios_base::app);
-      if (!outFile.is_open ())
-        {
-          NS_LOG_ERROR ("Can't open file " << GetDlRxOutputFilename ().c_str ());
-          return;
-        }
+      double fields[] = { (double) params.m_timestamp, (double) params.m_cellId,
+                          (double) params.m_imsi, (double) params.m_rnti, (double) params.m_txMode,
+                          (double) params.m_layer, (double) params.m_mcs, (double) params.m_size,
+                          (double) params.m_rv, (double) params.m_ndi,
+                          (double) params.m_correctness };
+      WriteBinaryRecord (outFile, fields, 11);
+      return;
     }
 
 //   outFile << Simulator::Now ().GetNanoSeconds () / (double) 1e9 << "\t";
-  outFile << params.m_timestamp << "\t";
-  outFile << (uint32_t) params.m_cellId << "\t";
-  outFile << params.m_imsi << "\t";
-  outFile << params.m_rnti << "\t";
-  outFile << (uint32_t) params.m_txMode << "\t";
-  outFile << (uint32_t) params.m_layer << "\t";
-  outFile << (uint32_t) params.m_mcs << "\t";
-  outFile << params.m_size << "\t";
-  outFile << (uint32_t) params.m_rv << "\t";
-  outFile << (uint32_t) params.m_ndi << "\t";
-  outFile << (uint32_t) params.m_correctness << std::endl;
-  outFile.close ();
+  *outFile << params.m_timestamp << "\t";
+  *outFile << (uint32_t) params.m_cellId << "\t";
+  *outFile << params.m_imsi << "\t";
+  *outFile << params.m_rnti << "\t";
+  *outFile << (uint32_t) params.m_txMode << "\t";
+  *outFile << (uint32_t) params.m_layer << "\t";
+  *outFile << (uint32_t) params.m_mcs << "\t";
+  *outFile << params.m_size << "\t";
+  *outFile << (uint32_t) params.m_rv << "\t";
+  *outFile << (uint32_t) params.m_ndi << "\t";
+  *outFile << (uint32_t) params.m_correctness << "\n";
 }
 
 void
@@ -138,41 +129,33 @@ PhyRxStatsCalculator::UlPhyReception (PhyReceptionStatParameters params)
   NS_LOG_FUNCTION (this << params.m_cellId << params.m_imsi << params.m_timestamp << params.m_rnti << params.m_layer << params.m_mcs << params.m_size << params.m_rv << params.m_ndi << params.m_correctness);
   NS_LOG_INFO ("Write UL Rx Phy Stats in " << GetUlRxOutputFilename ().c_str ());
 
-  std::ofstream outFile;
-  if ( m_ulRxFirstWrite == true )
+  std::ofstream *outFile = GetOutputStream (GetUlRxOutputFilename (), "% time\tcellId\tIMSI\tRNTI\tlayer\tmcs\tsize\trv\tndi\tcorrect");
+  if (outFile == 0)
     {
-      outFile.open (GetUlRxOutputFilename ().c_str ());
-      if (!outFile.is_open ())
-        {
-          NS_LOG_ERROR ("Can't open file " << GetUlRxOutputFilename ().c_str ());
-          return;
-        }
-      m_ulRxFirstWrite = false;
-      outFile << "% time\tcellId\tIMSI\tRNTI\tlayer\tmcs\tsize\trv\tndi\tcorrect";
-      outFile << std::endl;
+      return;
     }
-  else
+
+  if (IsBinaryOutput ())
     {
-      outFile.open (GetUlRxOutputFilename ().c_str (),  std::ios_base::app);
-      if (!outFile.is_open ())
-        {
-          NS_LOG_ERROR ("Can't open file " << GetUlRxOutputFilename ().c_str ());
-          return;
-        }
+      double fields[] = { (double) params.m_timestamp, (double) params.m_cellId,
+                          (double) params.m_imsi, (double) params.m_rnti, (double) params.m_layer,
+                          (double) params.m_mcs, (double) params.m_size, (double) params.m_rv,
+                          (double) params.m_ndi, (double) params.m_correctness };
+      WriteBinaryRecord (outFile, fields, 10);
+      return;
     }
 
 //   outFile << Simulator::Now ().GetNanoSeconds () / (double) 1e9 << "\t";
-  outFile << params.m_timestamp << "\t";
-  outFile << (uint32_t) params.m_cellId << "\t";
-  outFile << params.m_imsi << "\t";
-  outFile << params.m_rnti << "\t";
-  outFile << (uint32_t) params.m_layer << "\t";
-  outFile << (uint32_t) params.m_mcs << "\t";
-  outFile << params.m_size << "\t";
-  outFile << (uint32_t) params.m_rv << "\t";
-  outFile << (uint32_t) params.m_ndi << "\t";
-  outFile << (uint32_t) params.m_correctness << std::endl;
-  outFile.close ();
+  *outFile << params.m_timestamp << "\t";
+  *outFile << (uint32_t) params.m_cellId << "\t";
+  *outFile << params.m_imsi << "\t";
+  *outFile << params.m_rnti << "\t";
+  *outFile << (uint32_t) params.m_layer << "\t";
+  *outFile << (uint32_t) params.m_mcs << "\t";
+  *outFile << params.m_size << "\t";
+  *outFile << (uint32_t) params.m_rv << "\t";
+  *outFile << (uint32_t) params.m_ndi << "\t";
+  *outFile << (uint32_t) params.m_correctness << "\n";
 }
 
 void
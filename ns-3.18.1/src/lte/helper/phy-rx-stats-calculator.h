@@ -140,11 +140,6 @@ public:
    */
   static void UlPhyReceptionCallback (Ptr<PhyRxStatsCalculator> phyRxStats,
                                std::string path, PhyReceptionStatParameters params);
-private:
-
-  bool m_dlRxFirstWrite;
-  bool m_ulRxFirstWrite;
-
 };
 
 } // namespace ns3
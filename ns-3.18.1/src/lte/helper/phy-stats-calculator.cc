@@ -22,6 +22,7 @@
 #include "ns3/string.h"
 #include <ns3/simulator.h>
 #include <ns3/log.h>
+#include <vector>
 
 namespace ns3 {
 
@@ -30,9 +31,6 @@ NS_LOG_COMPONENT_DEFINE ("PhyStatsCalculator");
 NS_OBJECT_ENSURE_REGISTERED (PhyStatsCalculator);
 
 PhyStatsCalculator::PhyStatsCalculator ()
-  :  m_RsrpSinrFirstWrite (true),
-    m_UeSinrFirstWrite (true),
-    m_InterferenceFirstWrite (true)
 {
   NS_LOG_FUNCTION (this);
 
@@ -113,36 +111,26 @@ PhyStatsCalculator::ReportCurrentCellRsrpSinr (uint16_t cellId, uint64_t imsi, u
   NS_LOG_FUNCTION (this << cellId <<  imsi << rnti  << rsrp << sinr);
   NS_LOG_INFO ("Write RSRP/SINR Phy Stats in " << GetCurrentCellRsrpSinrFilename ().c_str ());
 
-  std::ofstream outFile;
-  if ( m_RsrpSinrFirstWrite == true )
+  std::ofstream *outFile = GetOutputStream (GetCurrentCellRsrpSinrFilename (), "% time\tcellId\tIMSI\tRNTI\trsrp\tsinr");
+  if (outFile == 0)
     {
-      outFile.open (GetCurrentCellRsrpSinrFilename ().c_str ());
-      if (!outFile.is_open ())
-        {
-          NS_LOG_ERROR ("Can't open file " << GetCurrentCellRsrpSinrFilename ().c_str ());
-          return;
-        }
-      m_RsrpSinrFirstWrite = false;
-      outFile << "% time\tcellId\tIMSI\tRNTI\trsrp\tsinr";
-      outFile << std::endl;
+      return;
     }
-  else
+
+  if (IsBinaryOutput ())
     {
-      outFile.open (GetCurrentCellRsrpSinrFilename ().c_str (),  std::ios_base::app);
-      if (!outFile.is_open ())
-        {
-          NS_LOG_ERROR ("Can't open file " << GetCurrentCellRsrpSinrFilename ().c_str ());
-          return;
-        }
+      double fields[] = { Simulator::Now ().GetSeconds (), (double) cellId, (double) imsi,
+                          (double) rnti, (double) rsrp, (double) sinr };
+      WriteBinaryRecord (outFile, fields, 6);
+      return;
     }
 
-  outFile << Simulator::Now ().GetNanoSeconds () / (double) 1e9 << "\t";
-  outFile << cellId << "\t";
-  outFile << imsi << "\t";
-  outFile << rnti << "\t";
-  outFile << rsrp << "\t";
-  outFile << sinr << std::endl;
-  outFile.close ();
+  *outFile << Simulator::Now ().GetNanoSeconds () / (double) 1e9 << "\t";
+  *outFile << cellId << "\t";
+  *outFile << imsi << "\t";
+  *outFile << rnti << "\t";
+  *outFile << rsrp << "\t";
+  *outFile << sinr << "\n";
 }
 
 void
@@ -151,35 +139,25 @@ PhyStatsCalculator::ReportUeSinr (uint16_t cellId, uint64_t imsi, uint16_t rnti,
   NS_LOG_FUNCTION (this << cellId <<  imsi << rnti  << sinrLinear);
   NS_LOG_INFO ("Write SINR Linear Phy Stats in " << GetUeSinrFilename ().c_str ());
 
-  std::ofstream outFile;
-  if ( m_UeSinrFirstWrite == true )
+  std::ofstream *outFile = GetOutputStream (GetUeSinrFilename (), "% time\tcellId\tIMSI\tRNTI\tsinrLinear");
+  if (outFile == 0)
     {
-      outFile.open (GetUeSinrFilename ().c_str ());
-      if (!outFile.is_open ())
-        {
-          NS_LOG_ERROR ("Can't open file " << GetUeSinrFilename ().c_str ());
-          return;
-        }
-      m_UeSinrFirstWrite = false;
-      outFile << "% time\tcellId\tIMSI\tRNTI\tsinrLinear";
-      outFile << std::endl;
+      return;
     }
-  else
+
+  if (IsBinaryOutput ())
     {
-      outFile.open (GetUeSinrFilename ().c_str (),  std::ios_base::app);
-      if (!outFile.is_open ())
-        {
-          NS_LOG_ERROR ("Can't open file " << GetUeSinrFilename ().c_str ());
-          return;
-        }
+      double fields[] = { Simulator::Now ().GetSeconds (), (double) cellId, (double) imsi,
+                          (double) rnti, (double) sinrLinear };
+      WriteBinaryRecord (outFile, fields, 5);
+      return;
     }
 
-  outFile << Simulator::Now ().GetNanoSeconds () / (double) 1e9 << "\t";
-  outFile << cellId << "\t";
-  outFile << imsi << "\t";
-  outFile << rnti << "\t";
-  outFile << sinrLinear << std::endl;
-  outFile.close ();
+  *outFile << Simulator::Now ().GetNanoSeconds () / (double) 1e9 << "\t";
+  *outFile << cellId << "\t";
+  *outFile << imsi << "\t";
+  *outFile << rnti << "\t";
+  *outFile << sinrLinear << "\n";
 }
 
 void
@@ -188,33 +166,28 @@ PhyStatsCalculator::ReportInterference (uint16_t cellId, Ptr<SpectrumValue> inte
   NS_LOG_FUNCTION (this << cellId <<  interference);
   NS_LOG_INFO ("Write Interference Phy Stats in " << GetInterferenceFilename ().c_str ());
 
-  std::ofstream outFile;
-  if ( m_InterferenceFirstWrite == true )
+  std::ofstream *outFile = GetOutputStream (GetInterferenceFilename (), "% time\tcellId\tInterference");
+  if (outFile == 0)
     {
-      outFile.open (GetInterferenceFilename ().c_str ());
-      if (!outFile.is_open ())
-        {
-          NS_LOG_ERROR ("Can't open file " << GetInterferenceFilename ().c_str ());
-          return;
-        }
-      m_InterferenceFirstWrite = false;
-      outFile << "% time\tcellId\tInterference";
-      outFile << std::endl;
+      return;
     }
-  else
+
+  if (IsBinaryOutput ())
     {
-      outFile.open (GetInterferenceFilename ().c_str (),  std::ios_base::app);
-      if (!outFile.is_open ())
-        {
-          NS_LOG_ERROR ("Can't open file " << GetInterferenceFilename ().c_str ());
-          return;
-        }
+      std::vector<double> fields;
+      fields.push_back (Simulator::Now ().GetSeconds ());
+      fields.push_back (cellId);
+      // getting the first iterator can densify the value, which would
+      // invalidate an iterator obtained before it
+      Values::const_iterator begin = interference->ConstValuesBegin ();
+      fields.insert (fields.end (), begin, interference->ConstValuesEnd ());
+      WriteBinaryRecord (outFile, &fields[0], fields.size ());
+      return;
     }
 
-  outFile << Simulator::Now ().GetNanoSeconds () / (double) 1e9 << "\t";
-  outFile << cellId << "\t";
-  outFile << *interference;
-  outFile.close ();
+  *outFile << Simulator::Now ().GetNanoSeconds () / (double) 1e9 << "\t";
+  *outFile << cellId << "\t";
+  *outFile << *interference;
 }
 
 
@@ -169,10 +169,6 @@ public:
 
 
 private:
-  bool m_RsrpSinrFirstWrite;
-  bool m_UeSinrFirstWrite;
-  bool m_InterferenceFirstWrite;
-
   std::string m_RsrpSinrFilename;
   std::string m_ueSinrFilename;
   std::string m_interferenceFilename;
@@ -32,8 +32,6 @@ NS_LOG_COMPONENT_DEFINE ("PhyTxStatsCalculator");
 NS_OBJECT_ENSURE_REGISTERED (PhyTxStatsCalculator);
 
 PhyTxStatsCalculator::PhyTxStatsCalculator ()
-  : m_dlTxFirstWrite (true),
-    m_ulTxFirstWrite (true)
 {
   NS_LOG_FUNCTION (this);
 
@@ -94,42 +92,33 @@ PhyTxStatsCalculator::DlPhyTransmission (PhyTransmissionStatParameters params)
   NS_LOG_FUNCTION (this << params.m_cellId << params.m_imsi << params.m_timestamp << params.m_rnti << params.m_layer << params.m_mcs << params.m_size << params.m_rv << params.m_ndi);
   NS_LOG_INFO ("Write DL Tx Phy Stats in " << GetDlTxOutputFilename ().c_str ());
 
-  std::ofstream outFile;
-  if ( m_dlTxFirstWrite == true )
+  std::ofstream *outFile = GetOutputStream (GetDlOutputFilename (), "% time\tcellId\tIMSI\tRNTI\tlayer\tmcs\tsize\trv\tndi");
+  if (outFile == 0)
     {
-      outFile.open (GetDlOutputFilename ().c_str ());
-      if (!outFile.is_open ())
-        {
-          NS_LOG_ERROR ("Can't open file " << GetDlTxOutputFilename ().c_str ());
-          return;
-        }
-      m_dlTxFirstWrite = false;
-      //outFile << "% time\tcellId\tIMSI\tRNTI\tlayer\tmcs\tsize\trv\tndi"; // txMode is not available at dl tx side
-      outFile << "% time\tcellId\tIMSI\tRNTI\tlayer\tmcs\tsize\trv\tndi";
-      outFile << std::endl;
+      return;
     }
-  else
+
+  if (IsBinaryOutput ())
     {
-      outFile.open (GetDlTxOutputFilename ().c_str (),  std::ios_base::app);
-      if (!outFile.is_open ())
-        {
-          NS_LOG_ERROR ("Can't open file " << GetDlTxOutputFilename ().c_str ());
-          return;
-        }
+      double fields[] = { (double) params.m_timestamp, (double) params.m_cellId,
+                          (double) params.m_imsi, (double) params.m_rnti, (double) params.m_layer,
+                          (double) params.m_mcs, (double) params.m_size, (double) params.m_rv,
+                          (double) params.m_ndi };
+      WriteBinaryRecord (outFile, fields, 9);
+      return;
     }
 
 //   outFile << Simulator::Now ().GetNanoSeconds () / (double) 1e9 << "\t";
-  outFile << params.m_timestamp << "\t";
-  outFile << (uint32_t) params.m_cellId << "\t";
-  outFile << params.m_imsi << "\t";
-  outFile << params.m_rnti << "\t";
+  *outFile << params.m_timestamp << "\t";
+  *outFile << (uint32_t) params.m_cellId << "\t";
+  *outFile << params.m_imsi << "\t";
+  *outFile << params.m_rnti << "\t";
   //outFile << (uint32_t) params.m_txMode << "\t"; // txMode is not available at dl tx side
-  outFile << (uint32_t) params.m_layer << "\t";
-  outFile << (uint32_t) params.m_mcs << "\t";
-  outFile << params.m_size << "\t";
-  outFile << (uint32_t) params.m_rv << "\t";
-  outFile << (uint32_t) params.m_ndi << std::endl;
-  outFile.close ();
+  *outFile << (uint32_t) params.m_layer << "\t";
+  *outFile << (uint32_t) params.m_mcs << "\t";
+  *outFile << params.m_size << "\t";
+  *outFile << (uint32_t) params.m_rv << "\t";
+  *outFile << (uint32_t) params.m_ndi << "\n";
 }
 
 void
@@ -138,42 +127,33 @@ PhyTxStatsCalculator::UlPhyTransmission (PhyTransmissionStatParameters params)
   NS_LOG_FUNCTION (this << params.m_cellId << params.m_imsi << params.m_timestamp << params.m_rnti << params.m_layer << params.m_mcs << params.m_size << params.m_rv << params.m_ndi);
   NS_LOG_INFO ("Write UL Tx Phy Stats in " << GetUlTxOutputFilename ().c_str ());
 
-  std::ofstream outFile;
-  if ( m_ulTxFirstWrite == true )
+  std::ofstream *outFile = GetOutputStream (GetUlTxOutputFilename (), "% time\tcellId\tIMSI\tRNTI\tlayer\tmcs\tsize\trv\tndi");
+  if (outFile == 0)
     {
-      outFile.open (GetUlTxOutputFilename ().c_str ());
-      if (!outFile.is_open ())
-        {
-          NS_LOG_ERROR ("Can't open file " << GetUlTxOutputFilename ().c_str ());
-          return;
-        }
-      m_ulTxFirstWrite = false;
-//       outFile << "% time\tcellId\tIMSI\tRNTI\ttxMode\tlayer\tmcs\tsize\trv\tndi";
-      outFile << "% time\tcellId\tIMSI\tRNTI\tlayer\tmcs\tsize\trv\tndi";
-      outFile << std::endl;
+      return;
     }
-  else
+
+  if (IsBinaryOutput ())
     {
-      outFile.open (GetUlTxOutputFilename ().c_str (),  std::ios_base::app);
-      if (!outFile.is_open ())
-        {
-          NS_LOG_ERROR ("Can't open file " << GetUlTxOutputFilename ().c_str ());
-          return;
-        }
+      double fields[] = { (double) params.m_timestamp, (double) params.m_cellId,
+                          (double) params.m_imsi, (double) params.m_rnti, (double) params.m_layer,
+                          (double) params.m_mcs, (double) params.m_size, (double) params.m_rv,
+                          (double) params.m_ndi };
+      WriteBinaryRecord (outFile, fields, 9);
+      return;
     }
 
 //   outFile << Simulator::Now ().GetNanoSeconds () / (double) 1e9 << "\t";
-  outFile << params.m_timestamp << "\t";
-  outFile << (uint32_t) params.m_cellId << "\t";
-  outFile << params.m_imsi << "\t";
-  outFile << params.m_rnti << "\t";
+  *outFile << params.m_timestamp << "\t";
+  *outFile << (uint32_t) params.m_cellId << "\t";
+  *outFile << params.m_imsi << "\t";
+  *outFile << params.m_rnti << "\t";
   //outFile << (uint32_t) params.m_txMode << "\t";
-  outFile << (uint32_t) params.m_layer << "\t";
-  outFile << (uint32_t) params.m_mcs << "\t";
-  outFile << params.m_size << "\t";
-  outFile << (uint32_t) params.m_rv << "\t";
-  outFile << (uint32_t) params.m_ndi << std::endl;
-  outFile.close ();
+  *outFile << (uint32_t) params.m_layer << "\t";
+  *outFile << (uint32_t) params.m_mcs << "\t";
+  *outFile << params.m_size << "\t";
+  *outFile << (uint32_t) params.m_rv << "\t";
+  *outFile << (uint32_t) params.m_ndi << "\n";
 }
 
 void
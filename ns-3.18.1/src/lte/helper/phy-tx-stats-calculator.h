@@ -141,12 +141,6 @@ public:
    */
   static void UlPhyTransmissionCallback (Ptr<PhyTxStatsCalculator> phyTxStats,
                                   std::string path, PhyTransmissionStatParameters params);
-
-private:
-
-  bool m_dlTxFirstWrite;
-  bool m_ulTxFirstWrite;
-
 };
 
 } // namespace ns3
@@ -102,6 +102,7 @@ RadioBearerStatsCalculator::DoDispose ()
     {
       ShowResults ();
     }
+  LteStatsCalculator::DoDispose ();
 }
 
 void 
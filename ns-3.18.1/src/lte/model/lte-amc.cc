@@ -26,6 +26,7 @@
 #include <ns3/assert.h>
 #include <ns3/math.h>
 #include <vector>
+#include <algorithm>
 #include <ns3/spectrum-value.h>
 #include <ns3/double.h>
 #include "ns3/enum.h"
@@ -205,6 +206,7 @@ int TransportBlockSizeTable [110][27] = {
 
 
 LteAmc::LteAmc ()
+  : m_thresholdBer (-1.0)
 {
 }
 
@@ -220,10 +222,11 @@ LteAmc::GetTypeId (void)
   .SetParent<Object> ()
   .AddConstructor<LteAmc> ()
   .AddAttribute ("Ber",
-                 "The requested BER in assigning MCS (default is 0.00005).",
+                 "The requested BER in assigning MCS (default is 0.00005).  The PiroEW2010 "
+                 "model needs -ln(5*BER) >= 0, hence BER is in [0, 0.2].",
                  DoubleValue (0.00005),
                  MakeDoubleAccessor (&LteAmc::m_ber),
-                 MakeDoubleChecker<double> ())
+                 MakeDoubleChecker<double> (0.0, 0.2))
   .AddAttribute ("AmcModel",
                 "AMC model used to assign CQI",
                  EnumValue (LteAmc::MiErrorModel),
@@ -239,11 +242,9 @@ LteAmc::GetCqiFromSpectralEfficiency (double s)
 {
   NS_LOG_FUNCTION (s);
   NS_ASSERT_MSG (s >= 0.0, "negative spectral efficiency = " << s);
-  int cqi = 0;
-  while ((cqi < 15) && (SpectralEfficiencyForCqi[cqi + 1] < s))
-    {
-      ++cqi;
-    }
+  // number of CQIs (besides 0) whose spectral efficiency is lower than s
+  int cqi = std::lower_bound (SpectralEfficiencyForCqi + 1, SpectralEfficiencyForCqi + 16, s)
+    - (SpectralEfficiencyForCqi + 1);
   NS_LOG_LOGIC ("cqi = " << cqi);
   return cqi;
 }
@@ -255,11 +256,9 @@ LteAmc::GetMcsFromCqi (int cqi)
   NS_LOG_FUNCTION (cqi);
   NS_ASSERT_MSG (cqi >= 0 && cqi <= 15, "CQI must be in [0..15] = " << cqi);
   double spectralEfficiency = SpectralEfficiencyForCqi[cqi];
-  int mcs = 0;
-  while ((mcs < 28) && (SpectralEfficiencyForMcs[mcs + 1] <= spectralEfficiency))
-    {
-      ++mcs;
-    }
+  // number of MCSs (besides 0, up to 28) whose spectral efficiency is not higher
+  int mcs = std::upper_bound (SpectralEfficiencyForMcs + 1, SpectralEfficiencyForMcs + 29, spectralEfficiency)
+    - (SpectralEfficiencyForMcs + 1);
   NS_LOG_LOGIC ("mcs = " << mcs);
   return mcs;
 }
@@ -287,16 +286,42 @@ LteAmc::GetSpectralEfficiencyFromCqi (int cqi)
 }
 
 
+void
+LteAmc::UpdateSinrThresholds (void)
+{
+  if (m_thresholdBer == m_ber)
+    {
+      return;
+    }
+  NS_LOG_FUNCTION (this << m_ber);
+  /*
+   * The spectral efficiency of the SINR is higher than the one of a CQI iff
+   *   SINR > (2 ^ spectralEfficiency - 1) * (-ln(5*BER)/1.5)
+   */
+  double gamma = (-std::log (5.0 * m_ber)) / 1.5;
+  m_sinrThresholds.resize (15);
+  for (int cqi = 1; cqi <= 15; cqi++)
+    {
+      m_sinrThresholds[cqi - 1] = (std::pow (2.0, SpectralEfficiencyForCqi[cqi]) - 1) * gamma;
+    }
+  m_thresholdBer = m_ber;
+}
+
+
 std::vector<int>
 LteAmc::CreateCqiFeedbacks (const SpectrumValue& sinr, uint8_t rbgSize)
 {
   NS_LOG_FUNCTION (this);
 
   std::vector<int> cqi;
+  cqi.reserve (sinr.GetSpectrumModel ()->GetNumBands ());
   Values::const_iterator it;
   
   if (m_amcModel == PiroEW2010)
     {
+      UpdateSinrThresholds ();
+      std::vector<double>::const_iterator thresholdsBegin = m_sinrThresholds.begin ();
+      std::vector<double>::const_iterator thresholdsEnd = m_sinrThresholds.end ();
 
       for (it = sinr.ConstValuesBegin (); it != sinr.ConstValuesEnd (); it++)
         {
@@ -313,16 +338,18 @@ LteAmc::CreateCqiFeedbacks (const SpectrumValue& sinr, uint8_t rbgSize)
               * spectralEfficiency = log2 (1 + -------------------- )
               *                                    -ln(5*BER)/1.5
               * NB: SINR must be expressed in linear units
+              *
+              * The CQI is the number of CQIs whose spectral efficiency is
+              * lower, found by comparing the SINR with the precomputed
+              * SINR thresholds of the CQIs.
               */
 
-              double s = log2 ( 1 + ( sinr_ / ( (-std::log (5.0 * m_ber )) / 1.5) ));
-
-              int cqi_ = GetCqiFromSpectralEfficiency (s);
+              int cqi_ = std::lower_bound (thresholdsBegin, thresholdsEnd, sinr_) - thresholdsBegin;
 
               NS_LOG_LOGIC (" PRB =" << cqi.size ()
                                     << ", sinr = " << sinr_
                                     << " (=" << 10 * std::log10 (sinr_) << " dB)"
-                                    << ", spectral efficiency =" << s
+                                    << ", spectral efficiency =" << log2 ( 1 + ( sinr_ / ( (-std::log (5.0 * m_ber )) / 1.5) ))
                                     << ", CQI = " << cqi_ << ", BER = " << m_ber);
 
               cqi.push_back (cqi_);
@@ -369,12 +396,7 @@ LteAmc::CreateCqiFeedbacks (const SpectrumValue& sinr, uint8_t rbgSize)
               }
             else
               {
-                double s = SpectralEfficiencyForMcs[mcs];
-                rbgCqi = 0;
-                while ((rbgCqi < 15) && (SpectralEfficiencyForCqi[rbgCqi + 1] < s))
-                {
-                  ++rbgCqi;
-                }
+                rbgCqi = GetCqiFromSpectralEfficiency (SpectralEfficiencyForMcs[mcs]);
               }
             NS_LOG_DEBUG (this << "\t MCS " << (uint16_t)mcs << "-> CQI " << rbgCqi);
             // fill the cqi vector (per RB basis)
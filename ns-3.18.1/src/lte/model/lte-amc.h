@@ -100,10 +100,24 @@ public:
   /*static*/ int GetCqiFromSpectralEfficiency (double s);
   
 private:
+  /**
+   * \brief Compute the SINR thresholds of the CQIs for the current BER,
+   * if they have not been computed yet
+   */
+  void UpdateSinrThresholds (void);
   
   double m_ber;
   AmcModel m_amcModel;
 
+  /// BER used to compute m_sinrThresholds
+  double m_thresholdBer;
+  /**
+   * Minimum SINR (in linear units) of the CQIs 1 to 15 for the
+   * PiroEW2010 model, i.e., the SINR whose spectral efficiency is the
+   * one of the CQI
+   */
+  std::vector<double> m_sinrThresholds;
+
 
 
 };
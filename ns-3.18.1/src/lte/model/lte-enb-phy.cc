@@ -38,6 +38,8 @@
 #include "lte-enb-mac.h"
 #include <ns3/lte-common.h>
 #include <ns3/lte-vendor-specific-parameters.h>
+#include <ns3/simulation-singleton.h>
+#include "lte-tti-driver.h"
 
 // WILD HACK for the inizialization of direct eNB-UE ctrl messaging
 #include <ns3/node-list.h>
@@ -665,9 +667,16 @@ LteEnbPhy::StartSubFrame (void)
   // trigger the MAC
   m_enbPhySapUser->SubframeIndication (m_nrFrames, m_nrSubFrames);
 
-  Simulator::Schedule (Seconds (GetTti ()),
-                       &LteEnbPhy::EndSubFrame,
-                       this);
+  if (m_aggregateSubframeEvents)
+    {
+      SimulationSingleton<LteTtiDriver>::Get ()->ScheduleEnbEndSubframe (Seconds (GetTti ()), this);
+    }
+  else
+    {
+      Simulator::Schedule (Seconds (GetTti ()),
+                           &LteEnbPhy::EndSubFrame,
+                           this);
+    }
 
 }
 
@@ -31,6 +31,7 @@
 
 
 #include <list>
+#include <algorithm>
 #include <vector>
 #include <ns3/log.h>
 #include <ns3/pointer.h>
@@ -321,6 +322,29 @@ double cEcrTable [9][38] = {
 };
 
 
+/**
+ * \brief Look up the MI of a SINR value in a MI map
+ *
+ * The axis of the map is sorted, so the first SINR of the axis not
+ * smaller than the value is found by binary search.
+ * \param axis the SINR axis of the map
+ * \param map the MI values of the map
+ * \param size the number of values of the map
+ * \param sinrLin the SINR, in linear units
+ * \return the MI
+ */
+static double
+MiFromMap (const double *axis, const double *map, int size, double sinrLin)
+{
+  if (sinrLin > axis[size - 1])
+    {
+      return 1;
+    }
+  int tr = std::lower_bound (axis, axis + size, sinrLin) - axis;
+  NS_ASSERT_MSG (tr < size, "MI map out of data");
+  return map[tr];
+}
+
 double 
 LteMiErrorModel::Mib (const SpectrumValue& sinr, const std::vector<int>& map, uint8_t mcs)
 {
@@ -328,66 +352,24 @@ LteMiErrorModel::Mib (const SpectrumValue& sinr, const std::vector<int>& map, ui
   
   double MI;
   double MIsum = 0.0;
+  Values::const_iterator values = sinr.ConstValuesBegin ();
   
   for (uint32_t i = 0; i < map.size (); i++)
     {
-      SpectrumValue sinrCopy = sinr;
-      double sinrLin = sinrCopy[map.at (i)];
+      double sinrLin = values[map[i]];
       if (mcs <= MI_QPSK_MAX_ID) // QPSK
         {
-          int tr = 0;
-          while ((tr<MI_MAP_QPSK_SIZE)&&(MI_map_qpsk_axis[tr] < sinrLin))
-            {
-              tr++;
-            }
-          if (sinrLin > MI_map_qpsk_axis[MI_MAP_QPSK_SIZE-1])
-            {
-              MI = 1;
-            }
-          else 
-            {
-              NS_ASSERT_MSG (tr<MI_MAP_QPSK_SIZE, "MI map out of data");
-              MI = MI_map_qpsk[tr];
-            }
+          MI = MiFromMap (MI_map_qpsk_axis, MI_map_qpsk, MI_MAP_QPSK_SIZE, sinrLin);
         }
-      else
+      else if (mcs <= MI_16QAM_MAX_ID) // 16-QAM
         {
-          if (mcs > MI_QPSK_MAX_ID && mcs <= MI_16QAM_MAX_ID )	// 16-QAM
-            {
-              int tr = 0;
-              while ((tr<MI_MAP_16QAM_SIZE)&&(MI_map_16qam_axis[tr] < sinrLin))
-                {
-                  tr++;
-                }
-              if (sinrLin > MI_map_16qam_axis[MI_MAP_16QAM_SIZE-1])
-                {
-                  MI = 1;
-                }
-              else 
-                {
-                  NS_ASSERT_MSG (tr<MI_MAP_16QAM_SIZE, "MI map out of data");
-                  MI = MI_map_16qam[tr];
-                }
-            }
-          else // 64-QAM
-            {
-              int tr = 0;
-              while ((tr<MI_MAP_64QAM_SIZE)&&(MI_map_64qam_axis[tr] < sinrLin))
-                {
-                  tr++;
-                }
-              if (sinrLin > MI_map_64qam_axis[MI_MAP_64QAM_SIZE-1])
-                {
-                  MI = 1;
-                }
-              else
-                {
-                  NS_ASSERT_MSG (tr<MI_MAP_64QAM_SIZE, "MI map out of data");
-                  MI = MI_map_64qam[tr];
-                }
-            }
+          MI = MiFromMap (MI_map_16qam_axis, MI_map_16qam, MI_MAP_16QAM_SIZE, sinrLin);
+        }
+      else // 64-QAM
+        {
+          MI = MiFromMap (MI_map_64qam_axis, MI_map_64qam, MI_MAP_64QAM_SIZE, sinrLin);
         }
-      NS_LOG_LOGIC (" RB " << map.at (i) << "Minimum SNR = " << 10 * std::log10 (sinrLin) << " dB, " << sinrLin << " V, MCS = " << (uint16_t)mcs << ", MI = " << MI);
+      NS_LOG_LOGIC (" RB " << map[i] << "Minimum SNR = " << 10 * std::log10 (sinrLin) << " dB, " << sinrLin << " V, MCS = " << (uint16_t)mcs << ", MI = " << MI);
       MIsum += MI;
     }
   MI = MIsum / map.size ();
@@ -24,6 +24,7 @@
 #include <ns3/log.h>
 #include <cmath>
 #include <ns3/simulator.h>
+#include <ns3/boolean.h>
 #include "ns3/spectrum-error-model.h"
 #include "lte-phy.h"
 #include "lte-net-device.h"
@@ -50,7 +51,8 @@ LtePhy::LtePhy (Ptr<LteSpectrumPhy> dlPhy, Ptr<LteSpectrumPhy> ulPhy)
     m_dlBandwidth (0),
     m_rbgSize (0),
     m_macChTtiDelay (0),
-    m_cellId (0)
+    m_cellId (0),
+    m_aggregateSubframeEvents (false)
 {
   NS_LOG_FUNCTION (this);
 }
@@ -61,6 +63,17 @@ LtePhy::GetTypeId (void)
 {
   static TypeId tid = TypeId ("ns3::LtePhy")
     .SetParent<Object> ()
+    .AddAttribute ("AggregateSubframeEvents",
+                   "If true, the subframes of this PHY are driven by the "
+                   "LteTtiDriver, which runs the PHYs registered in the same "
+                   "context with a single event per TTI, in that context, "
+                   "instead of by events of their own. An event of another "
+                   "object due at the same time as the subframe, and "
+                   "scheduled between the registrations of two of these PHYs, "
+                   "runs after them instead of between them.",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&LtePhy::m_aggregateSubframeEvents),
+                   MakeBooleanChecker ())
   ;
   return tid;
 }
@@ -241,6 +241,8 @@ protected:
 
   uint16_t m_cellId;
 
+  bool m_aggregateSubframeEvents; // use the LteTtiDriver instead of one event per subframe
+
 };
 
 
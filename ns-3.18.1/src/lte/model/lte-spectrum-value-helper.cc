@@ -21,6 +21,7 @@
 
 #include <map>
 #include <cmath>
+#include <algorithm>
 
 #include <ns3/log.h>
 #include <ns3/fatal-error.h>
@@ -237,7 +238,18 @@ LteSpectrumValueHelper::CreateTxPowerSpectralDensity (uint16_t earfcn, uint8_t t
   NS_LOG_FUNCTION (earfcn << (uint16_t) txBandwidthConfiguration << powerTx << activeRbs);
 
   Ptr<SpectrumModel> model = GetSpectrumModel (earfcn, txBandwidthConfiguration);
-  Ptr<SpectrumValue> txPsd = Create <SpectrumValue> (model);
+  Ptr<SpectrumValue> txPsd;
+  if (activeRbs.empty ())
+    {
+      txPsd = Create <SpectrumValue> (model);
+    }
+  else
+    {
+      // only store the range of the active RBs, the PSD is zero elsewhere
+      int firstRb = *std::min_element (activeRbs.begin (), activeRbs.end ());
+      int lastRb = *std::max_element (activeRbs.begin (), activeRbs.end ());
+      txPsd = Create <SpectrumValue> (model, firstRb, lastRb);
+    }
 
   // powerTx is expressed in dBm. We must convert it into natural unit.
   double powerTxW = std::pow (10., (powerTx - 30) / 10);
@@ -0,0 +1,116 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "lte-tti-driver.h"
+#include "lte-ue-phy.h"
+#include "lte-enb-phy.h"
+#include <ns3/simulator.h>
+#include <ns3/log.h>
+
+NS_LOG_COMPONENT_DEFINE ("LteTtiDriver");
+
+namespace ns3 {
+
+LteTtiDriver::LteTtiDriver ()
+  : m_currentIndex (0)
+{
+  NS_LOG_FUNCTION (this);
+}
+
+void
+LteTtiDriver::ScheduleUeSubframe (Time delay, LteUePhy *phy, uint32_t frameNo, uint32_t subframeNo)
+{
+  NS_LOG_FUNCTION (this << delay << phy << frameNo << subframeNo);
+  Entry entry;
+  entry.uePhy = phy;
+  entry.enbPhy = 0;
+  entry.frameNo = frameNo;
+  entry.subframeNo = subframeNo;
+  entry.context = Simulator::GetContext ();
+  if (!Add (delay, entry))
+    {
+      Simulator::Schedule (delay, &LteUePhy::SubframeIndication, phy, frameNo, subframeNo);
+    }
+}
+
+void
+LteTtiDriver::ScheduleEnbEndSubframe (Time delay, LteEnbPhy *phy)
+{
+  NS_LOG_FUNCTION (this << delay << phy);
+  Entry entry;
+  entry.uePhy = 0;
+  entry.enbPhy = phy;
+  entry.frameNo = 0;
+  entry.subframeNo = 0;
+  entry.context = Simulator::GetContext ();
+  if (!Add (delay, entry))
+    {
+      Simulator::Schedule (delay, &LteEnbPhy::EndSubFrame, phy);
+    }
+}
+
+bool
+LteTtiDriver::Add (Time delay, const Entry &entry)
+{
+  Time t = Simulator::Now () + delay;
+  if (m_next.empty ())
+    {
+      m_nextTime = t;
+    }
+  else if (t != m_nextTime)
+    {
+      // PHYs with different TTIs: keep their own events
+      return false;
+    }
+  // one event for each run of PHYs registered in the same context, in
+  // that context, where the event of the first of them would have been
+  if (m_next.empty () || m_next.back ().context != entry.context)
+    {
+      Simulator::ScheduleWithContext (entry.context, delay, &LteTtiDriver::Subframe, this);
+    }
+  m_next.push_back (entry);
+  return true;
+}
+
+void
+LteTtiDriver::Subframe (void)
+{
+  NS_LOG_FUNCTION (this << m_next.size ());
+  if (m_currentIndex == m_current.size ())
+    {
+      // first event of this TTI; the PHYs register their next subframe
+      // while they run
+      m_current.clear ();
+      m_current.swap (m_next);
+      m_currentIndex = 0;
+    }
+  uint32_t context = m_current[m_currentIndex].context;
+  NS_ASSERT (context == Simulator::GetContext ());
+  while (m_currentIndex < m_current.size () && m_current[m_currentIndex].context == context)
+    {
+      const Entry &entry = m_current[m_currentIndex++];
+      if (entry.uePhy != 0)
+        {
+          entry.uePhy->SubframeIndication (entry.frameNo, entry.subframeNo);
+        }
+      else
+        {
+          entry.enbPhy->EndSubFrame ();
+        }
+    }
+}
+
+} // namespace ns3
@@ -0,0 +1,97 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef LTE_TTI_DRIVER_H
+#define LTE_TTI_DRIVER_H
+
+#include <ns3/nstime.h>
+#include <vector>
+
+namespace ns3 {
+
+class LteUePhy;
+class LteEnbPhy;
+
+/**
+ * \ingroup lte
+ *
+ * Drives the subframes of all the LTE PHYs of a simulation with a
+ * single event per TTI.
+ *
+ * Without it, every LteUePhy and every LteEnbPhy schedules its own event
+ * at the start of each subframe. With it, the PHYs register the start of
+ * their next subframe here instead, and the PHYs registered for a given
+ * time are run in the order in which they registered, by one event for
+ * each run of consecutive PHYs that registered in the same context.
+ * That event is scheduled, in that context, when the first PHY of the
+ * run registers, so each PHY runs in the context its own event would
+ * have had. The PHYs created by the helpers before the simulation
+ * starts all share the same context, so they are run by a single event
+ * per TTI.
+ *
+ * An event of another object due at the same time as a subframe, and
+ * scheduled between the registrations of two PHYs of the same run, runs
+ * after these PHYs instead of between them.
+ *
+ * A PHY uses the driver if its AggregateSubframeEvents attribute is
+ * true. The driver is a SimulationSingleton and is deleted by
+ * Simulator::Destroy.
+ */
+class LteTtiDriver
+{
+public:
+  LteTtiDriver ();
+
+  /**
+   * Runs LteUePhy::SubframeIndication (frameNo, subframeNo) of the given
+   * PHY after the given delay.
+   */
+  void ScheduleUeSubframe (Time delay, LteUePhy *phy, uint32_t frameNo, uint32_t subframeNo);
+  /**
+   * Runs LteEnbPhy::EndSubFrame of the given PHY after the given delay.
+   */
+  void ScheduleEnbEndSubframe (Time delay, LteEnbPhy *phy);
+
+private:
+  /// A PHY registered for the next subframe
+  struct Entry
+  {
+    LteUePhy *uePhy;
+    LteEnbPhy *enbPhy;
+    uint32_t frameNo;
+    uint32_t subframeNo;
+    uint32_t context; ///< the context in which the PHY registered
+  };
+
+  /**
+   * Adds an entry for the given time, scheduling a subframe event if it
+   * is the first one or if its context differs from the previous one.
+   * \return false if another subframe event is pending for a different
+   * time, in which case the entry is not added
+   */
+  bool Add (Time delay, const Entry &entry);
+  /// Runs the next PHYs registered for the current time in the current context
+  void Subframe (void);
+
+  std::vector<Entry> m_next;
+  std::vector<Entry> m_current;
+  uint32_t m_currentIndex; ///< the next entry of m_current to run
+  Time m_nextTime;
+};
+
+} // namespace ns3
+
+#endif /* LTE_TTI_DRIVER_H */
@@ -38,6 +38,8 @@
 #include "lte-sinr-chunk-processor.h"
 #include <ns3/lte-common.h>
 #include <ns3/pointer.h>
+#include <ns3/simulation-singleton.h>
+#include "lte-tti-driver.h"
 
 NS_LOG_COMPONENT_DEFINE ("LteUePhy");
 
@@ -953,7 +955,14 @@ LteUePhy::SubframeIndication (uint32_t frameNo, uint32_t subframeNo)
     }
   
   // schedule next subframe indication
-  Simulator::Schedule (Seconds (GetTti ()), &LteUePhy::SubframeIndication, this, frameNo, subframeNo);  
+  if (m_aggregateSubframeEvents)
+    {
+      SimulationSingleton<LteTtiDriver>::Get ()->ScheduleUeSubframe (Seconds (GetTti ()), this, frameNo, subframeNo);
+    }
+  else
+    {
+      Simulator::Schedule (Seconds (GetTti ()), &LteUePhy::SubframeIndication, this, frameNo, subframeNo);
+    }
 }
   
 void
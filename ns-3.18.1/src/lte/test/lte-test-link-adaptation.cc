@@ -24,12 +24,16 @@
 #include "ns3/double.h"
 #include "ns3/boolean.h"
 #include <ns3/enum.h>
+#include <cmath>
 
 #include "ns3/mobility-helper.h"
 #include "ns3/lte-helper.h"
 
 #include "ns3/lte-ue-phy.h"
 #include "ns3/lte-ue-net-device.h"
+#include "ns3/lte-amc.h"
+#include "ns3/lte-mi-error-model.h"
+#include "ns3/spectrum-value.h"
 
 #include "lte-test-link-adaptation.h"
 
@@ -39,6 +43,14 @@ NS_LOG_COMPONENT_DEFINE ("LteLinkAdaptationTest");
 
 namespace ns3 {
 
+// the MI maps of lte-mi-error-model.cc
+extern double MI_map_qpsk[MI_MAP_QPSK_SIZE];
+extern double MI_map_qpsk_axis[MI_MAP_QPSK_SIZE];
+extern double MI_map_16qam[MI_MAP_16QAM_SIZE];
+extern double MI_map_16qam_axis[MI_MAP_16QAM_SIZE];
+extern double MI_map_64qam[MI_MAP_64QAM_SIZE];
+extern double MI_map_64qam_axis[MI_MAP_64QAM_SIZE];
+
 
 /**
  * Test 1.3 Link Adaptation
@@ -127,6 +139,7 @@ LteLinkAdaptationTestSuite::LteLinkAdaptationTestSuite ()
       AddTestCase (new LteLinkAdaptationTestCase (name.str (),  snrEfficiencyMcs[i].snrDb, lossDb, snrEfficiencyMcs[i].mcsIndex), TestCase::QUICK);
     }
 
+  AddTestCase (new LteAmcCqiSweepTestCase, TestCase::QUICK);
 }
 
 static LteLinkAdaptationTestSuite lteLinkAdaptationTestSuite;
@@ -245,5 +258,87 @@ LteLinkAdaptationTestCase::DlScheduling (uint32_t frameNo, uint32_t subframeNo,
     }
 }
 
-} // namespace ns3
 
+/**
+ * TestCase
+ */
+
+LteAmcCqiSweepTestCase::LteAmcCqiSweepTestCase ()
+  : TestCase ("CQI and MI of a SINR sweep by binary search and by linear scan")
+{
+}
+
+LteAmcCqiSweepTestCase::~LteAmcCqiSweepTestCase ()
+{
+}
+
+void
+LteAmcCqiSweepTestCase::DoRun (void)
+{
+  Ptr<LteAmc> amc = CreateObject<LteAmc> ();
+  amc->SetAttribute ("AmcModel", EnumValue (LteAmc::PiroEW2010));
+
+  // one RB per SINR value, from -20 dB to 40 dB by 0.01 dB
+  std::vector<double> sinrDb;
+  std::vector<double> centerFreqs;
+  for (int i = -2000; i <= 4000; i++)
+    {
+      sinrDb.push_back (i / 100.0);
+      centerFreqs.push_back (2.1e9 + 180e3 * centerFreqs.size ());
+    }
+  Ptr<SpectrumModel> model = Create<SpectrumModel> (centerFreqs);
+  SpectrumValue sinr (model);
+  for (uint32_t i = 0; i < sinrDb.size (); i++)
+    {
+      sinr[i] = std::pow (10.0, sinrDb[i] / 10.0);
+    }
+
+  double bers[] = { 0.0, 0.00005, 0.001, 0.01, 0.1, 0.2 };
+  for (uint32_t b = 0; b < sizeof (bers) / sizeof (bers[0]); b++)
+    {
+      amc->SetAttribute ("Ber", DoubleValue (bers[b]));
+      std::vector<int> cqis = amc->CreateCqiFeedbacks (sinr);
+      NS_TEST_ASSERT_MSG_EQ (cqis.size (), sinrDb.size (), "Wrong number of CQIs");
+
+      for (uint32_t i = 0; i < sinrDb.size (); i++)
+        {
+          // ln(1/(5*BER)) rather than -ln(5*BER), so that gamma is +0 for a BER of 0.2
+          double s = log2 (1 + (sinr[i] / (std::log (1.0 / (5.0 * bers[b])) / 1.5)));
+          int cqi = 0;
+          while ((cqi < 15) && (amc->GetSpectralEfficiencyFromCqi (cqi + 1) < s))
+            {
+              ++cqi;
+            }
+          NS_TEST_ASSERT_MSG_EQ (cqis[i], cqi, "Wrong CQI for SINR " << sinrDb[i] << " dB and BER " << bers[b]);
+          NS_TEST_ASSERT_MSG_EQ (amc->GetCqiFromSpectralEfficiency (s), cqi,
+                                 "Wrong CQI for spectral efficiency " << s);
+        }
+    }
+
+  // MI of each RB, for an MCS of each modulation
+  uint8_t mcss[] = { 0, 12, 24 };
+  const double *maps[] = { MI_map_qpsk, MI_map_16qam, MI_map_64qam };
+  const double *axes[] = { MI_map_qpsk_axis, MI_map_16qam_axis, MI_map_64qam_axis };
+  int sizes[] = { MI_MAP_QPSK_SIZE, MI_MAP_16QAM_SIZE, MI_MAP_64QAM_SIZE };
+  for (uint32_t m = 0; m < 3; m++)
+    {
+      for (uint32_t i = 0; i < sinrDb.size (); i++)
+        {
+          int tr = 0;
+          while ((tr < sizes[m]) && (axes[m][tr] < sinr[i]))
+            {
+              tr++;
+            }
+          double mi = (tr < sizes[m]) ? maps[m][tr] : 1;
+          std::vector<int> rb (1, i);
+          NS_TEST_ASSERT_MSG_EQ (LteMiErrorModel::Mib (sinr, rb, mcss[m]), mi,
+                                 "Wrong MI for SINR " << sinrDb[i] << " dB and MCS " << (uint16_t) mcss[m]);
+        }
+    }
+
+  // the SINR thresholds are only sorted for BERs up to 0.2
+  NS_TEST_EXPECT_MSG_EQ (amc->SetAttributeFailSafe ("Ber", DoubleValue (0.3)), false, "BER above 0.2 accepted");
+  NS_TEST_EXPECT_MSG_EQ (amc->SetAttributeFailSafe ("Ber", DoubleValue (-0.1)), false, "Negative BER accepted");
+}
+
+} // namespace ns3
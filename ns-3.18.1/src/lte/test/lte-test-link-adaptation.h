@@ -56,6 +56,22 @@ private:
 };
 
 
+/**
+ * Checks that the CQIs that LteAmc finds by binary search on the SINR
+ * thresholds and on the spectral efficiency tables are the ones of a
+ * linear scan, over a sweep of SINR values and BERs.
+ */
+class LteAmcCqiSweepTestCase : public TestCase
+{
+public:
+  LteAmcCqiSweepTestCase ();
+  virtual ~LteAmcCqiSweepTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+
 } // namespace ns3
 
 
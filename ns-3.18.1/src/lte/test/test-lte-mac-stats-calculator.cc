@@ -0,0 +1,184 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <unistd.h>
+#include "ns3/simulator.h"
+#include "ns3/log.h"
+#include "ns3/string.h"
+#include "ns3/nstime.h"
+#include "ns3/test.h"
+#include "ns3/mac-stats-calculator.h"
+
+NS_LOG_COMPONENT_DEFINE ("LteMacStatsCalculatorTest");
+
+namespace ns3 {
+
+/**
+ * Checks the records that MacStatsCalculator writes when AggregationEpoch
+ * is set: one record per UE and per epoch, including the epoch in
+ * progress when the simulation ends.
+ */
+class LteMacStatsAggregationTestCase : public TestCase
+{
+public:
+  /**
+   * \param name the name of the test case
+   * \param epoch the aggregation epoch
+   * \param times the times of the DL transport blocks of the UE
+   * \param expected the expected DL records, without the heading
+   * \param dispose if true, the calculator is disposed before the file is
+   * read, otherwise the file is read after Simulator::Destroy
+   */
+  LteMacStatsAggregationTestCase (std::string name, Time epoch, std::vector<Time> times,
+                                  std::vector<std::string> expected, bool dispose);
+  virtual ~LteMacStatsAggregationTestCase ();
+
+private:
+  virtual void DoRun (void);
+  static void DlScheduling (Ptr<MacStatsCalculator> macStats);
+  static std::vector<std::string> ReadRecords (std::string fileName);
+
+  Time m_epoch;
+  std::vector<Time> m_times;
+  std::vector<std::string> m_expected;
+  bool m_dispose;
+};
+
+LteMacStatsAggregationTestCase::LteMacStatsAggregationTestCase (std::string name, Time epoch,
+                                                                std::vector<Time> times,
+                                                                std::vector<std::string> expected,
+                                                                bool dispose)
+  : TestCase (name),
+    m_epoch (epoch),
+    m_times (times),
+    m_expected (expected),
+    m_dispose (dispose)
+{
+}
+
+LteMacStatsAggregationTestCase::~LteMacStatsAggregationTestCase ()
+{
+}
+
+void
+LteMacStatsAggregationTestCase::DlScheduling (Ptr<MacStatsCalculator> macStats)
+{
+  // cellId 1, IMSI 7, RNTI 3, one 100 byte transport block of MCS 10
+  macStats->DlScheduling (1, 7, 0, 0, 3, 10, 100, 0, 0);
+}
+
+std::vector<std::string>
+LteMacStatsAggregationTestCase::ReadRecords (std::string fileName)
+{
+  std::vector<std::string> records;
+  std::ifstream in (fileName.c_str ());
+  std::string line;
+  while (std::getline (in, line))
+    {
+      if (!line.empty () && line[0] != '%')
+        {
+          records.push_back (line);
+        }
+    }
+  return records;
+}
+
+void
+LteMacStatsAggregationTestCase::DoRun (void)
+{
+  std::string dlFileName = "lte-test-mac-stats-dl.txt";
+  std::string ulFileName = "lte-test-mac-stats-ul.txt";
+  Ptr<MacStatsCalculator> macStats = CreateObject<MacStatsCalculator> ();
+  macStats->SetAttribute ("DlOutputFilename", StringValue (dlFileName));
+  macStats->SetAttribute ("UlOutputFilename", StringValue (ulFileName));
+  macStats->SetAttribute ("AggregationEpoch", TimeValue (m_epoch));
+
+  for (std::vector<Time>::const_iterator it = m_times.begin (); it != m_times.end (); ++it)
+    {
+      Simulator::Schedule (*it, &LteMacStatsAggregationTestCase::DlScheduling, macStats);
+    }
+  Simulator::Stop (m_times.back () + MilliSeconds (1));
+  Simulator::Run ();
+
+  std::vector<std::string> records;
+  if (m_dispose)
+    {
+      macStats->Dispose ();
+      records = ReadRecords (dlFileName);
+      Simulator::Destroy ();
+    }
+  else
+    {
+      Simulator::Destroy ();
+      records = ReadRecords (dlFileName);
+    }
+
+  NS_TEST_ASSERT_MSG_EQ (records.size (), m_expected.size (), "Wrong number of aggregated records");
+  for (uint32_t i = 0; i < records.size (); ++i)
+    {
+      NS_TEST_EXPECT_MSG_EQ (records[i], m_expected[i], "Wrong aggregated record " << i);
+    }
+  macStats->Dispose ();
+  unlink (dlFileName.c_str ());
+  unlink (ulFileName.c_str ());
+}
+
+
+static class LteMacStatsCalculatorTestSuite : public TestSuite
+{
+public:
+  LteMacStatsCalculatorTestSuite ();
+} g_lteMacStatsCalculatorTestSuite;
+
+LteMacStatsCalculatorTestSuite::LteMacStatsCalculatorTestSuite ()
+  : TestSuite ("lte-mac-stats-calculator", UNIT)
+{
+  // time, cellId, IMSI, RNTI, nTb, mcsTb1, sizeTb1, mcsTb2, sizeTb2
+  std::vector<Time> times;
+  std::vector<std::string> expected;
+  times.push_back (MilliSeconds (100));
+  times.push_back (MilliSeconds (200));
+  expected.push_back ("1\t1\t7\t3\t2\t10\t200\t0\t0");
+  AddTestCase (new LteMacStatsAggregationTestCase ("Run shorter than one epoch, read on destroy",
+                                                   Seconds (1), times, expected, false),
+               TestCase::QUICK);
+  AddTestCase (new LteMacStatsAggregationTestCase ("Run shorter than one epoch, read on dispose",
+                                                   Seconds (1), times, expected, true),
+               TestCase::QUICK);
+
+  times.clear ();
+  expected.clear ();
+  times.push_back (MilliSeconds (50));
+  times.push_back (MilliSeconds (60));
+  times.push_back (MilliSeconds (150));
+  times.push_back (MilliSeconds (350));
+  times.push_back (MilliSeconds (360));
+  times.push_back (MilliSeconds (370));
+  expected.push_back ("0.1\t1\t7\t3\t2\t10\t200\t0\t0");
+  expected.push_back ("0.2\t1\t7\t3\t1\t10\t100\t0\t0");
+  expected.push_back ("0.4\t1\t7\t3\t3\t10\t300\t0\t0");
+  AddTestCase (new LteMacStatsAggregationTestCase ("Run of several epochs, read on destroy",
+                                                   MilliSeconds (100), times, expected, false),
+               TestCase::QUICK);
+  AddTestCase (new LteMacStatsAggregationTestCase ("Run of several epochs, read on dispose",
+                                                   MilliSeconds (100), times, expected, true),
+               TestCase::QUICK);
+}
+
+} // namespace ns3
@@ -0,0 +1,298 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <sstream>
+#include <map>
+#include "ns3/simulator.h"
+#include "ns3/log.h"
+#include "ns3/config.h"
+#include "ns3/boolean.h"
+#include "ns3/test.h"
+#include "ns3/mobility-helper.h"
+#include "ns3/lte-helper.h"
+#include "ns3/net-device-container.h"
+#include "ns3/node-container.h"
+#include "ns3/packet.h"
+#include "ns3/packet-burst.h"
+#include "ns3/lte-common.h"
+
+NS_LOG_COMPONENT_DEFINE ("LteTtiDriverTest");
+
+namespace ns3 {
+
+/**
+ * Checks that driving the PHYs with the LteTtiDriver does not change
+ * the scheduling decisions of the eNB MAC or, if phyTraces is true, the
+ * transmissions and receptions of the PHYs, nor the order and the node
+ * context in which they happen. If nodeContext is true, the devices are
+ * created during the run, in the context of their node, as are then
+ * the subframe events of their PHYs.
+ */
+class LteTtiDriverTestCase : public TestCase
+{
+public:
+  /**
+   * \param phyTraces compare the PHY traces instead of the MAC ones
+   * \param nodeContext create the devices in the context of their node
+   */
+  LteTtiDriverTestCase (bool phyTraces, bool nodeContext);
+  virtual ~LteTtiDriverTestCase ();
+
+private:
+  /// The events traced by each trace source, in the order they happened
+  typedef std::map<std::string, std::string> Traces;
+
+  virtual void DoRun (void);
+  std::string RunSimulation (bool aggregate);
+  void Configure (Ptr<LteHelper> lteHelper, NetDeviceContainer *enbDevs, NetDeviceContainer *ueDevs,
+                  Traces *traces);
+  static void InstallEnbDevice (Ptr<LteHelper> lteHelper, Ptr<Node> node, NetDeviceContainer *devs);
+  static void InstallUeDevice (Ptr<LteHelper> lteHelper, Ptr<Node> node, NetDeviceContainer *devs);
+  static void Record (Traces *traces, std::string path, std::string what);
+  static void DlScheduling (Traces *traces, std::string path,
+                            uint32_t frameNo, uint32_t subframeNo, uint16_t rnti,
+                            uint8_t mcsTb1, uint16_t sizeTb1, uint8_t mcsTb2, uint16_t sizeTb2);
+  static void UlScheduling (Traces *traces, std::string path,
+                            uint32_t frameNo, uint32_t subframeNo, uint16_t rnti,
+                            uint8_t mcs, uint16_t size);
+  static void PhyTransmission (Traces *traces, std::string path,
+                               PhyTransmissionStatParameters params);
+  static void PacketBurstEvent (Traces *traces, std::string path, Ptr<const PacketBurst> pb);
+  static void PacketEvent (Traces *traces, std::string path, Ptr<const Packet> p);
+
+  bool m_phyTraces;
+  bool m_nodeContext;
+};
+
+LteTtiDriverTestCase::LteTtiDriverTestCase (bool phyTraces, bool nodeContext)
+  : TestCase (std::string (phyTraces
+                           ? "Subframes driven by the LteTtiDriver give the same PHY events, in the same context"
+                           : "Subframes driven by the LteTtiDriver give the same scheduling as per-PHY events")
+              + (nodeContext ? ", devices created in the context of their node" : "")),
+    m_phyTraces (phyTraces),
+    m_nodeContext (nodeContext)
+{
+}
+
+LteTtiDriverTestCase::~LteTtiDriverTestCase ()
+{
+}
+
+void
+LteTtiDriverTestCase::Record (Traces *traces, std::string path, std::string what)
+{
+  std::ostringstream event;
+  event << Simulator::Now ().GetNanoSeconds () << " " << Simulator::GetContext () << " " << what << "\n";
+  (*traces)[path] += event.str ();
+}
+
+void
+LteTtiDriverTestCase::DlScheduling (Traces *traces, std::string path,
+                                    uint32_t frameNo, uint32_t subframeNo, uint16_t rnti,
+                                    uint8_t mcsTb1, uint16_t sizeTb1, uint8_t mcsTb2, uint16_t sizeTb2)
+{
+  std::ostringstream what;
+  what << "DL " << frameNo << " " << subframeNo << " " << rnti << " " << (uint32_t) mcsTb1
+       << " " << sizeTb1 << " " << (uint32_t) mcsTb2 << " " << sizeTb2;
+  Record (traces, path, what.str ());
+}
+
+void
+LteTtiDriverTestCase::UlScheduling (Traces *traces, std::string path,
+                                    uint32_t frameNo, uint32_t subframeNo, uint16_t rnti,
+                                    uint8_t mcs, uint16_t size)
+{
+  std::ostringstream what;
+  what << "UL " << frameNo << " " << subframeNo << " " << rnti << " " << (uint32_t) mcs << " " << size;
+  Record (traces, path, what.str ());
+}
+
+void
+LteTtiDriverTestCase::PhyTransmission (Traces *traces, std::string path,
+                                       PhyTransmissionStatParameters params)
+{
+  std::ostringstream what;
+  what << params.m_cellId << " " << params.m_imsi << " " << params.m_rnti
+       << " " << (uint32_t) params.m_mcs << " " << params.m_size;
+  Record (traces, path, what.str ());
+}
+
+void
+LteTtiDriverTestCase::PacketBurstEvent (Traces *traces, std::string path, Ptr<const PacketBurst> pb)
+{
+  std::ostringstream what;
+  what << (pb == 0 ? 0 : pb->GetSize ());
+  Record (traces, path, what.str ());
+}
+
+void
+LteTtiDriverTestCase::PacketEvent (Traces *traces, std::string path, Ptr<const Packet> p)
+{
+  std::ostringstream what;
+  what << p->GetSize ();
+  Record (traces, path, what.str ());
+}
+
+void
+LteTtiDriverTestCase::InstallEnbDevice (Ptr<LteHelper> lteHelper, Ptr<Node> node, NetDeviceContainer *devs)
+{
+  devs->Add (lteHelper->InstallEnbDevice (NodeContainer (node)));
+}
+
+void
+LteTtiDriverTestCase::InstallUeDevice (Ptr<LteHelper> lteHelper, Ptr<Node> node, NetDeviceContainer *devs)
+{
+  devs->Add (lteHelper->InstallUeDevice (NodeContainer (node)));
+}
+
+void
+LteTtiDriverTestCase::Configure (Ptr<LteHelper> lteHelper, NetDeviceContainer *enbDevs, NetDeviceContainer *ueDevs,
+                                 Traces *traces)
+{
+  // the random variables of both runs must use the same streams
+  int64_t stream = lteHelper->AssignStreams (*enbDevs, 1);
+  lteHelper->AssignStreams (*ueDevs, 1 + stream);
+  lteHelper->AttachToClosestEnb (*ueDevs, *enbDevs);
+  EpsBearer bearer (EpsBearer::NGBR_VIDEO_TCP_DEFAULT);
+  lteHelper->ActivateDataRadioBearer (*ueDevs, bearer);
+
+  if (m_phyTraces)
+    {
+      Config::Connect ("/NodeList/*/DeviceList/*/LteUePhy/UlPhyTransmission",
+                       MakeBoundCallback (&LteTtiDriverTestCase::PhyTransmission, traces));
+      Config::Connect ("/NodeList/*/DeviceList/*/LteEnbPhy/DlPhyTransmission",
+                       MakeBoundCallback (&LteTtiDriverTestCase::PhyTransmission, traces));
+      const char *spectrumPhys[] = {
+        "/NodeList/*/DeviceList/*/LteUePhy/DlSpectrumPhy/",
+        "/NodeList/*/DeviceList/*/LteUePhy/UlSpectrumPhy/",
+        "/NodeList/*/DeviceList/*/LteEnbPhy/DlSpectrumPhy/",
+        "/NodeList/*/DeviceList/*/LteEnbPhy/UlSpectrumPhy/",
+      };
+      for (uint32_t i = 0; i < sizeof (spectrumPhys) / sizeof (spectrumPhys[0]); ++i)
+        {
+          std::string path = spectrumPhys[i];
+          Config::Connect (path + "TxStart",
+                           MakeBoundCallback (&LteTtiDriverTestCase::PacketBurstEvent, traces));
+          Config::Connect (path + "TxEnd",
+                           MakeBoundCallback (&LteTtiDriverTestCase::PacketBurstEvent, traces));
+          Config::Connect (path + "RxEndOk",
+                           MakeBoundCallback (&LteTtiDriverTestCase::PacketEvent, traces));
+          Config::Connect (path + "RxEndError",
+                           MakeBoundCallback (&LteTtiDriverTestCase::PacketEvent, traces));
+        }
+    }
+  else
+    {
+      Config::Connect ("/NodeList/*/DeviceList/*/LteEnbMac/DlScheduling",
+                       MakeBoundCallback (&LteTtiDriverTestCase::DlScheduling, traces));
+      Config::Connect ("/NodeList/*/DeviceList/*/LteEnbMac/UlScheduling",
+                       MakeBoundCallback (&LteTtiDriverTestCase::UlScheduling, traces));
+    }
+}
+
+std::string
+LteTtiDriverTestCase::RunSimulation (bool aggregate)
+{
+  Config::Reset ();
+  Config::SetDefault ("ns3::LtePhy::AggregateSubframeEvents", BooleanValue (aggregate));
+  Config::SetDefault ("ns3::LteHelper::UseIdealRrc", BooleanValue (true));
+  Ptr<LteHelper> lteHelper = CreateObject<LteHelper> ();
+  lteHelper->SetSchedulerType ("ns3::RrFfMacScheduler");
+
+  NodeContainer enbNodes;
+  NodeContainer ueNodes;
+  enbNodes.Create (2);
+  ueNodes.Create (6);
+
+  Ptr<ListPositionAllocator> positionAlloc = CreateObject<ListPositionAllocator> ();
+  positionAlloc->Add (Vector (0.0, 0.0, 0.0));
+  positionAlloc->Add (Vector (1000.0, 0.0, 0.0));
+  for (uint32_t i = 0; i < ueNodes.GetN (); ++i)
+    {
+      positionAlloc->Add (Vector (100.0 + 150.0 * i, 50.0, 0.0));
+    }
+  MobilityHelper mobility;
+  mobility.SetMobilityModel ("ns3::ConstantPositionMobilityModel");
+  mobility.SetPositionAllocator (positionAlloc);
+  mobility.Install (enbNodes);
+  mobility.Install (ueNodes);
+
+  NetDeviceContainer enbDevs;
+  NetDeviceContainer ueDevs;
+  Traces traces;
+  if (m_nodeContext)
+    {
+      for (uint32_t i = 0; i < enbNodes.GetN (); ++i)
+        {
+          Simulator::ScheduleWithContext (enbNodes.Get (i)->GetId (), Seconds (0),
+                                          &LteTtiDriverTestCase::InstallEnbDevice,
+                                          lteHelper, enbNodes.Get (i), &enbDevs);
+        }
+      for (uint32_t i = 0; i < ueNodes.GetN (); ++i)
+        {
+          Simulator::ScheduleWithContext (ueNodes.Get (i)->GetId (), Seconds (0),
+                                          &LteTtiDriverTestCase::InstallUeDevice,
+                                          lteHelper, ueNodes.Get (i), &ueDevs);
+        }
+      Simulator::Schedule (Seconds (0), &LteTtiDriverTestCase::Configure, this,
+                           lteHelper, &enbDevs, &ueDevs, &traces);
+    }
+  else
+    {
+      enbDevs = lteHelper->InstallEnbDevice (enbNodes);
+      ueDevs = lteHelper->InstallUeDevice (ueNodes);
+      Configure (lteHelper, &enbDevs, &ueDevs, &traces);
+    }
+
+  Simulator::Stop (Seconds (0.1));
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  // the events of different nodes at the same time are run in the order
+  // of the addresses of their PHYs in the channel, so compare the events
+  // of each trace source on their own
+  std::string trace;
+  for (Traces::const_iterator it = traces.begin (); it != traces.end (); ++it)
+    {
+      trace += it->first + "\n" + it->second;
+    }
+  return trace;
+}
+
+void
+LteTtiDriverTestCase::DoRun (void)
+{
+  std::string reference = RunSimulation (false);
+  std::string aggregated = RunSimulation (true);
+  NS_TEST_ASSERT_MSG_EQ (reference.empty (), false, "Nothing was traced");
+  NS_TEST_ASSERT_MSG_EQ (aggregated, reference, "Traces differ when the subframe events are aggregated");
+  Config::Reset ();
+}
+
+
+static class LteTtiDriverTestSuite : public TestSuite
+{
+public:
+  LteTtiDriverTestSuite ()
+    : TestSuite ("lte-tti-driver", SYSTEM)
+  {
+    AddTestCase (new LteTtiDriverTestCase (false, false), TestCase::QUICK);
+    AddTestCase (new LteTtiDriverTestCase (true, false), TestCase::QUICK);
+    AddTestCase (new LteTtiDriverTestCase (true, true), TestCase::QUICK);
+  }
+} g_lteTtiDriverTestSuite;
+
+} // namespace ns3
@@ -460,7 +460,9 @@ HwmpProtocolMac::Statistics::Print (std::ostream & os) const
   "txData=\"" << txData << "\"" << std::endl <<
   "txDataBytes=\"" << txDataBytes << "\"" << std::endl <<
   "rxData=\"" << rxData << "\"" << std::endl <<
-  "rxDataBytes=\"" << rxDataBytes << "\"/>" << std::endl;
+  "rxDataBytes=\"" << rxDataBytes << "\"" << std::endl <<
+  "txMgtToDataBytesRatio=\"" << (txDataBytes == 0 ? 0.0 : (double)txMgtBytes / txDataBytes) << "\"" << std::endl <<
+  "rxMgtToDataBytesRatio=\"" << (rxDataBytes == 0 ? 0.0 : (double)rxMgtBytes / rxDataBytes) << "\"/>" << std::endl;
 }
 void
 HwmpProtocolMac::Report (std::ostream & os) const
@@ -214,7 +214,7 @@ void
 HwmpProtocol::DoDispose ()
 {
   NS_LOG_FUNCTION_NOARGS ();
-  for (std::map<Mac48Address, PreqEvent>::iterator i = m_preqTimeouts.begin (); i != m_preqTimeouts.end (); i++)
+  for (PreqTimeouts::iterator i = m_preqTimeouts.begin (); i != m_preqTimeouts.end (); i++)
     {
       i->second.preqTimeout.Cancel ();
     }
@@ -405,13 +405,14 @@ HwmpProtocol::ReceivePreq (IePreq preq, Mac48Address from, uint32_t interface, M
 {
   preq.IncrementMetric (metric);
   //acceptance cretirea:
-  std::map<Mac48Address, std::pair<uint32_t, uint32_t> >::const_iterator i = m_hwmpSeqnoMetricDatabase.find (
-      preq.GetOriginatorAddress ());
+  m_stats.rxPreq++;
+  SeqnoMetricDatabase::const_iterator i = m_hwmpSeqnoMetricDatabase.find (preq.GetOriginatorAddress ());
   bool freshInfo (true);
   if (i != m_hwmpSeqnoMetricDatabase.end ())
     {
       if ((int32_t)(i->second.first - preq.GetOriginatorSeqNumber ())  > 0)
         {
+          m_stats.filteredPreq++;
           return;
         }
       if (i->second.first == preq.GetOriginatorSeqNumber ())
@@ -419,6 +420,7 @@ HwmpProtocol::ReceivePreq (IePreq preq, Mac48Address from, uint32_t interface, M
           freshInfo = false;
           if (i->second.second <= preq.GetMetric ())
             {
+              m_stats.filteredPreq++;
               return;
             }
         }
@@ -568,14 +570,15 @@ HwmpProtocol::ReceivePrep (IePrep prep, Mac48Address from, uint32_t interface, M
 {
   prep.IncrementMetric (metric);
   //acceptance cretirea:
-  std::map<Mac48Address, std::pair<uint32_t, uint32_t> >::const_iterator i = m_hwmpSeqnoMetricDatabase.find (
-      prep.GetOriginatorAddress ());
+  m_stats.rxPrep++;
+  SeqnoMetricDatabase::const_iterator i = m_hwmpSeqnoMetricDatabase.find (prep.GetOriginatorAddress ());
   bool freshInfo (true);
   uint32_t sequence = prep.GetDestinationSeqNumber ();
   if (i != m_hwmpSeqnoMetricDatabase.end ())
     {
       if ((int32_t)(i->second.first - sequence) > 0)
         {
+          m_stats.filteredPrep++;
           return;
         }
       if (i->second.first == sequence)
@@ -746,7 +749,7 @@ HwmpProtocol::DropDataFrame (uint32_t seqno, Mac48Address source)
     {
       return true;
     }
-  std::map<Mac48Address, uint32_t,std::less<Mac48Address> >::const_iterator i = m_lastDataSeqno.find (source);
+  sgi::hash_map<Mac48Address, uint32_t, Mac48AddressHash>::const_iterator i = m_lastDataSeqno.find (source);
   if (i == m_lastDataSeqno.end ())
     {
       m_lastDataSeqno[source] = seqno;
@@ -914,7 +917,7 @@ HwmpProtocol::DequeueFirstPacket ()
 void
 HwmpProtocol::ReactivePathResolved (Mac48Address dst)
 {
-  std::map<Mac48Address, PreqEvent>::iterator i = m_preqTimeouts.find (dst);
+  PreqTimeouts::iterator i = m_preqTimeouts.find (dst);
   if (i != m_preqTimeouts.end ())
     {
       m_routeDiscoveryTimeCallback (Simulator::Now () - i->second.whenScheduled);
@@ -966,7 +969,7 @@ HwmpProtocol::ProactivePathResolved ()
 bool
 HwmpProtocol::ShouldSendPreq (Mac48Address dst)
 {
-  std::map<Mac48Address, PreqEvent>::const_iterator i = m_preqTimeouts.find (dst);
+  PreqTimeouts::const_iterator i = m_preqTimeouts.find (dst);
   if (i == m_preqTimeouts.end ())
     {
       m_preqTimeouts[dst].preqTimeout = Simulator::Schedule (
@@ -987,7 +990,7 @@ HwmpProtocol::RetryPathDiscovery (Mac48Address dst, uint8_t numOfRetry)
     }
   if (result.retransmitter != Mac48Address::GetBroadcast ())
     {
-      std::map<Mac48Address, PreqEvent>::iterator i = m_preqTimeouts.find (dst);
+      PreqTimeouts::iterator i = m_preqTimeouts.find (dst);
       NS_ASSERT (i != m_preqTimeouts.end ());
       m_preqTimeouts.erase (i);
       return;
@@ -1002,7 +1005,7 @@ HwmpProtocol::RetryPathDiscovery (Mac48Address dst, uint8_t numOfRetry)
           packet.reply (false, packet.pkt, packet.src, packet.dst, packet.protocol, HwmpRtable::MAX_METRIC);
           packet = DequeueFirstPacketByDst (dst);
         }
-      std::map<Mac48Address, PreqEvent>::iterator i = m_preqTimeouts.find (dst);
+      PreqTimeouts::iterator i = m_preqTimeouts.find (dst);
       NS_ASSERT (i != m_preqTimeouts.end ());
       m_routeDiscoveryTimeCallback (Simulator::Now () - i->second.whenScheduled);
       m_preqTimeouts.erase (i);
@@ -1115,7 +1118,11 @@ HwmpProtocol::Statistics::Statistics () :
   totalDropped (0),
   initiatedPreq (0),
   initiatedPrep (0),
-  initiatedPerr (0)
+  initiatedPerr (0),
+  rxPreq (0),
+  rxPrep (0),
+  filteredPreq (0),
+  filteredPrep (0)
 {
 }
 void HwmpProtocol::Statistics::Print (std::ostream & os) const
@@ -1129,7 +1136,11 @@ void HwmpProtocol::Statistics::Print (std::ostream & os) const
   "totalDropped=\"" << totalDropped << "\" "
   "initiatedPreq=\"" << initiatedPreq << "\" "
   "initiatedPrep=\"" << initiatedPrep << "\" "
-  "initiatedPerr=\"" << initiatedPerr << "\"/>" << std::endl;
+  "initiatedPerr=\"" << initiatedPerr << "\" "
+  "rxPreq=\"" << rxPreq << "\" "
+  "rxPrep=\"" << rxPrep << "\" "
+  "filteredPreq=\"" << filteredPreq << "\" "
+  "filteredPrep=\"" << filteredPrep << "\"/>" << std::endl;
 }
 void
 HwmpProtocol::Report (std::ostream & os) const
@@ -25,6 +25,8 @@
 #include "ns3/nstime.h"
 #include "ns3/event-id.h"
 #include "ns3/traced-value.h"
+#include "ns3/mac48-address.h"
+#include "ns3/sgi-hashmap.h"
 #include <vector>
 #include <map>
 
@@ -226,6 +228,10 @@ private:
     uint16_t initiatedPreq;
     uint16_t initiatedPrep;
     uint16_t initiatedPerr;
+    uint32_t rxPreq;
+    uint32_t rxPrep;
+    uint32_t filteredPreq;
+    uint32_t filteredPrep;
 
     void Print (std::ostream & os) const;
     Statistics ();
@@ -240,9 +246,10 @@ private:
   ///\name Sequence number filters
   ///\{
   /// Data sequence number database
-  std::map<Mac48Address, uint32_t> m_lastDataSeqno;
+  sgi::hash_map<Mac48Address, uint32_t, Mac48AddressHash> m_lastDataSeqno;
   /// keeps HWMP seqno (first in pair) and HWMP metric (second in pair) for each address
-  std::map<Mac48Address, std::pair<uint32_t, uint32_t> > m_hwmpSeqnoMetricDatabase;
+  typedef sgi::hash_map<Mac48Address, std::pair<uint32_t, uint32_t>, Mac48AddressHash> SeqnoMetricDatabase;
+  SeqnoMetricDatabase m_hwmpSeqnoMetricDatabase;
   ///\}
 
   /// Routing table
@@ -254,7 +261,8 @@ private:
     EventId preqTimeout;
     Time whenScheduled;
   };
-  std::map<Mac48Address, PreqEvent> m_preqTimeouts;
+  typedef sgi::hash_map<Mac48Address, PreqEvent, Mac48AddressHash> PreqTimeouts;
+  PreqTimeouts m_preqTimeouts;
   EventId m_proactivePreqTimer;
   /// Random start in Proactive PREQ propagation
   Time m_randomStart;
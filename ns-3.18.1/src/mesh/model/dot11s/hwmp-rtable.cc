@@ -26,6 +26,8 @@
 
 #include "hwmp-rtable.h"
 
+#include <algorithm>
+
 namespace ns3 {
 namespace dot11s {
 
@@ -33,6 +35,12 @@ NS_LOG_COMPONENT_DEFINE ("HwmpRtable");
 
 NS_OBJECT_ENSURE_REGISTERED (HwmpRtable);
 
+static bool
+FailedDestinationLess (const HwmpProtocol::FailedDestination &a, const HwmpProtocol::FailedDestination &b)
+{
+  return a.destination < b.destination;
+}
+
 TypeId
 HwmpRtable::GetTypeId ()
 {
@@ -57,7 +65,7 @@ void
 HwmpRtable::AddReactivePath (Mac48Address destination, Mac48Address retransmitter, uint32_t interface,
                              uint32_t metric, Time lifetime, uint32_t seqnum)
 {
-  std::map<Mac48Address, ReactiveRoute>::iterator i = m_routes.find (destination);
+  ReactiveRoutes::iterator i = m_routes.find (destination);
   if (i == m_routes.end ())
     {
       ReactiveRoute newroute;
@@ -90,7 +98,7 @@ HwmpRtable::AddPrecursor (Mac48Address destination, uint32_t precursorInterface,
   precursor.interface = precursorInterface;
   precursor.address = precursorAddress;
   precursor.whenExpire = Simulator::Now () + lifetime;
-  std::map<Mac48Address, ReactiveRoute>::iterator i = m_routes.find (destination);
+  ReactiveRoutes::iterator i = m_routes.find (destination);
   if (i != m_routes.end ())
     {
       bool should_add = true;
@@ -132,7 +140,7 @@ HwmpRtable::DeleteProactivePath (Mac48Address root)
 void
 HwmpRtable::DeleteReactivePath (Mac48Address destination)
 {
-  std::map<Mac48Address, ReactiveRoute>::iterator i = m_routes.find (destination);
+  ReactiveRoutes::iterator i = m_routes.find (destination);
   if (i != m_routes.end ())
     {
       m_routes.erase (i);
@@ -141,7 +149,7 @@ HwmpRtable::DeleteReactivePath (Mac48Address destination)
 HwmpRtable::LookupResult
 HwmpRtable::LookupReactive (Mac48Address destination)
 {
-  std::map<Mac48Address, ReactiveRoute>::iterator i = m_routes.find (destination);
+  ReactiveRoutes::iterator i = m_routes.find (destination);
   if (i == m_routes.end ())
     {
       return LookupResult ();
@@ -156,7 +164,7 @@ HwmpRtable::LookupReactive (Mac48Address destination)
 HwmpRtable::LookupResult
 HwmpRtable::LookupReactiveExpired (Mac48Address destination)
 {
-  std::map<Mac48Address, ReactiveRoute>::iterator i = m_routes.find (destination);
+  ReactiveRoutes::iterator i = m_routes.find (destination);
   if (i == m_routes.end ())
     {
       return LookupResult ();
@@ -185,7 +193,7 @@ HwmpRtable::GetUnreachableDestinations (Mac48Address peerAddress)
 {
   HwmpProtocol::FailedDestination dst;
   std::vector<HwmpProtocol::FailedDestination> retval;
-  for (std::map<Mac48Address, ReactiveRoute>::iterator i = m_routes.begin (); i != m_routes.end (); i++)
+  for (ReactiveRoutes::iterator i = m_routes.begin (); i != m_routes.end (); i++)
     {
       if (i->second.retransmitter == peerAddress)
         {
@@ -195,6 +203,9 @@ HwmpRtable::GetUnreachableDestinations (Mac48Address peerAddress)
           retval.push_back (dst);
         }
     }
+  // m_routes is a hash map: sort to keep the address order the PERR had when
+  // the table was a std::map, so PERR contents and traces stay unchanged
+  std::sort (retval.begin (), retval.end (), FailedDestinationLess);
   //Lookup a path to root
   if (m_root.retransmitter == peerAddress)
     {
@@ -209,7 +220,7 @@ HwmpRtable::GetPrecursors (Mac48Address destination)
 {
   //We suppose that no duplicates here can be
   PrecursorList retval;
-  std::map<Mac48Address, ReactiveRoute>::iterator route = m_routes.find (destination);
+  ReactiveRoutes::iterator route = m_routes.find (destination);
   if (route != m_routes.end ())
     {
       for (std::vector<Precursor>::const_iterator i = route->second.precursors.begin ();
@@ -24,6 +24,7 @@
 #include <map>
 #include "ns3/nstime.h"
 #include "ns3/mac48-address.h"
+#include "ns3/sgi-hashmap.h"
 #include "ns3/hwmp-protocol.h"
 namespace ns3 {
 namespace dot11s {
@@ -136,8 +137,9 @@ private:
     std::vector<Precursor> precursors;
   };
 
-  /// List of routes
-  std::map<Mac48Address, ReactiveRoute>  m_routes;
+  /// List of routes, hashed by destination
+  typedef sgi::hash_map<Mac48Address, ReactiveRoute, Mac48AddressHash> ReactiveRoutes;
+  ReactiveRoutes m_routes;
   /// Path to proactive tree root MP
   ProactiveRoute  m_root;
 };
@@ -107,6 +107,8 @@ private:
   void TestPrecursorAdd ();
   void TestPrecursorFind ();
   ///\}
+  /// Test unreachable destinations are reported in address order
+  void TestUnreachable ();
 private:
   Mac48Address dst;
   Mac48Address hop;
@@ -192,12 +194,47 @@ HwmpRtableTest::TestPrecursorFind ()
     }
 }
 
+void
+HwmpRtableTest::TestUnreachable ()
+{
+  Mac48Address failed ("01:00:00:01:00:09");
+  std::vector<Mac48Address> destinations;
+  destinations.push_back (Mac48Address ("00:00:00:00:00:30"));
+  destinations.push_back (Mac48Address ("00:00:00:00:01:00"));
+  destinations.push_back (Mac48Address ("00:00:00:00:00:10"));
+  destinations.push_back (Mac48Address ("00:00:00:00:00:20"));
+  for (std::vector<Mac48Address>::const_iterator i = destinations.begin (); i != destinations.end (); i++)
+    {
+      table->AddReactivePath (*i, failed, iface, metric, expire, seqnum);
+    }
+  table->AddReactivePath (Mac48Address ("00:00:00:00:00:40"), hop, iface, metric, expire, seqnum);
+
+  std::vector<HwmpProtocol::FailedDestination> unreachable = table->GetUnreachableDestinations (failed);
+  NS_TEST_EXPECT_MSG_EQ (unreachable.size (), destinations.size (), "Unreachable destinations works");
+  for (unsigned i = 1; i < unreachable.size (); i++)
+    {
+      NS_TEST_EXPECT_MSG_EQ ((unreachable[i - 1].destination < unreachable[i].destination), true,
+                             "Unreachable destinations are sorted");
+    }
+  for (unsigned i = 0; i < unreachable.size (); i++)
+    {
+      NS_TEST_EXPECT_MSG_EQ (unreachable[i].seqnum, seqnum + 1, "Unreachable destination seqnum is incremented");
+    }
+
+  for (std::vector<Mac48Address>::const_iterator i = destinations.begin (); i != destinations.end (); i++)
+    {
+      table->DeleteReactivePath (*i);
+    }
+  table->DeleteReactivePath (Mac48Address ("00:00:00:00:00:40"));
+}
+
 void
 HwmpRtableTest::DoRun ()
 {
   table = CreateObject<HwmpRtable> ();
 
   Simulator::Schedule (Seconds (0), &HwmpRtableTest::TestLookup, this);
+  Simulator::Schedule (Seconds (0.5), &HwmpRtableTest::TestUnreachable, this);
   Simulator::Schedule (Seconds (1), &HwmpRtableTest::TestAddPath, this);
   Simulator::Schedule (Seconds (2), &HwmpRtableTest::TestPrecursorAdd, this);
   Simulator::Schedule (expire + Seconds (2), &HwmpRtableTest::TestExpire, this);
@@ -0,0 +1,141 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/*
+ * Cross-rank packet throughput benchmark.
+ *
+ * nLinks point-to-point links connect nLinks nodes on rank 0 to nLinks
+ * nodes on rank 1.  Each node on rank 0 sends UDP packets at a constant
+ * rate to a packet sink on its peer, so that every packet goes through
+ * MPI.  Each rank prints the wall clock time of the run and the number of
+ * packets sent or received through MPI:
+ *
+ *   mpirun -np 2 ./waf --run "mpi-throughput --nLinks=100 --rate=10Mbps"
+ */
+
+#include <iostream>
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/mpi-interface.h"
+#include "ns3/point-to-point-helper.h"
+#include "ns3/internet-stack-helper.h"
+#include "ns3/ipv4-address-helper.h"
+#include "ns3/on-off-helper.h"
+#include "ns3/packet-sink-helper.h"
+#include "ns3/system-wall-clock-ms.h"
+
+#ifdef NS3_MPI
+#include <mpi.h>
+#endif
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("MpiThroughput");
+
+int
+main (int argc, char *argv[])
+{
+#ifdef NS3_MPI
+  // Distributed simulation setup
+  MpiInterface::Enable (&argc, &argv);
+  GlobalValue::Bind ("SimulatorImplementationType",
+                     StringValue ("ns3::DistributedSimulatorImpl"));
+
+  uint32_t systemId = MpiInterface::GetSystemId ();
+  uint32_t systemCount = MpiInterface::GetSize ();
+
+  // Must have 2 and only 2 Logical Processors (LPs)
+  if (systemCount != 2)
+    {
+      std::cout << "This simulation requires 2 and only 2 logical processors." << std::endl;
+      return 1;
+    }
+
+  uint32_t nLinks = 100;
+  double simTime = 10.0;
+  std::string rate = "10Mbps";
+  uint32_t packetSize = 512;
+
+  CommandLine cmd;
+  cmd.AddValue ("nLinks", "Number of links between the two ranks", nLinks);
+  cmd.AddValue ("simTime", "Simulation time in seconds", simTime);
+  cmd.AddValue ("rate", "Data rate of each sender", rate);
+  cmd.AddValue ("packetSize", "Size of the UDP payloads", packetSize);
+  cmd.Parse (argc, argv);
+
+  NodeContainer leftNodes;
+  leftNodes.Create (nLinks, 0);
+  NodeContainer rightNodes;
+  rightNodes.Create (nLinks, 1);
+
+  PointToPointHelper link;
+  link.SetDeviceAttribute ("DataRate", StringValue ("1Gbps"));
+  link.SetChannelAttribute ("Delay", StringValue ("1ms"));
+
+  InternetStackHelper stack;
+  stack.InstallAll ();
+
+  Ipv4AddressHelper address;
+  address.SetBase ("10.0.0.0", "255.255.255.252");
+
+  uint16_t port = 9;
+  ApplicationContainer sinks;
+  for (uint32_t i = 0; i < nLinks; ++i)
+    {
+      NetDeviceContainer devices = link.Install (leftNodes.Get (i), rightNodes.Get (i));
+      Ipv4InterfaceContainer interfaces = address.Assign (devices);
+      address.NewNetwork ();
+
+      if (systemId == 0)
+        {
+          OnOffHelper onoff ("ns3::UdpSocketFactory",
+                             Address (InetSocketAddress (interfaces.GetAddress (1), port)));
+          onoff.SetConstantRate (DataRate (rate), packetSize);
+          ApplicationContainer source = onoff.Install (leftNodes.Get (i));
+          source.Start (Seconds (1.0));
+          source.Stop (Seconds (simTime));
+        }
+      else
+        {
+          PacketSinkHelper sink ("ns3::UdpSocketFactory",
+                                 InetSocketAddress (Ipv4Address::GetAny (), port));
+          sinks.Add (sink.Install (rightNodes.Get (i)));
+        }
+    }
+  sinks.Start (Seconds (0.0));
+
+  SystemWallClockMs clock;
+  clock.Start ();
+  Simulator::Stop (Seconds (simTime));
+  Simulator::Run ();
+  int64_t elapsed = clock.End ();
+
+  std::cout << "rank " << systemId
+            << " links " << nLinks
+            << " wallclock(ms) " << elapsed
+            << " mpi tx " << MpiInterface::GetTxCount ()
+            << " mpi rx " << MpiInterface::GetRxCount ()
+            << std::endl;
+
+  Simulator::Destroy ();
+  // Exit the MPI execution environment
+  MpiInterface::Disable ();
+  return 0;
+#else
+  NS_FATAL_ERROR ("Can't use distributed simulator without MPI compiled in");
+#endif
+}
@@ -346,7 +346,9 @@ DistributedSimulatorImpl::Run (void)
         { 
 
           // Can't process next event, calculate a new LBTS
-          // First receive any pending messages
+          // First send the packets aggregated during this window
+          MpiInterface::FlushSendBuffers ();
+          // Then receive any pending messages
           MpiInterface::ReceiveMessages ();
           // reset next time
           nextTime = Next ();
@@ -22,6 +22,7 @@
 #include <iostream>
 #include <iomanip>
 #include <list>
+#include <cstring>
 
 #include "mpi-interface.h"
 #include "mpi-receiver.h"
@@ -82,6 +83,16 @@ std::list<SentBuffer> MpiInterface::m_pendingTx;
 MPI_Request* MpiInterface::m_requests;
 char**       MpiInterface::m_pRxBuffers;
 #endif
+uint8_t**    MpiInterface::m_pTxBuffers = 0;
+uint32_t*    MpiInterface::m_txBufferSizes = 0;
+
+namespace {
+
+// Each packet in an MPI message is preceded by its size, its receive
+// time in nanoseconds, its destination node and device
+const uint32_t PACKET_HEADER_SIZE = 4 + 8 + 4 + 4;
+
+} // anonymous namespace
 
 void
 MpiInterface::Destroy ()
@@ -94,6 +105,15 @@ MpiInterface::Destroy ()
   delete [] m_pRxBuffers;
   delete [] m_requests;
 
+  for (uint32_t i = 0; i < GetSize (); ++i)
+    {
+      delete [] m_pTxBuffers[i];
+    }
+  delete [] m_pTxBuffers;
+  delete [] m_txBufferSizes;
+  m_pTxBuffers = 0;
+  m_txBufferSizes = 0;
+
   m_pendingTx.clear ();
 #endif
 }
@@ -159,10 +179,19 @@ MpiInterface::Enable (int* pargc, char*** pargv)
   m_requests = new MPI_Request[m_size];
   for (uint32_t i = 0; i < GetSize (); ++i)
     {
-      m_pRxBuffers[i] = new char[MAX_MPI_MSG_SIZE];
-      MPI_Irecv (m_pRxBuffers[i], MAX_MPI_MSG_SIZE, MPI_CHAR, MPI_ANY_SOURCE, 0,
+      m_pRxBuffers[i] = new char[MAX_MPI_AGGREGATE_SIZE];
+      MPI_Irecv (m_pRxBuffers[i], MAX_MPI_AGGREGATE_SIZE, MPI_CHAR, MPI_ANY_SOURCE, 0,
                  MPI_COMM_WORLD, &m_requests[i]);
     }
+  // The aggregation buffers are allocated when the first packet is
+  // sent to each rank
+  m_pTxBuffers = new uint8_t*[m_size];
+  m_txBufferSizes = new uint32_t[m_size];
+  for (uint32_t i = 0; i < GetSize (); ++i)
+    {
+      m_pTxBuffers[i] = 0;
+      m_txBufferSizes[i] = 0;
+    }
 #else
   NS_FATAL_ERROR ("Can't use distributed simulator without MPI compiled in");
 #endif
@@ -172,30 +201,71 @@ void
 MpiInterface::SendPacket (Ptr<Packet> p, const Time& rxTime, uint32_t node, uint32_t dev)
 {
 #ifdef NS3_MPI
-  SentBuffer sendBuf;
-  m_pendingTx.push_back (sendBuf);
-  std::list<SentBuffer>::reverse_iterator i = m_pendingTx.rbegin (); // Points to the last element
+  // Find the system id for the destination node
+  Ptr<Node> destNode = NodeList::GetNode (node);
+  uint32_t nodeSysId = destNode->GetSystemId ();
 
   uint32_t serializedSize = p->GetSerializedSize ();
-  uint8_t* buffer =  new uint8_t[serializedSize + 16];
-  i->SetBuffer (buffer);
-  // Add the time, dest node and dest device
+  NS_ASSERT_MSG (PACKET_HEADER_SIZE + serializedSize <= MAX_MPI_AGGREGATE_SIZE,
+                 "Packet of " << serializedSize << " bytes too large for MPI");
+  if (m_txBufferSizes[nodeSysId] + PACKET_HEADER_SIZE + serializedSize > MAX_MPI_AGGREGATE_SIZE)
+    {
+      FlushSendBuffer (nodeSysId);
+    }
+  if (m_pTxBuffers[nodeSysId] == 0)
+    {
+      m_pTxBuffers[nodeSysId] = new uint8_t[MAX_MPI_AGGREGATE_SIZE];
+    }
+
+  // Add the size, time, dest node and dest device
+  uint8_t* buffer = m_pTxBuffers[nodeSysId] + m_txBufferSizes[nodeSysId];
   uint64_t t = rxTime.GetNanoSeconds ();
-  uint64_t* pTime = reinterpret_cast <uint64_t *> (buffer);
-  *pTime++ = t;
-  uint32_t* pData = reinterpret_cast<uint32_t *> (pTime);
-  *pData++ = node;
-  *pData++ = dev;
-  // Serialize the packet
-  p->Serialize (reinterpret_cast<uint8_t *> (pData), serializedSize);
+  std::memcpy (buffer, &serializedSize, 4);
+  std::memcpy (buffer + 4, &t, 8);
+  std::memcpy (buffer + 12, &node, 4);
+  std::memcpy (buffer + 16, &dev, 4);
+  // Serialize the packet right in the aggregation buffer
+  p->Serialize (buffer + PACKET_HEADER_SIZE, serializedSize);
+  m_txBufferSizes[nodeSysId] += PACKET_HEADER_SIZE + serializedSize;
 
-  // Find the system id for the destination node
-  Ptr<Node> destNode = NodeList::GetNode (node);
-  uint32_t nodeSysId = destNode->GetSystemId ();
+  m_txCount++;
+#else
+  NS_FATAL_ERROR ("Can't use distributed simulator without MPI compiled in");
+#endif
+}
+
+void
+MpiInterface::FlushSendBuffer (uint32_t rank)
+{
+#ifdef NS3_MPI
+  if (m_txBufferSizes[rank] == 0)
+    {
+      return;
+    }
+  SentBuffer sendBuf;
+  m_pendingTx.push_back (sendBuf);
+  std::list<SentBuffer>::reverse_iterator i = m_pendingTx.rbegin (); // Points to the last element
 
-  MPI_Isend (reinterpret_cast<void *> (i->GetBuffer ()), serializedSize + 16, MPI_CHAR, nodeSysId,
+  // The pending send now owns the buffer; a new one is allocated by
+  // the next packet sent to this rank
+  i->SetBuffer (m_pTxBuffers[rank]);
+  MPI_Isend (reinterpret_cast<void *> (i->GetBuffer ()), m_txBufferSizes[rank], MPI_CHAR, rank,
              0, MPI_COMM_WORLD, (i->GetRequest ()));
-  m_txCount++;
+  m_pTxBuffers[rank] = 0;
+  m_txBufferSizes[rank] = 0;
+#else
+  NS_FATAL_ERROR ("Can't use distributed simulator without MPI compiled in");
+#endif
+}
+
+void
+MpiInterface::FlushSendBuffers ()
+{
+#ifdef NS3_MPI
+  for (uint32_t i = 0; i < GetSize (); ++i)
+    {
+      FlushSendBuffer (i);
+    }
 #else
   NS_FATAL_ERROR ("Can't use distributed simulator without MPI compiled in");
 #endif
@@ -218,43 +288,54 @@ MpiInterface::ReceiveMessages ()
         }
       int count;
       MPI_Get_count (&status, MPI_CHAR, &count);
-      m_rxCount++; // Count this receive
-
-      // Get the meta data first
-      uint64_t* pTime = reinterpret_cast<uint64_t *> (m_pRxBuffers[index]);
-      uint64_t nanoSeconds = *pTime++;
-      uint32_t* pData = reinterpret_cast<uint32_t *> (pTime);
-      uint32_t node = *pData++;
-      uint32_t dev  = *pData++;
-
-      Time rxTime = NanoSeconds (nanoSeconds);
-
-      count -= sizeof (nanoSeconds) + sizeof (node) + sizeof (dev);
 
-      Ptr<Packet> p = Create<Packet> (reinterpret_cast<uint8_t *> (pData), count, true);
-
-      // Find the correct node/device to schedule receive event
-      Ptr<Node> pNode = NodeList::GetNode (node);
-      Ptr<MpiReceiver> pMpiRec = 0;
-      uint32_t nDevices = pNode->GetNDevices ();
-      for (uint32_t i = 0; i < nDevices; ++i)
+      // Unpack the packets of this message
+      uint8_t* buffer = reinterpret_cast<uint8_t *> (m_pRxBuffers[index]);
+      uint8_t* end = buffer + count;
+      while (buffer + PACKET_HEADER_SIZE <= end)
         {
-          Ptr<NetDevice> pThisDev = pNode->GetDevice (i);
-          if (pThisDev->GetIfIndex () == dev)
+          m_rxCount++; // Count this receive
+
+          // Get the meta data first
+          uint32_t size;
+          uint64_t nanoSeconds;
+          uint32_t node;
+          uint32_t dev;
+          std::memcpy (&size, buffer, 4);
+          std::memcpy (&nanoSeconds, buffer + 4, 8);
+          std::memcpy (&node, buffer + 12, 4);
+          std::memcpy (&dev, buffer + 16, 4);
+          buffer += PACKET_HEADER_SIZE;
+          NS_ASSERT (buffer + size <= end);
+
+          Time rxTime = NanoSeconds (nanoSeconds);
+
+          Ptr<Packet> p = Create<Packet> (buffer, size, true);
+          buffer += size;
+
+          // Find the correct node/device to schedule receive event
+          Ptr<Node> pNode = NodeList::GetNode (node);
+          Ptr<MpiReceiver> pMpiRec = 0;
+          uint32_t nDevices = pNode->GetNDevices ();
+          for (uint32_t i = 0; i < nDevices; ++i)
             {
-              pMpiRec = pThisDev->GetObject<MpiReceiver> ();
-              break;
+              Ptr<NetDevice> pThisDev = pNode->GetDevice (i);
+              if (pThisDev->GetIfIndex () == dev)
+                {
+                  pMpiRec = pThisDev->GetObject<MpiReceiver> ();
+                  break;
+                }
             }
-        }
 
-      NS_ASSERT (pNode && pMpiRec);
+          NS_ASSERT (pNode && pMpiRec);
 
-      // Schedule the rx event
-      Simulator::ScheduleWithContext (pNode->GetId (), rxTime - Simulator::Now (),
-                                      &MpiReceiver::Receive, pMpiRec, p);
+          // Schedule the rx event
+          Simulator::ScheduleWithContext (pNode->GetId (), rxTime - Simulator::Now (),
+                                          &MpiReceiver::Receive, pMpiRec, p);
+        }
 
       // Re-queue the next read
-      MPI_Irecv (m_pRxBuffers[index], MAX_MPI_MSG_SIZE, MPI_CHAR, MPI_ANY_SOURCE, 0,
+      MPI_Irecv (m_pRxBuffers[index], MAX_MPI_AGGREGATE_SIZE, MPI_CHAR, MPI_ANY_SOURCE, 0,
                  MPI_COMM_WORLD, &m_requests[index]);
     }
 #else
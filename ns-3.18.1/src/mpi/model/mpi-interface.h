@@ -50,6 +50,12 @@ namespace ns3 {
  */
 const uint32_t MAX_MPI_MSG_SIZE = 2000;
 
+/**
+ * maximum size of the MPI messages carrying several packets
+ * aggregated for the same rank
+ */
+const uint32_t MAX_MPI_AGGREGATE_SIZE = 65536;
+
 /**
  * \ingroup mpi
  *
@@ -124,9 +130,17 @@ public:
    * \param node destination node
    * \param dev destination device
    *
-   * Serialize and send a packet to the specified node and net device
+   * Serialize a packet for the specified node and net device in the
+   * aggregation buffer of its rank.  The buffer is sent when it is
+   * full or when FlushSendBuffers () is called.
    */
   static void SendPacket (Ptr<Packet> p, const Time &rxTime, uint32_t node, uint32_t dev);
+  /**
+   * Send the packets aggregated for each rank.  This must be called
+   * before each synchronization, so that every packet sent during a
+   * time window is on its way when the next window is computed.
+   */
+  static void FlushSendBuffers ();
   /**
    * Check for received messages complete
    */
@@ -164,6 +178,15 @@ private:
 
   // List of pending non-blocking sends
   static std::list<SentBuffer> m_pendingTx;
+
+  // Send the aggregation buffer of a rank
+  static void FlushSendBuffer (uint32_t rank);
+
+  // Aggregation buffers for the packets sent to each rank
+  static uint8_t** m_pTxBuffers;
+
+  // Number of bytes used in each aggregation buffer
+  static uint32_t* m_txBufferSizes;
 };
 
 } // namespace ns3
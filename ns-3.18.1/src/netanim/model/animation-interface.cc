@@ -55,6 +55,27 @@ namespace ns3 {
 
 #define PURGE_INTERVAL 5
 
+// Binary trace format: the magic string is followed by a sequence of
+// records, each starting with a one byte record type.  Raw records carry
+// XML text verbatim; packet records carry the node ids and the four
+// packet times as zig-zag varints, relative to the previous packet.
+static const char ANIM_BINARY_MAGIC[] = "NS3ANIMB";
+static const uint32_t ANIM_BINARY_MAGIC_LEN = 8;
+static const size_t ANIM_BINARY_FLUSH_THRESHOLD = 65536;
+
+enum AnimBinaryRecordType
+{
+  ANIM_BINARY_RECORD_RAW = 1,
+  ANIM_BINARY_RECORD_PACKET = 2
+};
+
+enum AnimBinaryPacketFlag
+{
+  ANIM_BINARY_FLAG_WIRELESS = 0x01,
+  ANIM_BINARY_FLAG_META = 0x02,
+  ANIM_BINARY_FLAG_AUX = 0x04
+};
+
 static bool initialized = false;
 std::map <uint32_t, std::string> AnimationInterface::nodeDescriptions;
 std::map <uint32_t, Rgb> AnimationInterface::nodeColors;
@@ -62,8 +83,79 @@ std::map <P2pLinkNodeIdPair, LinkProperties, LinkPairCompare> AnimationInterface
 Rectangle * AnimationInterface::userBoundary = 0;
 
 
+static int64_t
+SecondsToNs (double t)
+{
+  return static_cast<int64_t> (t * 1e9 + (t < 0 ? -0.5 : 0.5));
+}
+
+static uint64_t
+ZigZagEncode (int64_t v)
+{
+  return (static_cast<uint64_t> (v) << 1) ^ static_cast<uint64_t> (v >> 63);
+}
+
+static int64_t
+ZigZagDecode (uint64_t v)
+{
+  return static_cast<int64_t> (v >> 1) ^ -static_cast<int64_t> (v & 1);
+}
+
+static bool
+ReadVarint (const std::vector<uint8_t> &data, size_t &pos, uint64_t &value)
+{
+  value = 0;
+  for (uint32_t shift = 0; shift < 64; shift += 7)
+    {
+      if (pos >= data.size ())
+        {
+          return false;
+        }
+      uint8_t byte = data[pos++];
+      value |= static_cast<uint64_t> (byte & 0x7f) << shift;
+      if (!(byte & 0x80))
+        {
+          return true;
+        }
+    }
+  return false;
+}
+
+static bool
+ReadFileContents (std::string fileName, std::vector<uint8_t> &data)
+{
+  FILE * in = std::fopen (fileName.c_str (), "rb");
+  if (!in)
+    {
+      return false;
+    }
+  uint8_t chunk[65536];
+  size_t n;
+  while ((n = std::fread (chunk, 1, sizeof (chunk), in)) > 0)
+    {
+      data.insert (data.end (), chunk, chunk + n);
+    }
+  std::fclose (in);
+  return true;
+}
+
+static bool
+ReadString (const std::vector<uint8_t> &data, size_t &pos, std::string &st)
+{
+  uint64_t len;
+  if (!ReadVarint (data, pos, len) || len > data.size () - pos)
+    {
+      return false;
+    }
+  st.assign (reinterpret_cast<const char *> (&data[pos]), len);
+  pos += len;
+  return true;
+}
+
 AnimationInterface::AnimationInterface (const std::string fn, uint64_t maxPktsPerFile, bool usingXML)
-  : m_routingF (0), m_xml (usingXML), m_mobilityPollInterval (Seconds(0.25)), 
+  : m_routingF (0), m_xml (usingXML), m_binary (false), m_lastFbTxNs (0),
+    m_samplingInterval (1),
+    m_mobilityPollInterval (Seconds(0.25)), 
     m_outputFileName (fn),
     m_outputFileSet (false), gAnimUid (0), m_randomPosition (true),
     m_writeCallback (0), m_started (false), 
@@ -295,6 +387,35 @@ void AnimationInterface::SetXMLOutput ()
   m_xml = true;
 }
 
+void AnimationInterface::SetBinaryOutput ()
+{
+  NS_LOG_INFO ("Binary output set");
+  if (m_binary)
+    {
+      return;
+    }
+  NS_ASSERT_MSG (m_xml, "The binary trace format requires XML output");
+  // The constructor has already written the preamble and the topology as XML
+  // text.  Start the file over with the binary header and carry that text
+  // over as a raw record
+  std::fclose (m_f);
+  std::vector<uint8_t> written;
+  ReadFileContents (m_outputFileName, written);
+  m_f = std::fopen (m_outputFileName.c_str (), "w");
+  if (!m_f)
+    {
+      NS_FATAL_ERROR ("Unable to open Animation output file");
+    }
+  std::setvbuf (m_f, 0, _IOFBF, 1 << 20);
+  m_binary = true;
+  WriteBinaryHeader ();
+  if (!written.empty ())
+    {
+      m_binaryBuffer.push_back (ANIM_BINARY_RECORD_RAW);
+      WriteBinaryString (std::string (written.begin (), written.end ()));
+    }
+}
+
 
 void AnimationInterface::StartNewTraceFile ()
 {
@@ -318,6 +439,18 @@ std::string AnimationInterface::GetNetAnimVersion ()
   return "netanim-3.103";
 }
 
+void AnimationInterface::SetPacketSampling (uint32_t interval)
+{
+  NS_ASSERT (interval > 0);
+  m_samplingInterval = interval;
+}
+
+bool AnimationInterface::IsSampled (uint64_t animUid)
+{
+  // Keyed on the packet, so that every receiver of a sampled packet is recorded
+  return (animUid % m_samplingInterval) == 0;
+}
+
 void AnimationInterface::SetStartTime (Time t)
 {
   m_startTime = t;
@@ -341,8 +474,15 @@ bool AnimationInterface::SetOutputFile (const std::string& fn)
       NS_FATAL_ERROR ("Unable to open Animation output file");
       return false; // Can't open
     }
+  // Packet records are small and frequent; a large stdio buffer keeps
+  // the number of write system calls low
+  std::setvbuf (m_f, 0, _IOFBF, 1 << 20);
   m_outputFileName = fn;
   m_outputFileSet = true;
+  if (m_binary)
+    {
+      WriteBinaryHeader ();
+    }
   return true;
 }
 
@@ -861,6 +1001,7 @@ void AnimationInterface::StopAnimation (bool onlyAnimation)
         { // Terminate the anim element
           WriteN (GetXMLClose ("anim"), m_f);
         }
+      FlushBinary ();
       std::fclose (m_f);
     }
     m_outputFileSet = false;
@@ -881,9 +1022,178 @@ int AnimationInterface::WriteN (const std::string& st, FILE * f)
     {
       m_writeCallback (st.c_str ());
     }
+  if (m_binary && f == m_f)
+    {
+      m_binaryBuffer.push_back (ANIM_BINARY_RECORD_RAW);
+      WriteBinaryString (st);
+      if (m_binaryBuffer.size () >= ANIM_BINARY_FLUSH_THRESHOLD)
+        {
+          FlushBinary ();
+        }
+      return st.length ();
+    }
   return WriteN (st.c_str (), st.length (), f);
 }
 
+void AnimationInterface::WritePacket (std::string pktType, uint32_t fId, double fbTx, double lbTx,
+                                      uint32_t tId, double fbRx, double lbRx, std::string metaInfo,
+                                      std::string auxInfo)
+{
+  if (!m_binary)
+    {
+      WriteN (GetXMLOpenClose_p (pktType, fId, fbTx, lbTx, tId, fbRx, lbRx, metaInfo, auxInfo), m_f);
+      return;
+    }
+  if (m_writeCallback)
+    {
+      m_writeCallback (GetXMLOpenClose_p (pktType, fId, fbTx, lbTx, tId, fbRx, lbRx, metaInfo, auxInfo).c_str ());
+    }
+  int64_t fbTxNs = SecondsToNs (fbTx);
+  uint8_t flags = 0;
+  if (pktType == "wp")
+    {
+      flags |= ANIM_BINARY_FLAG_WIRELESS;
+    }
+  else
+    {
+      NS_ASSERT (pktType == "p");
+    }
+  if (!metaInfo.empty ())
+    {
+      flags |= ANIM_BINARY_FLAG_META;
+    }
+  if (!auxInfo.empty ())
+    {
+      flags |= ANIM_BINARY_FLAG_AUX;
+    }
+  m_binaryBuffer.push_back (ANIM_BINARY_RECORD_PACKET);
+  m_binaryBuffer.push_back (flags);
+  WriteBinaryVarint (fId);
+  WriteBinaryVarint (tId);
+  WriteBinaryVarint (ZigZagEncode (fbTxNs - m_lastFbTxNs));
+  WriteBinaryVarint (ZigZagEncode (SecondsToNs (lbTx) - fbTxNs));
+  WriteBinaryVarint (ZigZagEncode (SecondsToNs (fbRx) - fbTxNs));
+  WriteBinaryVarint (ZigZagEncode (SecondsToNs (lbRx) - SecondsToNs (fbRx)));
+  if (!metaInfo.empty ())
+    {
+      WriteBinaryString (metaInfo);
+    }
+  if (!auxInfo.empty ())
+    {
+      WriteBinaryString (auxInfo);
+    }
+  m_lastFbTxNs = fbTxNs;
+  if (m_binaryBuffer.size () >= ANIM_BINARY_FLUSH_THRESHOLD)
+    {
+      FlushBinary ();
+    }
+}
+
+void AnimationInterface::WriteBinaryHeader ()
+{
+  m_binaryBuffer.clear ();
+  m_lastFbTxNs = 0;
+  WriteN (ANIM_BINARY_MAGIC, ANIM_BINARY_MAGIC_LEN, m_f);
+}
+
+void AnimationInterface::WriteBinaryVarint (uint64_t value)
+{
+  while (value >= 0x80)
+    {
+      m_binaryBuffer.push_back (static_cast<uint8_t> (value | 0x80));
+      value >>= 7;
+    }
+  m_binaryBuffer.push_back (static_cast<uint8_t> (value));
+}
+
+void AnimationInterface::WriteBinaryString (const std::string& st)
+{
+  WriteBinaryVarint (st.length ());
+  m_binaryBuffer.insert (m_binaryBuffer.end (), st.begin (), st.end ());
+}
+
+void AnimationInterface::FlushBinary ()
+{
+  if (m_binaryBuffer.empty ())
+    {
+      return;
+    }
+  WriteN (reinterpret_cast<const char *> (&m_binaryBuffer[0]), m_binaryBuffer.size (), m_f);
+  m_binaryBuffer.clear ();
+}
+
+bool AnimationInterface::ConvertBinaryToXml (std::string binaryFileName, std::string xmlFileName)
+{
+  std::vector<uint8_t> data;
+  if (!ReadFileContents (binaryFileName, data))
+    {
+      NS_FATAL_ERROR ("Unable to open binary Animation trace file " << binaryFileName);
+      return false;
+    }
+  if (data.size () < ANIM_BINARY_MAGIC_LEN
+      || std::string (reinterpret_cast<const char *> (&data[0]), ANIM_BINARY_MAGIC_LEN) != ANIM_BINARY_MAGIC)
+    {
+      NS_LOG_WARN ("Not a binary Animation trace file:" << binaryFileName);
+      return false;
+    }
+
+  FILE * out = std::fopen (xmlFileName.c_str (), "w");
+  if (!out)
+    {
+      NS_FATAL_ERROR ("Unable to open Animation output file " << xmlFileName);
+      return false;
+    }
+  std::setvbuf (out, 0, _IOFBF, 1 << 20);
+  size_t pos = ANIM_BINARY_MAGIC_LEN;
+  int64_t lastFbTxNs = 0;
+  bool ok = true;
+  while (ok && pos < data.size ())
+    {
+      uint8_t type = data[pos++];
+      if (type == ANIM_BINARY_RECORD_RAW)
+        {
+          std::string st;
+          ok = ReadString (data, pos, st);
+          if (ok)
+            {
+              std::fwrite (st.c_str (), 1, st.length (), out);
+            }
+        }
+      else if (type == ANIM_BINARY_RECORD_PACKET && pos < data.size ())
+        {
+          uint8_t flags = data[pos++];
+          uint64_t fId, tId, fbTxDelta, lbTxDelta, fbRxDelta, lbRxDelta;
+          std::string metaInfo, auxInfo;
+          ok = ReadVarint (data, pos, fId) && ReadVarint (data, pos, tId)
+            && ReadVarint (data, pos, fbTxDelta) && ReadVarint (data, pos, lbTxDelta)
+            && ReadVarint (data, pos, fbRxDelta) && ReadVarint (data, pos, lbRxDelta)
+            && (!(flags & ANIM_BINARY_FLAG_META) || ReadString (data, pos, metaInfo))
+            && (!(flags & ANIM_BINARY_FLAG_AUX) || ReadString (data, pos, auxInfo));
+          if (ok)
+            {
+              int64_t fbTxNs = lastFbTxNs + ZigZagDecode (fbTxDelta);
+              int64_t fbRxNs = fbTxNs + ZigZagDecode (fbRxDelta);
+              std::string st = GetXMLOpenClose_p ((flags & ANIM_BINARY_FLAG_WIRELESS) ? "wp" : "p",
+                                                  fId, fbTxNs / 1e9, (fbTxNs + ZigZagDecode (lbTxDelta)) / 1e9,
+                                                  tId, fbRxNs / 1e9, (fbRxNs + ZigZagDecode (lbRxDelta)) / 1e9,
+                                                  metaInfo, auxInfo);
+              std::fwrite (st.c_str (), 1, st.length (), out);
+              lastFbTxNs = fbTxNs;
+            }
+        }
+      else
+        {
+          ok = false;
+        }
+    }
+  std::fclose (out);
+  if (!ok)
+    {
+      NS_LOG_WARN ("Truncated or malformed binary Animation trace file:" << binaryFileName);
+    }
+  return ok;
+}
+
 std::vector <Ptr <Node> >  AnimationInterface::RecalcTopoBounds ()
 {
   std::vector < Ptr <Node> > MovedNodes;
@@ -947,13 +1257,11 @@ int AnimationInterface::WriteN (const char* data, uint32_t count, FILE * f)
 void AnimationInterface::WriteDummyPacket ()
 {
   Time now = Simulator::Now ();
-  std::ostringstream oss;
   double fbTx = now.GetSeconds ();
   double lbTx = now.GetSeconds ();
   double fbRx = now.GetSeconds ();
   double lbRx = now.GetSeconds ();
-  oss << GetXMLOpenClose_p ("p", 0, fbTx, lbTx, 0, fbRx, lbRx, "", "DummyPktIgnoreThis");
-  WriteN (oss.str (), m_f);
+  WritePacket ("p", 0, fbTx, lbTx, 0, fbRx, lbRx, "", "DummyPktIgnoreThis");
 
 
 }
@@ -987,23 +1295,28 @@ void AnimationInterface::DevTxTrace (std::string context, Ptr<const Packet> p,
 {
   if (!m_started || !IsInTimeWindow ())
     return;
+  // Point-to-point packets are not tagged, but take a uid so that they are
+  // sampled like the packets of the other devices
+  gAnimUid++;
+  if (!IsSampled (gAnimUid))
+    return;
   NS_ASSERT (tx);
   NS_ASSERT (rx);
   Time now = Simulator::Now ();
-  std::ostringstream oss;
   double fbTx = now.GetSeconds ();
   double lbTx = (now + txTime).GetSeconds ();
   double fbRx = (now + rxTime - txTime).GetSeconds ();
   double lbRx = (now + rxTime).GetSeconds ();
   if (m_xml)
     {
-      oss << GetXMLOpenClose_p ("p", tx->GetNode ()->GetId (), fbTx, lbTx, rx->GetNode ()->GetId (), 
-                                fbRx, lbRx, m_enablePacketMetadata? GetPacketMetadata (p):"");
+      WritePacket ("p", tx->GetNode ()->GetId (), fbTx, lbTx, rx->GetNode ()->GetId (),
+                   fbRx, lbRx, m_enablePacketMetadata? GetPacketMetadata (p):"");
       StartNewTraceFile ();
       ++m_currentPktCount;
     }
   else
     {
+      std::ostringstream oss;
       oss << std::setprecision (10);
       oss << now.GetSeconds () << " P "
           << tx->GetNode ()->GetId () << " "
@@ -1011,8 +1324,8 @@ void AnimationInterface::DevTxTrace (std::string context, Ptr<const Packet> p,
           << (now + txTime).GetSeconds () << " " // last bit tx time
           << (now + rxTime - txTime).GetSeconds () << " " // first bit rx time
           << (now + rxTime).GetSeconds () << std::endl;         // last bit rx time
+      WriteN (oss.str (), m_f);
     }
-  WriteN (oss.str (), m_f);
 }
 
 
@@ -1119,7 +1432,7 @@ void AnimationInterface::UanPhyGenRxTrace (std::string context, Ptr<const Packet
     }
   m_pendingUanPackets[AnimUid].ProcessRxBegin (ndev, Simulator::Now ());
   m_pendingUanPackets[AnimUid].ProcessRxEnd (ndev, Simulator::Now (), UpdatePosition (n));
-  OutputWirelessPacket (p, m_pendingUanPackets[AnimUid], m_pendingUanPackets[AnimUid].GetRxInfo (ndev));
+  OutputWirelessPacket (p, AnimUid, m_pendingUanPackets[AnimUid], m_pendingUanPackets[AnimUid].GetRxInfo (ndev));
 
 }
 
@@ -1204,7 +1517,7 @@ void AnimationInterface::WifiPhyRxBeginTrace (std::string context,
   /// \todo NS_ASSERT (WifiPacketIsPending (AnimUid) == true);
   m_pendingWifiPackets[AnimUid].ProcessRxBegin (ndev, Simulator::Now ());
   m_pendingWifiPackets[AnimUid].ProcessRxEnd (ndev, Simulator::Now (), UpdatePosition (n));
-  OutputWirelessPacket (p, m_pendingWifiPackets[AnimUid], m_pendingWifiPackets[AnimUid].GetRxInfo (ndev));
+  OutputWirelessPacket (p, AnimUid, m_pendingWifiPackets[AnimUid], m_pendingWifiPackets[AnimUid].GetRxInfo (ndev));
 }
 
 
@@ -1231,7 +1544,7 @@ void AnimationInterface::WifiPhyRxEndTrace (std::string context,
   if (pktrxInfo.IsPhyRxComplete ())
     {
       NS_LOG_INFO ("MacRxTrace for packet:" << AnimUid << " complete");
-      OutputWirelessPacket (p, pktInfo, pktrxInfo);
+      OutputWirelessPacket (p, AnimUid, pktInfo, pktrxInfo);
     }
 }
 
@@ -1256,7 +1569,7 @@ void AnimationInterface::WifiMacRxTrace (std::string context,
   if (pktrxInfo.IsPhyRxComplete ())
     {
       NS_LOG_INFO ("MacRxTrace for packet:" << AnimUid << " complete");
-      OutputWirelessPacket (p, pktInfo, pktrxInfo);
+      OutputWirelessPacket (p, AnimUid, pktInfo, pktrxInfo);
     }
 
 }
@@ -1300,7 +1613,7 @@ void AnimationInterface::WimaxRxTrace (std::string context, Ptr<const Packet> p,
   pktInfo.ProcessRxEnd (ndev, Simulator::Now () + Seconds (0.001), UpdatePosition (n));
   /// \todo 0.001 is used until Wimax implements RxBegin and RxEnd traces
   AnimRxInfo pktrxInfo = pktInfo.GetRxInfo (ndev);
-  OutputWirelessPacket (p, pktInfo, pktrxInfo);
+  OutputWirelessPacket (p, AnimUid, pktInfo, pktrxInfo);
 }
 
 void AnimationInterface::LteTxTrace (std::string context, Ptr<const Packet> p, const Mac48Address & m)
@@ -1342,7 +1655,7 @@ void AnimationInterface::LteRxTrace (std::string context, Ptr<const Packet> p, c
   pktInfo.ProcessRxEnd (ndev, Simulator::Now () + Seconds (0.001), UpdatePosition (n));
   /// \todo 0.001 is used until Lte implements RxBegin and RxEnd traces
   AnimRxInfo pktrxInfo = pktInfo.GetRxInfo (ndev);
-  OutputWirelessPacket (p, pktInfo, pktrxInfo);
+  OutputWirelessPacket (p, AnimUid, pktInfo, pktrxInfo);
 }
 
 void AnimationInterface::LteSpectrumPhyTxStart (std::string context, Ptr<const PacketBurst> pb)
@@ -1410,7 +1723,7 @@ void AnimationInterface::LteSpectrumPhyRxStart (std::string context, Ptr<const P
     pktInfo.ProcessRxEnd (ndev, Simulator::Now () + Seconds (0.001), UpdatePosition (n));
     /// \todo 0.001 is used until Lte implements RxBegin and RxEnd traces
     AnimRxInfo pktrxInfo = pktInfo.GetRxInfo (ndev);
-    OutputWirelessPacket (p, pktInfo, pktrxInfo);
+    OutputWirelessPacket (p, AnimUid, pktInfo, pktrxInfo);
   }
 }
 
@@ -1477,7 +1790,7 @@ void AnimationInterface::CsmaPhyRxEndTrace (std::string context, Ptr<const Packe
   if (pktrxInfo.IsPhyRxComplete ())
     {
       NS_LOG_INFO ("CsmaPhyRxEndTrace for packet:" << AnimUid << " complete");
-      OutputCsmaPacket (p, pktInfo, pktrxInfo);
+      OutputCsmaPacket (p, AnimUid, pktInfo, pktrxInfo);
     }
 }
 
@@ -1504,7 +1817,7 @@ void AnimationInterface::CsmaMacRxTrace (std::string context,
   if (pktrxInfo.IsPhyRxComplete ())
     {
       NS_LOG_INFO ("MacRxTrace for packet:" << AnimUid << " complete");
-      OutputCsmaPacket (p, pktInfo, pktrxInfo);
+      OutputCsmaPacket (p, AnimUid, pktInfo, pktrxInfo);
     }
 }
 
@@ -1658,11 +1971,12 @@ std::string AnimationInterface::GetPreamble ()
 return s;
 }
 
-void AnimationInterface::OutputWirelessPacket (Ptr<const Packet> p, AnimPacketInfo &pktInfo, AnimRxInfo pktrxInfo)
+void AnimationInterface::OutputWirelessPacket (Ptr<const Packet> p, uint64_t animUid, AnimPacketInfo &pktInfo, AnimRxInfo pktrxInfo)
 {
+  if (!IsSampled (animUid))
+    return;
   StartNewTraceFile ();
   NS_ASSERT (m_xml);
-  std::ostringstream oss;
   uint32_t nodeId =  0;
   if (pktInfo.m_txnd)
     nodeId = pktInfo.m_txnd->GetNode ()->GetId ();
@@ -1672,23 +1986,22 @@ void AnimationInterface::OutputWirelessPacket (Ptr<const Packet> p, AnimPacketIn
   double lbTx = pktInfo.firstlastbitDelta + pktInfo.m_fbTx;
   uint32_t rxId = pktrxInfo.m_rxnd->GetNode ()->GetId ();
 
-  oss << GetXMLOpenClose_p ("wp", nodeId, pktInfo.m_fbTx, lbTx, rxId,
-                            pktrxInfo.m_fbRx, pktrxInfo.m_lbRx, m_enablePacketMetadata? GetPacketMetadata (p):"");
-  WriteN (oss.str (), m_f);
+  WritePacket ("wp", nodeId, pktInfo.m_fbTx, lbTx, rxId,
+               pktrxInfo.m_fbRx, pktrxInfo.m_lbRx, m_enablePacketMetadata? GetPacketMetadata (p):"");
 }
 
-void AnimationInterface::OutputCsmaPacket (Ptr<const Packet> p, AnimPacketInfo &pktInfo, AnimRxInfo pktrxInfo)
+void AnimationInterface::OutputCsmaPacket (Ptr<const Packet> p, uint64_t animUid, AnimPacketInfo &pktInfo, AnimRxInfo pktrxInfo)
 {
+  if (!IsSampled (animUid))
+    return;
   StartNewTraceFile ();
   NS_ASSERT (m_xml);
-  std::ostringstream oss;
   NS_ASSERT (pktInfo.m_txnd);
   uint32_t nodeId = pktInfo.m_txnd->GetNode ()->GetId ();
   uint32_t rxId = pktrxInfo.m_rxnd->GetNode ()->GetId ();
 
-  oss << GetXMLOpenClose_p ("p", nodeId, pktInfo.m_fbTx, pktInfo.m_lbTx, rxId,
-                            pktrxInfo.m_fbRx, pktrxInfo.m_lbRx, m_enablePacketMetadata? GetPacketMetadata (p):"");
-  WriteN (oss.str (), m_f);
+  WritePacket ("p", nodeId, pktInfo.m_fbTx, pktInfo.m_lbTx, rxId,
+               pktrxInfo.m_fbRx, pktrxInfo.m_lbRx, m_enablePacketMetadata? GetPacketMetadata (p):"");
 }
 
 void AnimationInterface::SetConstantPosition (Ptr <Node> n, double x, double y, double z)
@@ -24,6 +24,7 @@
 #include <string>
 #include <cstdio>
 #include <map>
+#include <vector>
 #include "ns3/ptr.h"
 #include "ns3/net-device.h"
 #include "ns3/node-container.h"
@@ -153,6 +154,16 @@ public:
    */
   AnimationInterface & EnableIpv4RouteTracking (std::string fileName, Time startTime, Time stopTime, NodeContainer nc, Time pollInterval = Seconds(5));
 
+  /**
+   * \brief Convert a binary trace written by AnimationInterface to XML
+   * \param binaryFileName The binary trace file
+   * \param xmlFileName The XML trace file to create
+   *
+   * \returns true if the whole binary trace was converted, false if it was
+   * truncated or malformed
+   */
+  static bool ConvertBinaryToXml (std::string binaryFileName, std::string xmlFileName);
+
   /**
    * \brief Check if AnimationInterface is initialized
    * \returns true if AnimationInterface was already initialized
@@ -188,6 +199,30 @@ public:
    */
   void SetMobilityPollInterval (Time t);
 
+  /**
+   * \brief Record only one out of every interval packets
+   *
+   * \param interval Sampling interval. 1 (default) records every packet.
+   * Large simulations can use this to keep the trace manageable. The
+   * decision is made once per transmitted packet, so a sampled packet is
+   * recorded at all of its receivers
+   *
+   */
+  void SetPacketSampling (uint32_t interval);
+
+  /**
+   * \brief Write a compact binary trace instead of XML text
+   *
+   * Only packet records are stored as delta-encoded varints; all other
+   * elements, such as node and link updates, are stored as raw XML text.
+   * The trace is not compressed, compress the file with an external
+   * tool if needed. Use ConvertBinaryToXml to obtain an XML trace that can be
+   * loaded by NetAnim. Requires XML output and should be called before
+   * Simulator::Run
+   *
+   */
+  void SetBinaryOutput ();
+
   /**
    * \brief Set random position if a Mobility Model does not exists for the node
    *
@@ -426,6 +461,10 @@ private:
   // Write specified amount of data to the specified handle
   int WriteN (const char*, uint32_t, FILE * f);
   bool m_xml;      // True if xml format desired
+  bool m_binary;   // True if the binary trace format is desired
+  std::vector<uint8_t> m_binaryBuffer; // Pending binary records for m_f
+  int64_t m_lastFbTxNs; // Previous packet first bit tx time, for delta encoding
+  uint32_t m_samplingInterval;
   Time m_mobilityPollInterval;
   std::string m_outputFileName;
   bool m_outputFileSet;
@@ -547,8 +586,17 @@ private:
   // Write a string to the specified handle;
   int  WriteN (const std::string&, FILE * f);
 
-  void OutputWirelessPacket (Ptr<const Packet> p, AnimPacketInfo& pktInfo, AnimRxInfo pktrxInfo);
-  void OutputCsmaPacket (Ptr<const Packet> p, AnimPacketInfo& pktInfo, AnimRxInfo pktrxInfo);
+  // Binary trace helpers
+  bool IsSampled (uint64_t animUid);
+  void WritePacket (std::string pktType, uint32_t fId, double fbTx, double lbTx, uint32_t tId, double fbRx, double lbRx,
+                    std::string metaInfo = "", std::string auxInfo = "");
+  void WriteBinaryHeader ();
+  void WriteBinaryString (const std::string& st);
+  void WriteBinaryVarint (uint64_t value);
+  void FlushBinary ();
+
+  void OutputWirelessPacket (Ptr<const Packet> p, uint64_t animUid, AnimPacketInfo& pktInfo, AnimRxInfo pktrxInfo);
+  void OutputCsmaPacket (Ptr<const Packet> p, uint64_t animUid, AnimPacketInfo& pktInfo, AnimRxInfo pktrxInfo);
   void MobilityAutoCheck ();
   
 
@@ -641,8 +689,8 @@ private:
   std::string GetXMLOpenClose_link (uint32_t fromLp, uint32_t fromId, uint32_t toLp, uint32_t toId);
   std::string GetXMLOpenClose_linkupdate (uint32_t fromId, uint32_t toId, std::string);
   std::string GetXMLOpen_packet (uint32_t fromLp, uint32_t fromId, double fbTx, double lbTx, std::string auxInfo = "");
-  std::string GetXMLOpenClose_p (std::string pktType, uint32_t fId, double fbTx, double lbTx, uint32_t tId, double fbRx, double lbRx,
-                                 std::string metaInfo = "", std::string auxInfo = "");
+  static std::string GetXMLOpenClose_p (std::string pktType, uint32_t fId, double fbTx, double lbTx, uint32_t tId, double fbRx, double lbRx,
+                                        std::string metaInfo = "", std::string auxInfo = "");
   std::string GetXMLOpenClose_rx (uint32_t toLp, uint32_t toId, double fbRx, double lbRx);
   std::string GetXMLOpen_wpacket (uint32_t fromLp, uint32_t fromId, double fbTx, double lbTx, double range);
   std::string GetXMLClose (std::string name) {return "</" + name + ">\n"; }
@@ -17,12 +17,16 @@
  */
 
 #include <iostream>
+#include <cstdio>
+#include <fstream>
+#include <map>
 #include "unistd.h"
 
 #include "ns3/core-module.h"
 #include "ns3/network-module.h"
 #include "ns3/internet-module.h"
 #include "ns3/point-to-point-module.h"
+#include "ns3/csma-module.h"
 #include "ns3/netanim-module.h"
 #include "ns3/applications-module.h"
 #include "ns3/point-to-point-layout-module.h"
@@ -106,6 +110,216 @@ AnimationInterfaceTestCase::DoRun (void)
   Simulator::Destroy ();
 }
 
+class AnimationBinaryTraceTestCase : public TestCase
+{
+public:
+  AnimationBinaryTraceTestCase ();
+  virtual
+  ~AnimationBinaryTraceTestCase ();
+  virtual void
+  DoRun (void);
+
+private:
+  static void RunSimulation (std::string fileName, bool binary);
+  static std::string ReadFile (std::string fileName);
+};
+
+AnimationBinaryTraceTestCase::AnimationBinaryTraceTestCase () :
+  TestCase ("Verify the binary AnimationInterface trace converts back to the XML trace")
+{
+}
+
+AnimationBinaryTraceTestCase::~AnimationBinaryTraceTestCase ()
+{
+}
+
+void
+AnimationBinaryTraceTestCase::RunSimulation (std::string fileName, bool binary)
+{
+  NodeContainer nodes;
+  nodes.Create (2);
+  AnimationInterface::SetConstantPosition (nodes.Get (0), 0 , 10);
+  AnimationInterface::SetConstantPosition (nodes.Get (1), 1 , 10);
+
+  PointToPointHelper pointToPoint;
+  pointToPoint.SetDeviceAttribute ("DataRate", StringValue ("5Mbps"));
+  pointToPoint.SetChannelAttribute ("Delay", StringValue ("2ms"));
+  NetDeviceContainer devices = pointToPoint.Install (nodes);
+  // the traces of both runs hold the MAC addresses
+  devices.Get (0)->SetAddress (Mac48Address ("00:00:00:00:00:01"));
+  devices.Get (1)->SetAddress (Mac48Address ("00:00:00:00:00:02"));
+
+  InternetStackHelper stack;
+  stack.Install (nodes);
+  Ipv4AddressHelper address;
+  address.SetBase ("10.1.1.0", "255.255.255.0");
+  Ipv4InterfaceContainer interfaces = address.Assign (devices);
+
+  UdpEchoServerHelper echoServer (9);
+  ApplicationContainer serverApps = echoServer.Install (nodes.Get (1));
+  serverApps.Start (Seconds (1.0));
+  serverApps.Stop (Seconds (10.0));
+
+  UdpEchoClientHelper echoClient (interfaces.GetAddress (1), 9);
+  echoClient.SetAttribute ("MaxPackets", UintegerValue (100));
+  echoClient.SetAttribute ("Interval", TimeValue (Seconds (1.0)));
+  echoClient.SetAttribute ("PacketSize", UintegerValue (1024));
+  ApplicationContainer clientApps = echoClient.Install (nodes.Get (0));
+  clientApps.Start (Seconds (2.0));
+  clientApps.Stop (Seconds (10.0));
+
+  AnimationInterface * anim = new AnimationInterface (fileName);
+  if (binary)
+    {
+      anim->SetBinaryOutput ();
+    }
+  anim->EnablePacketMetadata (true);
+  Simulator::Run ();
+  delete anim;
+  Simulator::Destroy ();
+}
+
+std::string
+AnimationBinaryTraceTestCase::ReadFile (std::string fileName)
+{
+  std::string content;
+  FILE * fp = fopen (fileName.c_str (), "rb");
+  if (!fp)
+    {
+      return content;
+    }
+  char buf[4096];
+  size_t n;
+  while ((n = fread (buf, 1, sizeof (buf), fp)) > 0)
+    {
+      content.append (buf, n);
+    }
+  fclose (fp);
+  return content;
+}
+
+void
+AnimationBinaryTraceTestCase::DoRun (void)
+{
+  std::string xmlFileName = "netanim-test-reference.xml";
+  std::string binaryFileName = "netanim-test.bin";
+  std::string convertedFileName = "netanim-test-converted.xml";
+  RunSimulation (xmlFileName, false);
+  RunSimulation (binaryFileName, true);
+
+  std::string reference = ReadFile (xmlFileName);
+  NS_TEST_ASSERT_MSG_EQ (reference.empty (), false, "XML trace file was not created");
+  std::string binary = ReadFile (binaryFileName);
+  NS_TEST_ASSERT_MSG_EQ (binary.empty (), false, "Binary trace file was not created");
+  bool converted = AnimationInterface::ConvertBinaryToXml (binaryFileName, convertedFileName);
+  NS_TEST_ASSERT_MSG_EQ (converted, true, "Binary trace could not be converted");
+  std::string xml = ReadFile (convertedFileName);
+  NS_TEST_ASSERT_MSG_EQ (xml, reference, "Converted trace differs from the XML trace");
+  NS_TEST_ASSERT_MSG_LT (binary.size (), xml.size (), "Binary trace is not smaller than the XML trace");
+  unlink (xmlFileName.c_str ());
+  unlink (binaryFileName.c_str ());
+  unlink (convertedFileName.c_str ());
+}
+
+class AnimationSamplingTestCase : public TestCase
+{
+public:
+  AnimationSamplingTestCase ();
+  virtual
+  ~AnimationSamplingTestCase ();
+  virtual void
+  DoRun (void);
+
+private:
+  typedef std::map<std::string, uint32_t> ReceiversPerTx;
+  static ReceiversPerTx RunSimulation (std::string fileName, uint32_t interval);
+};
+
+AnimationSamplingTestCase::AnimationSamplingTestCase () :
+  TestCase ("Verify that packet sampling records a sampled packet at all of its receivers")
+{
+}
+
+AnimationSamplingTestCase::~AnimationSamplingTestCase ()
+{
+}
+
+AnimationSamplingTestCase::ReceiversPerTx
+AnimationSamplingTestCase::RunSimulation (std::string fileName, uint32_t interval)
+{
+  NodeContainer nodes;
+  nodes.Create (4);
+  for (uint32_t i = 0; i < nodes.GetN (); i++)
+    {
+      AnimationInterface::SetConstantPosition (nodes.Get (i), i, 10);
+    }
+  CsmaHelper csma;
+  NetDeviceContainer devices = csma.Install (nodes);
+
+  InternetStackHelper stack;
+  stack.Install (nodes);
+  // both runs must see the same packets
+  int64_t stream = 1;
+  stream += csma.AssignStreams (devices, stream);
+  stack.AssignStreams (nodes, stream);
+  Ipv4AddressHelper address;
+  address.SetBase ("10.1.1.0", "255.255.255.0");
+  Ipv4InterfaceContainer interfaces = address.Assign (devices);
+
+  UdpEchoServerHelper echoServer (9);
+  ApplicationContainer serverApps = echoServer.Install (nodes.Get (1));
+  serverApps.Start (Seconds (1.0));
+  serverApps.Stop (Seconds (10.0));
+
+  UdpEchoClientHelper echoClient (interfaces.GetAddress (1), 9);
+  echoClient.SetAttribute ("MaxPackets", UintegerValue (100));
+  echoClient.SetAttribute ("Interval", TimeValue (Seconds (1.0)));
+  echoClient.SetAttribute ("PacketSize", UintegerValue (1024));
+  ApplicationContainer clientApps = echoClient.Install (nodes.Get (0));
+  clientApps.Start (Seconds (2.0));
+  clientApps.Stop (Seconds (10.0));
+
+  AnimationInterface * anim = new AnimationInterface (fileName);
+  anim->SetPacketSampling (interval);
+  Simulator::Run ();
+  delete anim;
+  Simulator::Destroy ();
+
+  // Count the receivers recorded for every transmission, keyed on the
+  // sender and the first bit transmit time
+  ReceiversPerTx receivers;
+  std::ifstream in (fileName.c_str ());
+  std::string line;
+  while (std::getline (in, line))
+    {
+      if (line.compare (0, 3, "<p ") != 0 || line.find ("DummyPktIgnoreThis") != std::string::npos)
+        {
+          continue;
+        }
+      receivers[line.substr (0, line.find (" lbTx="))]++;
+    }
+  in.close ();
+  unlink (fileName.c_str ());
+  return receivers;
+}
+
+void
+AnimationSamplingTestCase::DoRun (void)
+{
+  ReceiversPerTx all = RunSimulation ("netanim-test-sampling-all.xml", 1);
+  ReceiversPerTx sampled = RunSimulation ("netanim-test-sampling.xml", 2);
+
+  NS_TEST_ASSERT_MSG_GT (all.size (), 2, "Expected several CSMA transmissions");
+  NS_TEST_ASSERT_MSG_GT (sampled.size (), 0, "No packets were sampled");
+  NS_TEST_ASSERT_MSG_LT (sampled.size (), all.size (), "Sampling did not drop any packet");
+  for (ReceiversPerTx::const_iterator i = sampled.begin (); i != sampled.end (); i++)
+    {
+      ReceiversPerTx::const_iterator j = all.find (i->first);
+      NS_TEST_ASSERT_MSG_EQ ((j != all.end ()), true, "Sampled packet is missing from the full trace");
+      NS_TEST_EXPECT_MSG_EQ (i->second, j->second, "Sampled packet was not recorded at all of its receivers");
+    }
+}
+
 static class AnimationInterfaceTestSuite : public TestSuite
 {
 public:
@@ -113,6 +327,8 @@ public:
     TestSuite ("animation-interface", UNIT)
   {
     AddTestCase (new AnimationInterfaceTestCase (), TestCase::QUICK);
+    AddTestCase (new AnimationBinaryTraceTestCase (), TestCase::QUICK);
+    AddTestCase (new AnimationSamplingTestCase (), TestCase::QUICK);
   }
 } g_animationInterfaceTestSuite;
 
@@ -254,7 +254,7 @@ AsInt (std::string v)
   NS_LOG_FUNCTION_NOARGS ();
   std::istringstream iss;
   iss.str (v);
-  uint8_t retval;
+  uint32_t retval;
   iss >> std::hex >> retval >> std::dec;
   return retval;
 }
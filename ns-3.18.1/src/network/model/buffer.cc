@@ -20,6 +20,8 @@
 #include "buffer.h"
 #include "ns3/assert.h"
 #include "ns3/log.h"
+#include <algorithm>
+#include <cstring>
 
 NS_LOG_COMPONENT_DEFINE ("Buffer");
 
@@ -1161,15 +1163,91 @@ Buffer::Iterator::CalculateIpChecksum (uint16_t size)
   return CalculateIpChecksum (size, 0);
 }
 
+/**
+ * \returns the one's complement sum of the 16 bit words of a contiguous
+ * memory area, in the byte order of ReadU16, not folded.
+ *
+ * The words are summed eight bytes at a time in host byte order and the
+ * result is converted back once at the end: the one's complement sum
+ * does not depend on the byte order (RFC 1071, section 2.B).
+ */
+static uint32_t
+SumIpChecksumWords (uint8_t const *data, uint32_t size)
+{
+  uint64_t sum = 0;
+  while (size >= 8)
+    {
+      uint64_t words;
+      std::memcpy (&words, data, 8);
+      sum += (words & 0xffffffff) + (words >> 32);
+      data += 8;
+      size -= 8;
+    }
+  while (size >= 2)
+    {
+      uint16_t word;
+      std::memcpy (&word, data, 2);
+      sum += word;
+      data += 2;
+      size -= 2;
+    }
+  if (size == 1)
+    {
+      // an odd byte is the first byte of a word completed with zero
+      uint16_t word = 0;
+      std::memcpy (&word, data, 1);
+      sum += word;
+    }
+  while (sum >> 16)
+    {
+      sum = (sum & 0xffff) + (sum >> 16);
+    }
+  uint16_t folded = sum;
+  uint8_t bytes[2];
+  std::memcpy (bytes, &folded, 2);
+  return bytes[0] | (bytes[1] << 8);
+}
+
 uint16_t
 Buffer::Iterator::CalculateIpChecksum (uint16_t size, uint32_t initialChecksum)
 {
   NS_LOG_FUNCTION (this << size << initialChecksum);
+  NS_ASSERT_MSG (m_current >= m_dataStart && m_current + size <= m_dataEnd,
+                 GetReadErrorMessage ());
   /* see RFC 1071 to understand this code. */
-  uint32_t sum = initialChecksum;
-
-  for (int j = 0; j < size/2; j++)
-    sum += ReadU16 ();
+  uint64_t sum = initialChecksum;
+
+  // Sum the even part of the area zone by zone. A zone starting at an
+  // odd offset of the area sums its words shifted by one byte, which
+  // is fixed by swapping the bytes of its sum.
+  uint32_t end = m_current + (size & ~1);
+  bool odd = false;
+  while (m_current < end)
+    {
+      uint32_t zoneEnd;
+      uint32_t zoneSum = 0;
+      if (m_current < m_zeroStart)
+        {
+          zoneEnd = std::min (end, m_zeroStart);
+          zoneSum = SumIpChecksumWords (&m_data[m_current], zoneEnd - m_current);
+        }
+      else if (m_current < m_zeroEnd)
+        {
+          zoneEnd = std::min (end, m_zeroEnd);
+        }
+      else
+        {
+          zoneEnd = end;
+          zoneSum = SumIpChecksumWords (&m_data[m_current - (m_zeroEnd - m_zeroStart)], zoneEnd - m_current);
+        }
+      if (odd)
+        {
+          zoneSum = ((zoneSum & 0xff) << 8) | (zoneSum >> 8);
+        }
+      sum += zoneSum;
+      odd ^= (zoneEnd - m_current) & 1;
+      m_current = zoneEnd;
+    }
 
   if (size & 1)
     sum += ReadU8 ();
@@ -91,6 +91,7 @@ void
 Node::Construct (void)
 {
   NS_LOG_FUNCTION (this);
+  m_handlerCacheValid = false;
   m_id = NodeList::Add (this);
 }
 
@@ -174,6 +175,7 @@ Node::DoDispose ()
   NS_LOG_FUNCTION (this);
   m_deviceAdditionListeners.clear ();
   m_handlers.clear ();
+  m_handlerCache.clear ();
   for (std::vector<Ptr<NetDevice> >::iterator i = m_devices.begin ();
        i != m_devices.end (); i++)
     {
@@ -244,6 +246,7 @@ Node::RegisterProtocolHandler (ProtocolHandler handler,
     }
 
   m_handlers.push_back (entry);
+  m_handlerCacheValid = false;
 }
 
 void
@@ -256,6 +259,7 @@ Node::UnregisterProtocolHandler (ProtocolHandler handler)
       if (i->handler.IsEqual (handler))
         {
           m_handlers.erase (i);
+          m_handlerCacheValid = false;
           break;
         }
     }
@@ -297,26 +301,41 @@ Node::ReceiveFromDevice (Ptr<NetDevice> device, Ptr<const Packet> packet, uint16
   NS_LOG_DEBUG ("Node " << GetId () << " ReceiveFromDevice:  dev "
                         << device->GetIfIndex () << " (type=" << device->GetInstanceTypeId ().GetName ()
                         << ") Packet UID " << packet->GetUid ());
-  bool found = false;
+  const std::vector<uint32_t> &handlers = GetHandlers (device, protocol, promiscuous);
+  for (std::vector<uint32_t>::const_iterator i = handlers.begin ();
+       i != handlers.end (); i++)
+    {
+      m_handlers[*i].handler (device, packet, protocol, from, to, packetType);
+    }
+  return !handlers.empty ();
+}
 
-  for (ProtocolHandlerList::iterator i = m_handlers.begin ();
-       i != m_handlers.end (); i++)
+const std::vector<uint32_t>&
+Node::GetHandlers (Ptr<NetDevice> device, uint16_t protocol, bool promiscuous)
+{
+  if (!m_handlerCacheValid)
     {
-      if (i->device == 0 ||
-          (i->device != 0 && i->device == device))
+      m_handlerCache.clear ();
+      m_handlerCacheValid = true;
+    }
+  uint64_t key = (static_cast<uint64_t> (device->GetIfIndex ()) << 32) | (protocol << 1) | promiscuous;
+  ProtocolHandlerCache::iterator it = m_handlerCache.find (key);
+  if (it != m_handlerCache.end ())
+    {
+      return it->second;
+    }
+  std::vector<uint32_t> &handlers = m_handlerCache[key];
+  for (uint32_t i = 0; i < m_handlers.size (); i++)
+    {
+      const struct ProtocolHandlerEntry &entry = m_handlers[i];
+      if ((entry.device == 0 || entry.device == device)
+          && (entry.protocol == 0 || entry.protocol == protocol)
+          && entry.promiscuous == promiscuous)
         {
-          if (i->protocol == 0 || 
-              i->protocol == protocol)
-            {
-              if (promiscuous == i->promiscuous)
-                {
-                  i->handler (device, packet, protocol, from, to, packetType);
-                  found = true;
-                }
-            }
+          handlers.push_back (i);
         }
     }
-  return found;
+  return handlers;
 }
 void 
 Node::RegisterDeviceAdditionListener (DeviceAdditionListener listener)
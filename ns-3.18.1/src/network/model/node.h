@@ -22,6 +22,7 @@
 #define NODE_H
 
 #include <vector>
+#include <map>
 
 #include "ns3/object.h"
 #include "ns3/callback.h"
@@ -213,6 +214,13 @@ private:
 
   void Construct (void);
 
+  /**
+   * \return the indexes in m_handlers of the handlers of the packets
+   * of the given protocol received by the given device, in the order
+   * they were registered
+   */
+  const std::vector<uint32_t>& GetHandlers (Ptr<NetDevice> device, uint16_t protocol, bool promiscuous);
+
   struct ProtocolHandlerEntry {
     ProtocolHandler handler;
     Ptr<NetDevice> device;
@@ -221,12 +229,16 @@ private:
   };
   typedef std::vector<struct Node::ProtocolHandlerEntry> ProtocolHandlerList;
   typedef std::vector<DeviceAdditionListener> DeviceAdditionListenerList;
+  /// Handlers matching a device, a protocol and a promiscuous flag, see GetHandlers
+  typedef std::map<uint64_t, std::vector<uint32_t> > ProtocolHandlerCache;
 
   uint32_t    m_id;         // Node id for this node
   uint32_t    m_sid;        // System id for this node
   std::vector<Ptr<NetDevice> > m_devices;
   std::vector<Ptr<Application> > m_applications;
   ProtocolHandlerList m_handlers;
+  ProtocolHandlerCache m_handlerCache; // built on demand from m_handlers
+  bool m_handlerCacheValid;            // false if m_handlers changed since m_handlerCache was built
   DeviceAdditionListenerList m_deviceAdditionListeners;
 };
 
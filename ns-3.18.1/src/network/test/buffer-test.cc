@@ -323,6 +323,89 @@ BufferTest::DoRun (void)
   free (cBuf);
 }
 //-----------------------------------------------------------------------------
+class BufferChecksumTest : public TestCase {
+private:
+  uint16_t ReferenceChecksum (Buffer::Iterator i, uint16_t size, uint32_t initialChecksum);
+public:
+  virtual void DoRun (void);
+  BufferChecksumTest ();
+};
+
+BufferChecksumTest::BufferChecksumTest ()
+  : TestCase ("Buffer IP checksum")
+{
+}
+
+uint16_t
+BufferChecksumTest::ReferenceChecksum (Buffer::Iterator i, uint16_t size, uint32_t initialChecksum)
+{
+  // RFC 1071, one word at a time
+  uint32_t sum = initialChecksum;
+  for (int j = 0; j < size/2; j++)
+    sum += i.ReadU16 ();
+  if (size & 1)
+    sum += i.ReadU8 ();
+  while (sum >> 16)
+    sum = (sum & 0xffff) + (sum >> 16);
+  return ~sum;
+}
+
+void
+BufferChecksumTest::DoRun (void)
+{
+  // a buffer made of a header, a zero area and a trailer, all of
+  // odd sizes so that the zones start at both word parities
+  Buffer buffer (61);
+  buffer.AddAtStart (37);
+  buffer.AddAtEnd (23);
+  Buffer::Iterator it = buffer.Begin ();
+  for (uint32_t i = 0; i < 37; i++)
+    {
+      it.WriteU8 (0xff - 3 * i);
+    }
+  it = buffer.End ();
+  it.Prev (23);
+  for (uint32_t i = 0; i < 23; i++)
+    {
+      it.WriteU8 (7 * i + 1);
+    }
+
+  uint32_t size = buffer.GetSize ();
+  for (uint32_t start = 0; start < size; start++)
+    {
+      for (uint32_t length = 0; start + length <= size; length++)
+        {
+          Buffer::Iterator i = buffer.Begin ();
+          i.Next (start);
+          Buffer::Iterator ref = i;
+          uint16_t checksum = i.CalculateIpChecksum (length, 0x1234);
+          NS_TEST_ASSERT_MSG_EQ (checksum, ReferenceChecksum (ref, length, 0x1234),
+                                 "Wrong checksum from " << start << " over " << length << " bytes");
+          NS_TEST_ASSERT_MSG_EQ (i.GetDistanceFrom (buffer.Begin ()), start + length,
+                                 "Iterator not advanced past the checksummed bytes");
+        }
+    }
+
+  // a checksummed area, including its checksum, sums to zero
+  Buffer data;
+  data.AddAtStart (20);
+  it = data.Begin ();
+  for (uint32_t i = 0; i < 20; i++)
+    {
+      it.WriteU8 (i * 13);
+    }
+  it = data.Begin ();
+  it.Next (10);
+  it.WriteU16 (0);
+  it = data.Begin ();
+  uint16_t checksum = it.CalculateIpChecksum (20);
+  it = data.Begin ();
+  it.Next (10);
+  it.WriteU16 (checksum);
+  it = data.Begin ();
+  NS_TEST_ASSERT_MSG_EQ (it.CalculateIpChecksum (20), 0, "Checksum does not verify");
+}
+//-----------------------------------------------------------------------------
 class BufferTestSuite : public TestSuite
 {
 public:
@@ -333,6 +416,7 @@ BufferTestSuite::BufferTestSuite ()
   : TestSuite ("buffer", UNIT)
 {
   AddTestCase (new BufferTest, TestCase::QUICK);
+  AddTestCase (new BufferChecksumTest, TestCase::QUICK);
 }
 
 static BufferTestSuite g_bufferTestSuite;
@@ -38,7 +38,10 @@
 #include "ns3/pointer.h"
 #include "ns3/double.h"
 #include "ns3/string.h"
+#include "ns3/boolean.h"
 #include "ns3/rng-seed-manager.h"
+#include <cmath>
+#include <vector>
 
 using namespace ns3;
 
@@ -224,6 +227,193 @@ BurstErrorModelSimple::DoRun (void)
   NS_TEST_ASSERT_MSG_EQ (m_drops, 260 , "Wrong number of drops.");
 }
 
+class RateErrorModelSkipSamplingTest : public TestCase
+{
+public:
+  RateErrorModelSkipSamplingTest ();
+  virtual void DoRun (void);
+private:
+  Ptr<RateErrorModel> CreateModel (RateErrorModel::ErrorUnit unit, double rate);
+  void CheckRate (RateErrorModel::ErrorUnit unit, double rate, uint32_t size);
+};
+
+RateErrorModelSkipSamplingTest::RateErrorModelSkipSamplingTest ()
+  : TestCase ("RateErrorModel with skip sampling")
+{
+}
+
+Ptr<RateErrorModel>
+RateErrorModelSkipSamplingTest::CreateModel (RateErrorModel::ErrorUnit unit, double rate)
+{
+  Ptr<RateErrorModel> em = CreateObject<RateErrorModel> ();
+  em->SetAttribute ("SkipSampling", BooleanValue (true));
+  em->SetUnit (unit);
+  em->SetRate (rate);
+  em->AssignStreams (3);
+  return em;
+}
+
+void
+RateErrorModelSkipSamplingTest::CheckRate (RateErrorModel::ErrorUnit unit, double rate, uint32_t size)
+{
+  Ptr<RateErrorModel> em = CreateModel (unit, rate);
+  uint32_t units = (unit == RateErrorModel::ERROR_UNIT_PACKET) ? 1 :
+    (unit == RateErrorModel::ERROR_UNIT_BYTE) ? size : 8 * size;
+  double per = 1 - std::pow (1 - rate, static_cast<double> (units));
+  uint32_t n = 100000;
+  uint32_t drops = 0;
+  Ptr<Packet> p = Create<Packet> (size);
+  for (uint32_t i = 0; i < n; i++)
+    {
+      drops += em->IsCorrupt (p);
+    }
+  double sigma = std::sqrt (n * per * (1 - per));
+  NS_TEST_ASSERT_MSG_EQ_TOL (drops, n * per, 5 * sigma,
+                             "Wrong number of drops for unit " << unit << " and rate " << rate);
+}
+
+void
+RateErrorModelSkipSamplingTest::DoRun (void)
+{
+  RngSeedManager::SetSeed (3);
+  RngSeedManager::SetRun (1);
+
+  CheckRate (RateErrorModel::ERROR_UNIT_PACKET, 0.01, 1000);
+  CheckRate (RateErrorModel::ERROR_UNIT_PACKET, 0.5, 1000);
+  CheckRate (RateErrorModel::ERROR_UNIT_BYTE, 1e-4, 100);
+  CheckRate (RateErrorModel::ERROR_UNIT_BYTE, 0.01, 100);
+  CheckRate (RateErrorModel::ERROR_UNIT_BIT, 1e-5, 100);
+  CheckRate (RateErrorModel::ERROR_UNIT_BIT, 1e-3, 1500);
+
+  // the same stream gives the same errors, also after a reset
+  Ptr<RateErrorModel> a = CreateModel (RateErrorModel::ERROR_UNIT_BYTE, 1e-3);
+  Ptr<RateErrorModel> b = CreateModel (RateErrorModel::ERROR_UNIT_BYTE, 1e-3);
+  std::vector<bool> errors;
+  for (uint32_t i = 0; i < 10000; i++)
+    {
+      Ptr<Packet> p = Create<Packet> (1 + i % 1500);
+      bool corrupt = a->IsCorrupt (p);
+      NS_TEST_ASSERT_MSG_EQ (corrupt, b->IsCorrupt (p), "Same stream gives different errors");
+      errors.push_back (corrupt);
+    }
+  b->Reset ();
+  b->AssignStreams (3);
+  for (uint32_t i = 0; i < 10000; i++)
+    {
+      Ptr<Packet> p = Create<Packet> (1 + i % 1500);
+      NS_TEST_ASSERT_MSG_EQ (b->IsCorrupt (p), errors[i], "Errors not reproduced after reset");
+    }
+
+  // no errors at rate zero
+  Ptr<RateErrorModel> none = CreateModel (RateErrorModel::ERROR_UNIT_BIT, 0);
+  Ptr<Packet> p = Create<Packet> (1500);
+  for (uint32_t i = 0; i < 1000; i++)
+    {
+      NS_TEST_ASSERT_MSG_EQ (none->IsCorrupt (p), false, "Error at rate zero");
+    }
+}
+
+class BurstErrorModelSkipSamplingTest : public TestCase
+{
+public:
+  BurstErrorModelSkipSamplingTest ();
+  virtual void DoRun (void);
+private:
+  uint32_t CountDrops (bool skipSampling, uint32_t n);
+};
+
+BurstErrorModelSkipSamplingTest::BurstErrorModelSkipSamplingTest ()
+  : TestCase ("BurstErrorModel with skip sampling")
+{
+}
+
+uint32_t
+BurstErrorModelSkipSamplingTest::CountDrops (bool skipSampling, uint32_t n)
+{
+  Ptr<BurstErrorModel> em = CreateObject<BurstErrorModel> ();
+  em->SetAttribute ("SkipSampling", BooleanValue (skipSampling));
+  em->SetAttribute ("BurstSize", StringValue ("ns3::ConstantRandomVariable[Constant=3]"));
+  em->SetBurstRate (0.01);
+  em->AssignStreams (5);
+  Ptr<Packet> p = Create<Packet> (1000);
+  uint32_t drops = 0;
+  for (uint32_t i = 0; i < n; i++)
+    {
+      drops += em->IsCorrupt (p);
+    }
+  return drops;
+}
+
+void
+BurstErrorModelSkipSamplingTest::DoRun (void)
+{
+  RngSeedManager::SetSeed (3);
+  RngSeedManager::SetRun (1);
+
+  // A packet is dropped unless none of the last three packets started
+  // a burst, and the two modes draw the burst starts with the same law.
+  // The drops come by bursts of about three packets, hence the tolerance
+  // of five standard deviations of three times the number of bursts.
+  uint32_t n = 100000;
+  double expected = n * (1 - std::pow (0.99, 3));
+  double tolerance = 5 * 3 * std::sqrt (n * 0.01 * 0.99);
+  NS_TEST_ASSERT_MSG_EQ_TOL (CountDrops (false, n), expected, tolerance, "Wrong number of drops");
+  NS_TEST_ASSERT_MSG_EQ_TOL (CountDrops (true, n), expected, tolerance, "Wrong number of drops with skip sampling");
+  NS_TEST_ASSERT_MSG_EQ (CountDrops (true, n), CountDrops (true, n), "Same stream gives different drops");
+}
+
+class ListErrorModelTest : public TestCase
+{
+public:
+  ListErrorModelTest ();
+  virtual void DoRun (void);
+};
+
+ListErrorModelTest::ListErrorModelTest ()
+  : TestCase ("ListErrorModel and ReceiveListErrorModel")
+{
+}
+
+void
+ListErrorModelTest::DoRun (void)
+{
+  std::vector<Ptr<Packet> > packets;
+  for (uint32_t i = 0; i < 20; i++)
+    {
+      packets.push_back (Create<Packet> (100));
+    }
+
+  std::list<uint32_t> list;
+  list.push_back (packets[7]->GetUid ());
+  list.push_back (packets[2]->GetUid ());
+  list.push_back (packets[13]->GetUid ());
+  Ptr<ListErrorModel> em = CreateObject<ListErrorModel> ();
+  em->SetList (list);
+  NS_TEST_ASSERT_MSG_EQ ((em->GetList () == list), true, "List not kept as set");
+  for (uint32_t i = 0; i < packets.size (); i++)
+    {
+      NS_TEST_ASSERT_MSG_EQ (em->IsCorrupt (packets[i]), (i == 2 || i == 7 || i == 13),
+                             "Wrong decision for packet " << i);
+    }
+  em->Reset ();
+  for (uint32_t i = 0; i < packets.size (); i++)
+    {
+      NS_TEST_ASSERT_MSG_EQ (em->IsCorrupt (packets[i]), false, "Packet " << i << " corrupted after reset");
+    }
+
+  list.clear ();
+  list.push_back (11);
+  list.push_back (0);
+  list.push_back (4);
+  Ptr<ReceiveListErrorModel> rem = CreateObject<ReceiveListErrorModel> ();
+  rem->SetList (list);
+  for (uint32_t i = 0; i < packets.size (); i++)
+    {
+      NS_TEST_ASSERT_MSG_EQ (rem->IsCorrupt (packets[i]), (i == 0 || i == 4 || i == 11),
+                             "Wrong decision for received packet " << i);
+    }
+}
+
 // This is the start of an error model test suite.  For starters, this is
 // just testing that the SimpleNetDevice is working but this can be
 // extended to many more test cases in the future
@@ -238,6 +428,9 @@ ErrorModelTestSuite::ErrorModelTestSuite ()
 {
   AddTestCase (new ErrorModelSimple, TestCase::QUICK);
   AddTestCase (new BurstErrorModelSimple, TestCase::QUICK);
+  AddTestCase (new RateErrorModelSkipSamplingTest, TestCase::QUICK);
+  AddTestCase (new BurstErrorModelSkipSamplingTest, TestCase::QUICK);
+  AddTestCase (new ListErrorModelTest, TestCase::QUICK);
 }
 
 // Do not forget to allocate an instance of this TestSuite
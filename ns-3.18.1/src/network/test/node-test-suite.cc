@@ -0,0 +1,159 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <vector>
+#include "ns3/test.h"
+#include "ns3/simple-ref-count.h"
+#include "ns3/node.h"
+#include "ns3/packet.h"
+#include "ns3/simulator.h"
+#include "ns3/simple-net-device.h"
+#include "ns3/simple-channel.h"
+#include "ns3/mac48-address.h"
+
+using namespace ns3;
+
+/**
+ * A protocol handler which records its id in a list when called.
+ */
+class NodeTestHandler : public SimpleRefCount<NodeTestHandler>
+{
+public:
+  NodeTestHandler (uint32_t id, std::vector<uint32_t> *received)
+    : m_id (id),
+      m_received (received)
+  {
+  }
+  void Receive (Ptr<NetDevice> device, Ptr<const Packet> packet, uint16_t protocol,
+                const Address &from, const Address &to, NetDevice::PacketType packetType)
+  {
+    m_received->push_back (m_id);
+  }
+private:
+  uint32_t m_id;
+  std::vector<uint32_t> *m_received;
+};
+
+/**
+ * Check that the packets received by a node are dispatched to the
+ * protocol handlers matching their device and protocol, in registration
+ * order, and that the dispatch follows handler (un)registrations.
+ */
+class NodeProtocolHandlerTestCase : public TestCase
+{
+public:
+  NodeProtocolHandlerTestCase ();
+  virtual void DoRun (void);
+private:
+  void Send (Ptr<NetDevice> device, uint16_t protocol);
+  Node::ProtocolHandler MakeHandler (uint32_t id);
+  std::vector<Ptr<NodeTestHandler> > m_handlers;
+  std::vector<uint32_t> m_received;
+};
+
+NodeProtocolHandlerTestCase::NodeProtocolHandlerTestCase ()
+  : TestCase ("Dispatch of received packets to the protocol handlers")
+{
+}
+
+void
+NodeProtocolHandlerTestCase::Send (Ptr<NetDevice> device, uint16_t protocol)
+{
+  m_received.clear ();
+  device->Send (Create<Packet> (100), Mac48Address::GetBroadcast (), protocol);
+  Simulator::Run ();
+}
+
+Node::ProtocolHandler
+NodeProtocolHandlerTestCase::MakeHandler (uint32_t id)
+{
+  if (m_handlers.size () < id)
+    {
+      m_handlers.resize (id);
+    }
+  if (m_handlers[id - 1] == 0)
+    {
+      m_handlers[id - 1] = Create<NodeTestHandler> (id, &m_received);
+    }
+  return MakeCallback (&NodeTestHandler::Receive, m_handlers[id - 1]);
+}
+
+void
+NodeProtocolHandlerTestCase::DoRun (void)
+{
+  Ptr<Node> sender = CreateObject<Node> ();
+  Ptr<Node> receiver = CreateObject<Node> ();
+  Ptr<SimpleNetDevice> tx[2];
+  Ptr<SimpleNetDevice> rx[2];
+  for (uint32_t i = 0; i < 2; i++)
+    {
+      Ptr<SimpleChannel> channel = CreateObject<SimpleChannel> ();
+      tx[i] = CreateObject<SimpleNetDevice> ();
+      tx[i]->SetAddress (Mac48Address::Allocate ());
+      tx[i]->SetChannel (channel);
+      sender->AddDevice (tx[i]);
+      rx[i] = CreateObject<SimpleNetDevice> ();
+      rx[i]->SetAddress (Mac48Address::Allocate ());
+      rx[i]->SetChannel (channel);
+      receiver->AddDevice (rx[i]);
+    }
+
+  receiver->RegisterProtocolHandler (MakeHandler (1), 0, 0);
+  receiver->RegisterProtocolHandler (MakeHandler (2), 0x0800, rx[0]);
+  receiver->RegisterProtocolHandler (MakeHandler (3), 0x0800, rx[1]);
+  receiver->RegisterProtocolHandler (MakeHandler (4), 0x0806, 0);
+
+  Send (tx[0], 0x0800);
+  NS_TEST_ASSERT_MSG_EQ (m_received.size (), 2, "Wrong number of handlers for protocol 0x0800 on device 0");
+  NS_TEST_ASSERT_MSG_EQ (m_received[0], 1, "Handlers not called in registration order");
+  NS_TEST_ASSERT_MSG_EQ (m_received[1], 2, "Wrong handler for protocol 0x0800 on device 0");
+
+  Send (tx[1], 0x0800);
+  NS_TEST_ASSERT_MSG_EQ (m_received.size (), 2, "Wrong number of handlers for protocol 0x0800 on device 1");
+  NS_TEST_ASSERT_MSG_EQ (m_received[1], 3, "Wrong handler for protocol 0x0800 on device 1");
+
+  Send (tx[1], 0x0806);
+  NS_TEST_ASSERT_MSG_EQ (m_received.size (), 2, "Wrong number of handlers for protocol 0x0806");
+  NS_TEST_ASSERT_MSG_EQ (m_received[1], 4, "Wrong handler for protocol 0x0806");
+
+  Send (tx[0], 0x86dd);
+  NS_TEST_ASSERT_MSG_EQ (m_received.size (), 1, "Wrong number of handlers for protocol 0x86dd");
+
+  // the dispatch must follow the changes of the registered handlers
+  receiver->UnregisterProtocolHandler (MakeHandler (1));
+  receiver->RegisterProtocolHandler (MakeHandler (5), 0x0800, 0);
+  Send (tx[0], 0x0800);
+  NS_TEST_ASSERT_MSG_EQ (m_received.size (), 2, "Dispatch not updated after handler changes");
+  NS_TEST_ASSERT_MSG_EQ (m_received[0], 2, "Unregistered handler still called");
+  NS_TEST_ASSERT_MSG_EQ (m_received[1], 5, "Newly registered handler not called");
+
+  Simulator::Destroy ();
+  m_handlers.clear ();
+}
+
+class NodeTestSuite : public TestSuite
+{
+public:
+  NodeTestSuite ();
+};
+
+NodeTestSuite::NodeTestSuite ()
+  : TestSuite ("node", UNIT)
+{
+  AddTestCase (new NodeProtocolHandlerTestCase, TestCase::QUICK);
+}
+
+static NodeTestSuite g_nodeTestSuite;
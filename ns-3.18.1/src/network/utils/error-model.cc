@@ -61,6 +61,7 @@
  */
 
 #include <cmath>
+#include <limits>
 
 #include "error-model.h"
 
@@ -145,6 +146,27 @@ ErrorModel::IsEnabled (void) const
 // RateErrorModel
 //
 
+/**
+ * \param uniform a Uniform(0,1) random variable
+ * \param rate the probability of error of each unit
+ * \returns the number of units without error before the next errored
+ * one, a geometric variate drawn by inversion from a single value
+ */
+static double
+DrawUnitsToNextError (Ptr<RandomVariableStream> uniform, double rate)
+{
+  double u = uniform->GetValue ();
+  if (rate <= 0 || u <= 0)
+    {
+      return std::numeric_limits<double>::infinity ();
+    }
+  if (rate >= 1)
+    {
+      return 0;
+    }
+  return std::floor (std::log (u) / std::log (1 - rate));
+}
+
 NS_OBJECT_ENSURE_REGISTERED (RateErrorModel);
 
 TypeId RateErrorModel::GetTypeId (void)
@@ -166,12 +188,20 @@ TypeId RateErrorModel::GetTypeId (void)
                    StringValue ("ns3::UniformRandomVariable[Min=0.0|Max=1.0]"),
                    MakePointerAccessor (&RateErrorModel::m_ranvar),
                    MakePointerChecker<RandomVariableStream> ())
+    .AddAttribute ("SkipSampling",
+                   "If true, draw the number of units up to the next error rather than "
+                   "a decision variable per packet.",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&RateErrorModel::m_skipSampling),
+                   MakeBooleanChecker ())
   ;
   return tid;
 }
 
 
 RateErrorModel::RateErrorModel ()
+  : m_unitsToNextError (0),
+    m_skipRate (-1)
 {
   NS_LOG_FUNCTION (this);
 }
@@ -214,6 +244,7 @@ RateErrorModel::SetRandomVariable (Ptr<RandomVariableStream> ranvar)
 {
   NS_LOG_FUNCTION (this << ranvar);
   m_ranvar = ranvar;
+  m_skipRate = -1;
 }
 
 int64_t 
@@ -221,6 +252,7 @@ RateErrorModel::AssignStreams (int64_t stream)
 {
   NS_LOG_FUNCTION (this << stream);
   m_ranvar->SetStream (stream);
+  m_skipRate = -1;
   return 1;
 }
 
@@ -251,6 +283,10 @@ bool
 RateErrorModel::DoCorruptPkt (Ptr<Packet> p)
 {
   NS_LOG_FUNCTION (this << p);
+  if (m_skipSampling)
+    {
+      return DoCorruptSkip (1);
+    }
   return (m_ranvar->GetValue () < m_rate);
 }
 
@@ -258,6 +294,10 @@ bool
 RateErrorModel::DoCorruptByte (Ptr<Packet> p)
 {
   NS_LOG_FUNCTION (this << p);
+  if (m_skipSampling)
+    {
+      return DoCorruptSkip (p->GetSize ());
+    }
   // compute pkt error rate, assume uniformly distributed byte error
   double per = 1 - std::pow (1.0 - m_rate, static_cast<double> (p->GetSize ()));
   return (m_ranvar->GetValue () < per);
@@ -267,16 +307,48 @@ bool
 RateErrorModel::DoCorruptBit (Ptr<Packet> p)
 {
   NS_LOG_FUNCTION (this << p);
+  if (m_skipSampling)
+    {
+      return DoCorruptSkip (8.0 * p->GetSize ());
+    }
   // compute pkt error rate, assume uniformly distributed bit error
   double per = 1 - std::pow (1.0 - m_rate, static_cast<double> (8 * p->GetSize ()) );
   return (m_ranvar->GetValue () < per);
 }
 
+bool
+RateErrorModel::DoCorruptSkip (double units)
+{
+  NS_LOG_FUNCTION (this << units);
+  if (m_rate != m_skipRate || m_unit != m_skipUnit)
+    {
+      m_skipRate = m_rate;
+      m_skipUnit = m_unit;
+      m_unitsToNextError = DrawUnitsToNextError (m_ranvar, m_rate);
+    }
+  if (m_unitsToNextError >= units)
+    {
+      m_unitsToNextError -= units;
+      return false;
+    }
+  // skip the other errors of this packet, if any, to count down the
+  // distance to the first error after it
+  double remaining = units - m_unitsToNextError - 1;
+  m_unitsToNextError = DrawUnitsToNextError (m_ranvar, m_rate);
+  while (m_unitsToNextError < remaining)
+    {
+      remaining -= m_unitsToNextError + 1;
+      m_unitsToNextError = DrawUnitsToNextError (m_ranvar, m_rate);
+    }
+  m_unitsToNextError -= remaining;
+  return true;
+}
+
 void 
 RateErrorModel::DoReset (void) 
 { 
   NS_LOG_FUNCTION (this);
-  /* re-initialize any state; no-op for now */ 
+  m_skipRate = -1;
 }
 
 
@@ -303,12 +375,18 @@ TypeId BurstErrorModel::GetTypeId (void)
                    StringValue ("ns3::UniformRandomVariable[Min=1|Max=4]"),
                    MakePointerAccessor (&BurstErrorModel::m_burstSize),
                    MakePointerChecker<RandomVariableStream> ())
+    .AddAttribute ("SkipSampling",
+                   "If true, draw the number of packets up to the next error event rather than "
+                   "a decision variable per packet.",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&BurstErrorModel::m_skipSampling),
+                   MakeBooleanChecker ())
   ;
   return tid;
 }
 
 
-BurstErrorModel::BurstErrorModel () : m_counter (0), m_currentBurstSz (0)
+BurstErrorModel::BurstErrorModel () : m_packetsToNextBurst (0), m_skipRate (-1), m_counter (0), m_currentBurstSz (0)
 {
 
 }
@@ -337,6 +415,7 @@ BurstErrorModel::SetRandomVariable (Ptr<RandomVariableStream> ranVar)
 {
   NS_LOG_FUNCTION (this << ranVar);
   m_burstStart = ranVar;
+  m_skipRate = -1;
 }
 
 void
@@ -352,6 +431,7 @@ BurstErrorModel::AssignStreams (int64_t stream)
   NS_LOG_FUNCTION (this << stream);
   m_burstStart->SetStream (stream);
   m_burstSize->SetStream(stream);
+  m_skipRate = -1;
   return 2;
 }
 
@@ -363,9 +443,31 @@ BurstErrorModel::DoCorrupt (Ptr<Packet> p)
     {
       return false;
     }
-  double ranVar = m_burstStart ->GetValue();
+  bool newBurst;
+  if (m_skipSampling)
+    {
+      if (m_burstRate != m_skipRate)
+        {
+          m_skipRate = m_burstRate;
+          m_packetsToNextBurst = DrawUnitsToNextError (m_burstStart, m_burstRate);
+        }
+      newBurst = (m_packetsToNextBurst < 1);
+      if (newBurst)
+        {
+          m_packetsToNextBurst = DrawUnitsToNextError (m_burstStart, m_burstRate);
+        }
+      else
+        {
+          m_packetsToNextBurst -= 1;
+        }
+    }
+  else
+    {
+      double ranVar = m_burstStart ->GetValue();
+      newBurst = (ranVar < m_burstRate);
+    }
 
-  if (ranVar < m_burstRate)
+  if (newBurst)
     {
       // get a new burst size for the new error event
       m_currentBurstSz = m_burstSize->GetInteger();     
@@ -404,6 +506,7 @@ BurstErrorModel::DoReset (void)
   NS_LOG_FUNCTION (this);
   m_counter = 0;
   m_currentBurstSz = 0;
+  m_skipRate = -1;
 
 }
 
@@ -445,11 +548,13 @@ ListErrorModel::SetList (const std::list<uint32_t> &packetlist)
 { 
   NS_LOG_FUNCTION (this << &packetlist);
   m_packetList = packetlist;
+  m_packetSet.clear ();
+  for (PacketListCI i = m_packetList.begin (); i != m_packetList.end (); i++)
+    {
+      m_packetSet[*i] = true;
+    }
 }
 
-// When performance becomes a concern, the list provided could be 
-// converted to a dynamically-sized array of uint32_t to avoid 
-// list iteration below.
 bool 
 ListErrorModel::DoCorrupt (Ptr<Packet> p) 
 { 
@@ -458,16 +563,7 @@ ListErrorModel::DoCorrupt (Ptr<Packet> p)
     {
       return false;
     }
-  uint32_t uid = p->GetUid ();
-  for (PacketListCI i = m_packetList.begin (); 
-       i != m_packetList.end (); i++)
-    {
-      if (uid == *i)
-        {
-          return true;
-        }
-    }
-  return false;
+  return m_packetSet.find (p->GetUid ()) != m_packetSet.end ();
 }
 
 void 
@@ -475,6 +571,7 @@ ListErrorModel::DoReset (void)
 { 
   NS_LOG_FUNCTION (this);
   m_packetList.clear ();
+  m_packetSet.clear ();
 }
 
 //
@@ -516,6 +613,11 @@ ReceiveListErrorModel::SetList (const std::list<uint32_t> &packetlist)
 { 
   NS_LOG_FUNCTION (this << &packetlist);
   m_packetList = packetlist;
+  m_packetSet.clear ();
+  for (PacketListCI i = m_packetList.begin (); i != m_packetList.end (); i++)
+    {
+      m_packetSet[*i] = true;
+    }
 }
 
 bool 
@@ -527,15 +629,7 @@ ReceiveListErrorModel::DoCorrupt (Ptr<Packet> p)
       return false;
     }
   m_timesInvoked += 1;
-  for (PacketListCI i = m_packetList.begin (); 
-       i != m_packetList.end (); i++)
-    {
-      if (m_timesInvoked - 1 == *i)
-        {
-          return true;
-        }
-    }
-  return false;
+  return m_packetSet.find (m_timesInvoked - 1) != m_packetSet.end ();
 }
 
 void 
@@ -543,6 +637,7 @@ ReceiveListErrorModel::DoReset (void)
 { 
   NS_LOG_FUNCTION (this);
   m_packetList.clear ();
+  m_packetSet.clear ();
 }
 
 
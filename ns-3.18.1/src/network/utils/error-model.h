@@ -65,6 +65,7 @@
 
 #include <list>
 #include "ns3/object.h"
+#include "ns3/sgi-hashmap.h"
 #include "ns3/random-variable-stream.h"
 
 namespace ns3 {
@@ -165,8 +166,15 @@ private:
  * unit (which may be per-bit, per-byte, and per-packet).
  * Users can optionally provide a RandomVariableStream object; the default
  * is to use a Uniform(0,1) distribution.
-
- * Reset() on this model will do nothing
+ *
+ * If the SkipSampling attribute is set, the model instead draws, from
+ * the same random variable, the number of units without error up to
+ * the next errored unit (a geometric variate), and counts it down with
+ * the units of each packet. Packets without error then cost no random
+ * draw nor std::pow call. The loss statistics are the same, but not
+ * the sequence of errored packets obtained from a given stream.
+
+ * Reset() on this model will restart the skip sampling, if enabled
  *
  * IsCorrupt() will not modify the packet data buffer
  */
@@ -224,11 +232,17 @@ private:
   virtual bool DoCorruptByte (Ptr<Packet> p);
   virtual bool DoCorruptBit (Ptr<Packet> p);
   virtual void DoReset (void);
+  bool DoCorruptSkip (double units);
 
   enum ErrorUnit m_unit;
   double m_rate;
 
   Ptr<RandomVariableStream> m_ranvar;
+
+  bool m_skipSampling;
+  double m_unitsToNextError; // error-free units before the next error
+  double m_skipRate;         // rate m_unitsToNextError was drawn with, negative if none
+  enum ErrorUnit m_skipUnit; // unit m_unitsToNextError was drawn with
 };
 
 
@@ -262,6 +276,10 @@ private:
  * total number of packets that has been dropped does not exceed the 
  * burst size.
  *
+ * If the SkipSampling attribute is set, the decision variable is not
+ * drawn for every packet: the model draws from it the number of packets
+ * up to the next error event (a geometric variate) once per event.
+ *
  * IsCorrupt() will not modify the packet data buffer
  */
 class BurstErrorModel : public ErrorModel
@@ -307,6 +325,10 @@ private:
 
   double m_burstRate;                         //the burst error event
 
+  bool m_skipSampling;                        //draw the distance to the next error event
+  double m_packetsToNextBurst;                //packets before the next error event
+  double m_skipRate;                          //burst rate m_packetsToNextBurst was drawn with
+
   Ptr<RandomVariableStream> m_burstStart;     //the error decision variable
 
   Ptr<RandomVariableStream> m_burstSize;      //the number of packets being flagged as errored
@@ -324,9 +346,9 @@ private:
  *
  * This object is used to flag packets as being lost/errored or not.
  * A note on performance:  the list is assumed to be unordered, and
- * in general, Packet uids received may be unordered.  Therefore,
- * each call to IsCorrupt() will result in a walk of the list with
- * the present underlying implementation.
+ * in general, Packet uids received may be unordered.  The uids are
+ * therefore also kept in a hash table, so that each call to IsCorrupt()
+ * costs a single lookup whatever the length of the list.
  * 
  * Note also that if one wants to target multiple packets from looking
  * at an (unerrored) trace file, the act of erroring a given packet may
@@ -365,8 +387,10 @@ private:
 
   typedef std::list<uint32_t> PacketList;
   typedef std::list<uint32_t>::const_iterator PacketListCI;
+  typedef sgi::hash_map<uint32_t, bool> PacketSet;
 
   PacketList m_packetList;
+  PacketSet m_packetSet;  // the uids of m_packetList
 
 };
 
@@ -406,8 +430,10 @@ private:
 
   typedef std::list<uint32_t> PacketList;
   typedef std::list<uint32_t>::const_iterator PacketListCI;
+  typedef sgi::hash_map<uint32_t, bool> PacketSet;
 
   PacketList m_packetList;
+  PacketSet m_packetSet;  // the packet numbers of m_packetList
   uint32_t m_timesInvoked;
 
 };
@@ -241,6 +241,16 @@ Mac48Address Mac48Address::GetMulticast (Ipv6Address addr)
   return etherAddr;
 }
 
+size_t Mac48AddressHash::operator() (Mac48Address const &x) const
+{
+  uint8_t ad[6];
+  x.CopyTo (ad);
+  // Allocated addresses differ mostly in their low order bytes
+  return (static_cast<size_t> (ad[0]) << 8 | ad[1]) ^
+         (static_cast<size_t> (ad[2]) << 24 | static_cast<size_t> (ad[3]) << 16 |
+          static_cast<size_t> (ad[4]) << 8 | ad[5]);
+}
+
 std::ostream& operator<< (std::ostream& os, const Mac48Address & address)
 {
   uint8_t ad[6];
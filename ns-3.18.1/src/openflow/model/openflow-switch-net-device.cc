@@ -21,6 +21,8 @@
 
 NS_LOG_COMPONENT_DEFINE ("OpenFlowSwitchNetDevice");
 
+#define MAX_FLOW_CACHE_SIZE 65536
+
 namespace ns3 {
 
 NS_OBJECT_ENSURE_REGISTERED (OpenFlowSwitchNetDevice);
@@ -131,6 +133,8 @@ OpenFlowSwitchNetDevice::DoDispose ()
 
   m_controller = 0;
 
+  m_flowCache.clear ();
+  m_packetData.clear ();
   chain_destroy (m_chain);
   RBTreeDestroy (m_vportTable.table);
   m_channel = 0;
@@ -663,6 +667,10 @@ OpenFlowSwitchNetDevice::ReceiveFromDevice (Ptr<NetDevice> netdev, Ptr<const Pac
       List deleted = LIST_INITIALIZER (&deleted);
       sw_flow *f, *n;
       chain_timeout (m_chain, &deleted);
+      if (!list_is_empty (&deleted))
+        {
+          InvalidateFlowCache ();
+        }
       LIST_FOR_EACH_SAFE (f, n, sw_flow, node, &deleted)
       {
         std::ostringstream str;
@@ -951,7 +959,7 @@ OpenFlowSwitchNetDevice::SendErrorMsg (uint16_t type, uint16_t code, const void
 void
 OpenFlowSwitchNetDevice::FlowTableLookup (sw_flow_key key, ofpbuf* buffer, uint32_t packet_uid, int port, bool send_to_controller)
 {
-  sw_flow *flow = chain_lookup (m_chain, &key);
+  sw_flow *flow = LookupFlow (&key);
   if (flow != 0)
     {
       NS_LOG_INFO ("Flow matched");
@@ -981,6 +989,7 @@ OpenFlowSwitchNetDevice::RunThroughFlowTable (uint32_t packet_uid, int port, boo
   ofpbuf* buffer = data.buffer;
 
   sw_flow_key key;
+  memset (&key, 0, sizeof (key));
   key.wildcards = 0; // Lookup cannot take wildcards.
   // Extract the matching key's flow data from the packet's headers; if the policy is to drop fragments and the message is a fragment, drop it.
   if (flow_extract (buffer, port != -1 ? port : OFPP_NONE, &key.flow) && (m_flags & OFPC_FRAG_MASK) == OFPC_FRAG_DROP)
@@ -1262,6 +1271,7 @@ OpenFlowSwitchNetDevice::AddFlow (const ofp_flow_mod *ofm)
 
   // Act.
   int error = chain_insert (m_chain, flow);
+  InvalidateFlowCache ();
   if (error)
     {
       if (error == -ENOBUFS)
@@ -1318,6 +1328,7 @@ OpenFlowSwitchNetDevice::ModFlow (const ofp_flow_mod *ofm)
   uint16_t priority = key.wildcards ? ntohs (ofm->priority) : -1;
   int strict = (ofm->command == htons (OFPFC_MODIFY_STRICT)) ? 1 : 0;
   chain_modify (m_chain, &key, priority, strict, ofm->actions, actions_len);
+  InvalidateFlowCache ();
 
   if (ntohl (ofm->buffer_id) != std::numeric_limits<uint32_t>::max ())
     {
@@ -1356,6 +1367,7 @@ OpenFlowSwitchNetDevice::ReceiveFlow (const void *msg)
     {
       sw_flow_key key;
       flow_extract_match (&key, &ofm->match);
+      InvalidateFlowCache ();
       return chain_delete (m_chain, &key, ofm->out_port, 0, 0) ? 0 : -ESRCH;
     }
   else if (command == OFPFC_DELETE_STRICT)
@@ -1364,6 +1376,7 @@ OpenFlowSwitchNetDevice::ReceiveFlow (const void *msg)
       uint16_t priority;
       flow_extract_match (&key, &ofm->match);
       priority = key.wildcards ? ntohs (ofm->priority) : -1;
+      InvalidateFlowCache ();
       return chain_delete (m_chain, &key, ofm->out_port, priority, 1) ? 0 : -ESRCH;
     }
   else
@@ -1546,6 +1559,61 @@ OpenFlowSwitchNetDevice::GetChain ()
   return m_chain;
 }
 
+OpenFlowSwitchNetDevice::FlowCacheKey::FlowCacheKey (const sw_flow_key &k)
+{
+  // The bytes of the header fields are hashed and compared, so copy them
+  // all, including the reserved ones, which flow_extract () zeroes, and
+  // zero the wildcards and masks, which a lookup does not use.
+  memset (&key, 0, sizeof (key));
+  memcpy (&key.flow, &k.flow, sizeof (key.flow));
+}
+
+bool
+OpenFlowSwitchNetDevice::FlowCacheKey::operator == (const FlowCacheKey &other) const
+{
+  return memcmp (&key.flow, &other.key.flow, sizeof (key.flow)) == 0;
+}
+
+size_t
+OpenFlowSwitchNetDevice::FlowCacheKeyHash::operator () (const FlowCacheKey &k) const
+{
+  // FNV-1a over the header fields
+  const uint8_t *p = reinterpret_cast<const uint8_t *> (&k.key.flow);
+  uint32_t h = 2166136261U;
+  for (size_t i = 0; i < sizeof (k.key.flow); i++)
+    {
+      h ^= p[i];
+      h *= 16777619U;
+    }
+  return h;
+}
+
+sw_flow*
+OpenFlowSwitchNetDevice::LookupFlow (const sw_flow_key *key)
+{
+  NS_ASSERT_MSG (key->wildcards == 0, "Lookup cannot take wildcards.");
+  FlowCacheKey cacheKey (*key);
+  FlowCache_t::const_iterator it = m_flowCache.find (cacheKey);
+  if (it != m_flowCache.end ())
+    {
+      return it->second;
+    }
+
+  sw_flow *flow = chain_lookup (m_chain, &cacheKey.key);
+  if (m_flowCache.size () >= MAX_FLOW_CACHE_SIZE)
+    {
+      m_flowCache.clear ();
+    }
+  m_flowCache[cacheKey] = flow;
+  return flow;
+}
+
+void
+OpenFlowSwitchNetDevice::InvalidateFlowCache (void)
+{
+  m_flowCache.clear ();
+}
+
 uint32_t
 OpenFlowSwitchNetDevice::GetNSwitchPorts (void) const
 {
@@ -43,6 +43,8 @@
 #include "ns3/integer.h"
 #include "ns3/uinteger.h"
 
+#include "ns3/sgi-hashmap.h"
+
 #include <map>
 #include <set>
 
@@ -191,6 +193,26 @@ public:
    */
   sw_chain* GetChain ();
 
+  /**
+   * \brief Look up the flow matching an exact (non wildcarded) key.
+   *
+   * The result of the lookup in the flow table chain is kept in an exact
+   * match cache, so that the following packets of the same flow skip the
+   * wildcard tables.
+   *
+   * \param key The key extracted from the packet headers.
+   * \return The matching flow, or 0 if no flow matches.
+   */
+  sw_flow* LookupFlow (const sw_flow_key *key);
+
+  /**
+   * \brief Flush the exact match flow cache.
+   *
+   * The switch does this whenever it changes its flow table. It must also
+   * be called after changing the chain returned by GetChain directly.
+   */
+  void InvalidateFlowCache (void);
+
   /**
    * \return Number of switch ports attached to this switch.
    */
@@ -527,8 +549,22 @@ private:
   uint32_t m_ifIndex;                   ///< Interface Index
   uint16_t m_mtu;                       ///< Maximum Transmission Unit
 
-  typedef std::map<uint32_t,ofi::SwitchPacketMetadata> PacketData_t;
-  PacketData_t m_packetData;            ///< Packet data
+  typedef sgi::hash_map<uint32_t,ofi::SwitchPacketMetadata> PacketData_t;
+  PacketData_t m_packetData;            ///< Packet data, keyed by packet uid
+
+  /// Key of the exact match flow cache: the header fields of a packet.
+  struct FlowCacheKey
+  {
+    FlowCacheKey (const sw_flow_key &key);
+    bool operator == (const FlowCacheKey &other) const;
+    sw_flow_key key;
+  };
+  struct FlowCacheKeyHash : public std::unary_function<FlowCacheKey, size_t>
+  {
+    size_t operator () (const FlowCacheKey &key) const;
+  };
+  typedef sgi::hash_map<FlowCacheKey, sw_flow*, FlowCacheKeyHash> FlowCache_t;
+  FlowCache_t m_flowCache;              ///< Exact match cache in front of the flow table; 0 caches a miss.
 
   typedef std::vector<ofi::Port> Ports_t;
   Ports_t m_ports;                      ///< Switch's ports
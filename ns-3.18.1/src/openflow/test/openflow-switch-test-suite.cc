@@ -173,6 +173,98 @@ SwitchFlowTableTestCase::DoRun (void)
   NS_TEST_ASSERT_MSG_EQ (chain_lookup (m_chain, &key), 0, "Key provided shouldn't match the flow but it does.");
 }
 
+// Checks that the exact match cache of the switch gives the same answers
+// as the flow table, and that it follows the changes of the table.
+class SwitchFlowCacheTestCase : public TestCase
+{
+public:
+  SwitchFlowCacheTestCase () : TestCase ("Switch exact match flow cache")
+  {
+  }
+
+private:
+  virtual void DoRun (void);
+
+  static sw_flow_key MakeKey (uint32_t i);
+  static sw_flow* MakeFlow (const sw_flow_key &key);
+};
+
+sw_flow_key
+SwitchFlowCacheTestCase::MakeKey (uint32_t i)
+{
+  sw_flow_key key;
+  memset (&key, 0, sizeof (key));
+  key.wildcards = 0;
+  key.flow.in_port = htons (0);
+  key.flow.dl_vlan = htons (OFP_VLAN_NONE);
+  key.flow.dl_type = htons (ETH_TYPE_IP);
+  key.flow.nw_proto = IP_TYPE_UDP;
+  key.flow.mpls_label1 = htonl (MPLS_INVALID_LABEL);
+  key.flow.mpls_label2 = htonl (MPLS_INVALID_LABEL);
+  Mac48Address ("00:00:00:00:00:01").CopyTo (key.flow.dl_src);
+  Mac48Address ("00:00:00:00:00:02").CopyTo (key.flow.dl_dst);
+  key.flow.nw_src = htonl (Ipv4Address ("10.0.0.0").Get () + i);
+  key.flow.nw_dst = htonl (Ipv4Address ("10.1.0.1").Get ());
+  key.flow.tp_src = htons (5000);
+  key.flow.tp_dst = htons (80);
+  return key;
+}
+
+sw_flow*
+SwitchFlowCacheTestCase::MakeFlow (const sw_flow_key &key)
+{
+  sw_flow *flow = flow_alloc (0);
+  flow->key = key;
+  flow->priority = -1;
+  flow->idle_timeout = OFP_FLOW_PERMANENT;
+  flow->hard_timeout = OFP_FLOW_PERMANENT;
+  flow->used = flow->created = time_now ();
+  flow->sf_acts->actions_len = 0;
+  flow->byte_count = 0;
+  flow->packet_count = 0;
+  return flow;
+}
+
+void
+SwitchFlowCacheTestCase::DoRun (void)
+{
+  const uint32_t nFlows = 1000;
+  Ptr<OpenFlowSwitchNetDevice> swtch = CreateObject<OpenFlowSwitchNetDevice> ();
+  sw_chain *chain = swtch->GetChain ();
+
+  for (uint32_t i = 0; i < nFlows; i++)
+    {
+      NS_TEST_ASSERT_MSG_EQ (chain_insert (chain, MakeFlow (MakeKey (i))), 0, "Flow table failed to insert Flow.");
+    }
+  swtch->InvalidateFlowCache ();
+
+  // Look every flow up twice, the second time it comes from the cache.
+  for (uint32_t round = 0; round < 2; round++)
+    {
+      for (uint32_t i = 0; i < nFlows; i++)
+        {
+          sw_flow_key key = MakeKey (i);
+          sw_flow *flow = swtch->LookupFlow (&key);
+          NS_TEST_ASSERT_MSG_NE (flow, 0, "Flow " << i << " not found.");
+          NS_TEST_ASSERT_MSG_EQ (flow, chain_lookup (chain, &key), "Cache and flow table disagree for flow " << i);
+        }
+    }
+
+  // A miss is cached until the flow table changes.
+  sw_flow_key key = MakeKey (nFlows);
+  NS_TEST_ASSERT_MSG_EQ (swtch->LookupFlow (&key), 0, "Key shouldn't match any flow.");
+  NS_TEST_ASSERT_MSG_EQ (chain_insert (chain, MakeFlow (key)), 0, "Flow table failed to insert Flow.");
+  swtch->InvalidateFlowCache ();
+  NS_TEST_ASSERT_MSG_NE (swtch->LookupFlow (&key), 0, "New flow not found after the cache was flushed.");
+
+  // Deleted flows must not be returned from the cache.
+  NS_TEST_ASSERT_MSG_EQ (chain_delete (chain, &key, htons (OFPP_NONE), 0, 0), 1, "Flow table failed to delete Flow.");
+  swtch->InvalidateFlowCache ();
+  NS_TEST_ASSERT_MSG_EQ (swtch->LookupFlow (&key), 0, "Deleted flow still found.");
+
+  swtch->Dispose ();
+}
+
 class SwitchTestSuite : public TestSuite
 {
 public:
@@ -182,6 +274,7 @@ public:
 SwitchTestSuite::SwitchTestSuite () : TestSuite ("openflow", UNIT)
 {
   AddTestCase (new SwitchFlowTableTestCase, TestCase::QUICK);
+  AddTestCase (new SwitchFlowCacheTestCase, TestCase::QUICK);
 }
 
 // Do not forget to allocate an instance of this TestSuite
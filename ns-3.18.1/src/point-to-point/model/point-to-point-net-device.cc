@@ -25,6 +25,7 @@
 #include "ns3/trace-source-accessor.h"
 #include "ns3/uinteger.h"
 #include "ns3/pointer.h"
+#include "ns3/boolean.h"
 #include "ns3/mpi-interface.h"
 #include "point-to-point-net-device.h"
 #include "point-to-point-channel.h"
@@ -67,6 +68,13 @@ PointToPointNetDevice::GetTypeId (void)
                    TimeValue (Seconds (0.0)),
                    MakeTimeAccessor (&PointToPointNetDevice::m_tInterframeGap),
                    MakeTimeChecker ())
+    .AddAttribute ("SingleEventTransmission",
+                   "If true, the end of a transmission is only simulated by an event when a packet "
+                   "is queued behind it or when the PhyTxEnd trace is connected, so that an isolated "
+                   "packet only costs its reception event.",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&PointToPointNetDevice::m_singleEvent),
+                   MakeBooleanChecker ())
 
     //
     // Transmit queueing discipline for the device which includes its own set
@@ -147,6 +155,7 @@ PointToPointNetDevice::GetTypeId (void)
 PointToPointNetDevice::PointToPointNetDevice () 
   :
     m_txMachineState (READY),
+    m_singleEvent (false),
     m_channel (0),
     m_linkUp (false),
     m_currentPkt (0)
@@ -222,8 +231,18 @@ PointToPointNetDevice::TransmitStart (Ptr<Packet> p)
   Time txTime = Seconds (m_bps.CalculateTxTime (p->GetSize ()));
   Time txCompleteTime = txTime + m_tInterframeGap;
 
-  NS_LOG_LOGIC ("Schedule TransmitCompleteEvent in " << txCompleteTime.GetSeconds () << "sec");
-  Simulator::Schedule (txCompleteTime, &PointToPointNetDevice::TransmitComplete, this);
+  m_txCompleteTime = Simulator::Now () + txCompleteTime;
+  if (m_singleEvent && m_queue->IsEmpty () && m_phyTxEndTrace.IsEmpty ())
+    {
+      // Nothing to do at the end of the transmission unless a packet is
+      // queued in the meantime, see Send and UpdateTxState.
+      NS_LOG_LOGIC ("Transmission complete in " << txCompleteTime.GetSeconds () << "sec");
+    }
+  else
+    {
+      NS_LOG_LOGIC ("Schedule TransmitCompleteEvent in " << txCompleteTime.GetSeconds () << "sec");
+      m_txCompleteEvent = Simulator::Schedule (txCompleteTime, &PointToPointNetDevice::TransmitComplete, this);
+    }
 
   bool result = m_channel->TransmitStart (p, this, txTime);
   if (result == false)
@@ -269,6 +288,17 @@ PointToPointNetDevice::TransmitComplete (void)
   TransmitStart (p);
 }
 
+void
+PointToPointNetDevice::UpdateTxState (void)
+{
+  if (m_txMachineState == BUSY && !m_txCompleteEvent.IsRunning ()
+      && Simulator::Now () >= m_txCompleteTime)
+    {
+      NS_LOG_LOGIC ("Transmission completed at " << m_txCompleteTime.GetSeconds () << "sec");
+      TransmitComplete ();
+    }
+}
+
 bool
 PointToPointNetDevice::Attach (Ptr<PointToPointChannel> ch)
 {
@@ -487,6 +517,11 @@ PointToPointNetDevice::Send (
 
   m_macTxTrace (packet);
 
+  if (m_singleEvent)
+    {
+      UpdateTxState ();
+    }
+
   //
   // If there's a transmission in progress, we enque the packet for later
   // transmission; otherwise we send it now.
@@ -513,7 +548,17 @@ PointToPointNetDevice::Send (
     }
   else
     {
-      return m_queue->Enqueue (packet);
+      if (m_queue->Enqueue (packet) == false)
+        {
+          return false;
+        }
+      if (m_singleEvent && !m_txCompleteEvent.IsRunning ())
+        {
+          // the queued packet is sent when the current transmission is over
+          m_txCompleteEvent = Simulator::Schedule (m_txCompleteTime - Simulator::Now (),
+                                                   &PointToPointNetDevice::TransmitComplete, this);
+        }
+      return true;
     }
 }
 
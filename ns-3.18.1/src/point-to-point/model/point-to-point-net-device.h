@@ -27,6 +27,7 @@
 #include "ns3/packet.h"
 #include "ns3/traced-callback.h"
 #include "ns3/nstime.h"
+#include "ns3/event-id.h"
 #include "ns3/data-rate.h"
 #include "ns3/ptr.h"
 #include "ns3/mac48-address.h"
@@ -246,6 +247,14 @@ private:
    */
   void TransmitComplete (void);
 
+  /**
+   * Complete the current transmission if it should be over, when no
+   * TransmitComplete event has been scheduled for it.
+   *
+   * @see m_singleEvent
+   */
+  void UpdateTxState (void);
+
   void NotifyLinkUp (void);
 
   /**
@@ -262,6 +271,26 @@ private:
    */
   TxMachineState m_txMachineState;
 
+  /**
+   * If true, the TransmitComplete event of a packet is only scheduled if
+   * it has something to do: start the next packet in the queue, or fire
+   * the PhyTxEnd trace. Otherwise, the transmission is completed by the
+   * next call to Send, and the only event of the packet is its reception
+   * by the remote device.
+   */
+  bool m_singleEvent;
+
+  /**
+   * The TransmitComplete event of the current transmission, if scheduled
+   */
+  EventId m_txCompleteEvent;
+
+  /**
+   * The time at which the current transmission, including the interframe
+   * gap, is over
+   */
+  Time m_txCompleteTime;
+
   /**
    * The data rate that the Net Device uses to simulate packet transmission
    * timing.
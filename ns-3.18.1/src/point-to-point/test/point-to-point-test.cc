@@ -3,6 +3,11 @@
 #include "ns3/simulator.h"
 #include "ns3/point-to-point-net-device.h"
 #include "ns3/point-to-point-channel.h"
+#include "ns3/boolean.h"
+#include "ns3/uinteger.h"
+#include "ns3/data-rate.h"
+#include "ns3/nstime.h"
+#include <vector>
 
 using namespace ns3;
 
@@ -56,6 +61,147 @@ PointToPointTest::DoRun (void)
   Simulator::Destroy ();
 }
 //-----------------------------------------------------------------------------
+/**
+ * Check that the single event transmission mode gives the same receptions,
+ * queue drops and PhyTxEnd traces as the default mode.
+ */
+class PointToPointSingleEventTest : public TestCase
+{
+public:
+  PointToPointSingleEventTest ();
+
+  virtual void DoRun (void);
+
+private:
+  /// times of the events of a run
+  struct Record
+  {
+    std::vector<Time> rx;
+    std::vector<Time> phyTxEnd;
+    uint32_t drops;
+  };
+  Record Run (bool singleEvent, bool tracePhyTxEnd);
+  void SendPacket (Ptr<PointToPointNetDevice> device, uint32_t size);
+  bool Receive (Ptr<NetDevice> device, Ptr<const Packet> p, uint16_t protocol, const Address &from);
+  void PhyTxEnd (Ptr<const Packet> p);
+  void Drop (Ptr<const Packet> p);
+
+  Record m_record;
+};
+
+PointToPointSingleEventTest::PointToPointSingleEventTest ()
+  : TestCase ("PointToPoint single event transmission")
+{
+}
+
+void
+PointToPointSingleEventTest::SendPacket (Ptr<PointToPointNetDevice> device, uint32_t size)
+{
+  Ptr<Packet> p = Create<Packet> (size);
+  device->Send (p, device->GetBroadcast (), 0x800);
+}
+
+bool
+PointToPointSingleEventTest::Receive (Ptr<NetDevice> device, Ptr<const Packet> p, uint16_t protocol, const Address &from)
+{
+  m_record.rx.push_back (Simulator::Now ());
+  return true;
+}
+
+void
+PointToPointSingleEventTest::PhyTxEnd (Ptr<const Packet> p)
+{
+  m_record.phyTxEnd.push_back (Simulator::Now ());
+}
+
+void
+PointToPointSingleEventTest::Drop (Ptr<const Packet> p)
+{
+  m_record.drops++;
+}
+
+PointToPointSingleEventTest::Record
+PointToPointSingleEventTest::Run (bool singleEvent, bool tracePhyTxEnd)
+{
+  m_record = Record ();
+  m_record.drops = 0;
+
+  Ptr<Node> a = CreateObject<Node> ();
+  Ptr<Node> b = CreateObject<Node> ();
+  Ptr<PointToPointNetDevice> devA = CreateObject<PointToPointNetDevice> ();
+  Ptr<PointToPointNetDevice> devB = CreateObject<PointToPointNetDevice> ();
+  Ptr<PointToPointChannel> channel = CreateObject<PointToPointChannel> ();
+  channel->SetAttribute ("Delay", TimeValue (MilliSeconds (2)));
+
+  devA->Attach (channel);
+  devA->SetAddress (Mac48Address::Allocate ());
+  devA->SetAttribute ("DataRate", DataRateValue (DataRate ("1Mbps")));
+  devA->SetAttribute ("InterframeGap", TimeValue (MicroSeconds (10)));
+  devA->SetAttribute ("SingleEventTransmission", BooleanValue (singleEvent));
+  Ptr<DropTailQueue> queue = CreateObject<DropTailQueue> ();
+  queue->SetAttribute ("MaxPackets", UintegerValue (4));
+  queue->TraceConnectWithoutContext ("Drop", MakeCallback (&PointToPointSingleEventTest::Drop, this));
+  devA->SetQueue (queue);
+  devB->Attach (channel);
+  devB->SetAddress (Mac48Address::Allocate ());
+  devB->SetQueue (CreateObject<DropTailQueue> ());
+  devB->SetReceiveCallback (MakeCallback (&PointToPointSingleEventTest::Receive, this));
+  if (tracePhyTxEnd)
+    {
+      devA->TraceConnectWithoutContext ("PhyTxEnd", MakeCallback (&PointToPointSingleEventTest::PhyTxEnd, this));
+    }
+
+  a->AddDevice (devA);
+  b->AddDevice (devB);
+
+  // isolated packets, back-to-back trains and bursts overflowing the queue,
+  // some of them sent exactly when the previous transmission completes
+  Time t = Seconds (1.0);
+  for (uint32_t i = 0; i < 200; i++)
+    {
+      uint32_t size = 100 + (i * 397) % 1400;
+      Simulator::Schedule (t, &PointToPointSingleEventTest::SendPacket, this, devA, size);
+      switch (i % 7)
+        {
+        case 0:
+          t += MilliSeconds (50);
+          break;
+        case 3:
+          t += Seconds (DataRate ("1Mbps").CalculateTxTime (size + 2)) + MicroSeconds (10);
+          break;
+        default:
+          t += MicroSeconds (300 * (i % 5));
+          break;
+        }
+    }
+
+  Simulator::Run ();
+  Simulator::Destroy ();
+  return m_record;
+}
+
+void
+PointToPointSingleEventTest::DoRun (void)
+{
+  Record reference = Run (false, true);
+  NS_TEST_ASSERT_MSG_GT (reference.drops, 0, "the scenario should overflow the queue");
+
+  Record single = Run (true, false);
+  NS_TEST_ASSERT_MSG_EQ (single.drops, reference.drops, "different number of queue drops");
+  NS_TEST_ASSERT_MSG_EQ (single.rx.size (), reference.rx.size (), "different number of receptions");
+  for (uint32_t i = 0; i < single.rx.size () && i < reference.rx.size (); i++)
+    {
+      NS_TEST_ASSERT_MSG_EQ (single.rx[i], reference.rx[i], "different time of reception " << i);
+    }
+
+  Record traced = Run (true, true);
+  NS_TEST_ASSERT_MSG_EQ (traced.phyTxEnd.size (), reference.phyTxEnd.size (), "different number of PhyTxEnd traces");
+  for (uint32_t i = 0; i < traced.phyTxEnd.size () && i < reference.phyTxEnd.size (); i++)
+    {
+      NS_TEST_ASSERT_MSG_EQ (traced.phyTxEnd[i], reference.phyTxEnd[i], "different time of PhyTxEnd " << i);
+    }
+}
+//-----------------------------------------------------------------------------
 class PointToPointTestSuite : public TestSuite
 {
 public:
@@ -66,6 +212,7 @@ PointToPointTestSuite::PointToPointTestSuite ()
   : TestSuite ("devices-point-to-point", UNIT)
 {
   AddTestCase (new PointToPointTest, TestCase::QUICK);
+  AddTestCase (new PointToPointSingleEventTest, TestCase::QUICK);
 }
 
 static PointToPointTestSuite g_pointToPointTestSuite;
@@ -22,6 +22,8 @@
 #include <ns3/spectrum-value.h>
 #include <ns3/math.h>
 #include <ns3/log.h>
+#include <ns3/assert.h>
+#include <algorithm>
 
 NS_LOG_COMPONENT_DEFINE ("SpectrumValue");
 
@@ -30,23 +32,95 @@ namespace ns3 {
 
 
 SpectrumValue::SpectrumValue ()
+  : m_firstBand (0)
 {
 }
 
 SpectrumValue::SpectrumValue (Ptr<const SpectrumModel> sof)
   : m_spectrumModel (sof),
-    m_values (sof->GetNumBands ())
+    m_values (sof->GetNumBands ()),
+    m_firstBand (0)
 {
 
 }
 
+SpectrumValue::SpectrumValue (Ptr<const SpectrumModel> sm, size_t firstBand, size_t lastBand)
+  : m_spectrumModel (sm),
+    m_firstBand (firstBand)
+{
+  NS_ASSERT_MSG (firstBand <= lastBand && lastBand < sm->GetNumBands (),
+                 "invalid band range [" << firstBand << ", " << lastBand << "]");
+  m_values.resize (lastBand - firstBand + 1);
+}
+
 double&
 SpectrumValue:: operator[] (size_t index)
 {
+  if (index >= m_firstBand && index - m_firstBand < m_values.size ())
+    {
+      return m_values[index - m_firstBand];
+    }
+  Densify ();
   return m_values.at (index);
 }
 
 
+bool
+SpectrumValue::IsDense () const
+{
+  return m_spectrumModel == 0
+         || (m_firstBand == 0 && m_values.size () == m_spectrumModel->GetNumBands ());
+}
+
+
+void
+SpectrumValue::Densify () const
+{
+  if (IsDense ())
+    {
+      return;
+    }
+  NS_LOG_FUNCTION (this);
+  Values values (m_spectrumModel->GetNumBands (), 0.0);
+  std::copy (m_values.begin (), m_values.end (), values.begin () + m_firstBand);
+  m_values.swap (values);
+  m_firstBand = 0;
+}
+
+
+void
+SpectrumValue::Extend (size_t firstBand, size_t endBand)
+{
+  size_t end = m_firstBand + m_values.size ();
+  if (endBand <= firstBand || (firstBand >= m_firstBand && endBand <= end))
+    {
+      return;
+    }
+  if (m_values.empty ())
+    {
+      m_values.resize (endBand - firstBand);
+      m_firstBand = firstBand;
+      return;
+    }
+  size_t newFirst = std::min (firstBand, m_firstBand);
+  Values values (std::max (endBand, end) - newFirst, 0.0);
+  std::copy (m_values.begin (), m_values.end (), values.begin () + (m_firstBand - newFirst));
+  m_values.swap (values);
+  m_firstBand = newFirst;
+}
+
+
+double
+SpectrumValue::ValueAt (size_t index) const
+{
+  if (index >= m_firstBand && index - m_firstBand < m_values.size ())
+    {
+      return m_values[index - m_firstBand];
+    }
+  return 0.0;
+}
+
+
 SpectrumModelUid_t
 SpectrumValue::GetSpectrumModelUid () const
 {
@@ -64,12 +138,14 @@ SpectrumValue::GetSpectrumModel () const
 Values::const_iterator
 SpectrumValue::ConstValuesBegin () const
 {
+  Densify ();
   return m_values.begin ();
 }
 
 Values::const_iterator
 SpectrumValue::ConstValuesEnd () const
 {
+  Densify ();
   return m_values.end ();
 }
 
@@ -77,12 +153,14 @@ SpectrumValue::ConstValuesEnd () const
 Values::iterator
 SpectrumValue::ValuesBegin ()
 {
+  Densify ();
   return m_values.begin ();
 }
 
 Values::iterator
 SpectrumValue::ValuesEnd ()
 {
+  Densify ();
   return m_values.end ();
 }
 
@@ -102,14 +180,16 @@ SpectrumValue::ConstBandsEnd () const
 void
 SpectrumValue::Add (const SpectrumValue& x)
 {
-  Values::iterator it1 = m_values.begin ();
-  Values::const_iterator it2 = x.m_values.begin ();
-
   NS_ASSERT (m_spectrumModel == x.m_spectrumModel);
 
-  while (it1 != m_values.end ())
+  // only the bands of x which may be non-zero are touched
+  Extend (x.m_firstBand, x.m_firstBand + x.m_values.size ());
+  Values::iterator it1 = m_values.begin () + (x.m_firstBand - m_firstBand);
+  Values::const_iterator it2 = x.m_values.begin ();
+
+  while (it2 != x.m_values.end ())
     {
-      NS_ASSERT ( it2 != x.m_values.end ());
+      NS_ASSERT ( it1 != m_values.end ());
       *it1 += *it2;
       ++it1;
       ++it2;
@@ -120,6 +200,7 @@ SpectrumValue::Add (const SpectrumValue& x)
 void
 SpectrumValue::Add (double s)
 {
+  Densify ();
   Values::iterator it1 = m_values.begin ();
 
   while (it1 != m_values.end ())
@@ -134,14 +215,15 @@ SpectrumValue::Add (double s)
 void
 SpectrumValue::Subtract (const SpectrumValue& x)
 {
-  Values::iterator it1 = m_values.begin ();
-  Values::const_iterator it2 = x.m_values.begin ();
-
   NS_ASSERT (m_spectrumModel == x.m_spectrumModel);
 
-  while (it1 != m_values.end ())
+  Extend (x.m_firstBand, x.m_firstBand + x.m_values.size ());
+  Values::iterator it1 = m_values.begin () + (x.m_firstBand - m_firstBand);
+  Values::const_iterator it2 = x.m_values.begin ();
+
+  while (it2 != x.m_values.end ())
     {
-      NS_ASSERT ( it2 != x.m_values.end ());
+      NS_ASSERT ( it1 != m_values.end ());
       *it1 -= *it2;
       ++it1;
       ++it2;
@@ -160,17 +242,13 @@ SpectrumValue::Subtract (double s)
 void
 SpectrumValue::Multiply (const SpectrumValue& x)
 {
-  Values::iterator it1 = m_values.begin ();
-  Values::const_iterator it2 = x.m_values.begin ();
-
   NS_ASSERT (m_spectrumModel == x.m_spectrumModel);
 
-  while (it1 != m_values.end ())
+  // the bands outside the range of this value stay zero
+  size_t index = m_firstBand;
+  for (Values::iterator it1 = m_values.begin (); it1 != m_values.end (); ++it1, ++index)
     {
-      NS_ASSERT ( it2 != x.m_values.end ());
-      *it1 *= *it2;
-      ++it1;
-      ++it2;
+      *it1 *= x.ValueAt (index);
     }
 }
 
@@ -193,17 +271,13 @@ SpectrumValue::Multiply (double s)
 void
 SpectrumValue::Divide (const SpectrumValue& x)
 {
-  Values::iterator it1 = m_values.begin ();
-  Values::const_iterator it2 = x.m_values.begin ();
-
   NS_ASSERT (m_spectrumModel == x.m_spectrumModel);
 
-  while (it1 != m_values.end ())
+  Densify ();
+  size_t index = 0;
+  for (Values::iterator it1 = m_values.begin (); it1 != m_values.end (); ++it1, ++index)
     {
-      NS_ASSERT ( it2 != x.m_values.end ());
-      *it1 /= *it2;
-      ++it1;
-      ++it2;
+      *it1 /= x.ValueAt (index);
     }
 }
 
@@ -240,6 +314,7 @@ SpectrumValue::ChangeSign ()
 void
 SpectrumValue::ShiftLeft (int n)
 {
+  Densify ();
   int i = 0;
   while (i < (int) m_values.size () - n)
     {
@@ -257,6 +332,7 @@ SpectrumValue::ShiftLeft (int n)
 void
 SpectrumValue::ShiftRight (int n)
 {
+  Densify ();
   int i = m_values.size () - 1;
   while (i - n >= 0)
     {
@@ -276,6 +352,7 @@ void
 SpectrumValue::Pow (double exp)
 {
   NS_LOG_FUNCTION (this << exp);
+  Densify ();
   Values::iterator it1 = m_values.begin ();
 
   while (it1 != m_values.end ())
@@ -290,6 +367,7 @@ void
 SpectrumValue::Exp (double base)
 {
   NS_LOG_FUNCTION (this << base);
+  Densify ();
   Values::iterator it1 = m_values.begin ();
 
   while (it1 != m_values.end ())
@@ -304,6 +382,7 @@ void
 SpectrumValue::Log10 ()
 {
   NS_LOG_FUNCTION (this);
+  Densify ();
   Values::iterator it1 = m_values.begin ();
 
   while (it1 != m_values.end ())
@@ -317,6 +396,7 @@ void
 SpectrumValue::Log2 ()
 {
   NS_LOG_FUNCTION (this);
+  Densify ();
   Values::iterator it1 = m_values.begin ();
 
   while (it1 != m_values.end ())
@@ -331,6 +411,7 @@ void
 SpectrumValue::Log ()
 {
   NS_LOG_FUNCTION (this);
+  Densify ();
   Values::iterator it1 = m_values.begin ();
 
   while (it1 != m_values.end ())
@@ -404,8 +485,7 @@ Integral (const SpectrumValue& arg)
 Ptr<SpectrumValue>
 SpectrumValue::Copy () const
 {
-  Ptr<SpectrumValue> p = Create<SpectrumValue> (m_spectrumModel);
-  *p = *this;
+  Ptr<SpectrumValue> p = Create<SpectrumValue> (*this);
   return p;
 
   //  return Copy<SpectrumValue> (*this)
@@ -654,6 +734,7 @@ SpectrumValue:: operator/= (double rhs)
 SpectrumValue&
 SpectrumValue:: operator= (double rhs)
 {
+  Densify ();
   Values::iterator it1 = m_values.begin ();
 
   while (it1 != m_values.end ())
@@ -77,6 +77,26 @@ public:
   SpectrumValue (Ptr<const SpectrumModel> sm);
 
 
+  /**
+   * @brief SpectrumValue constructor for a value which is zero outside
+   * of a range of bands
+   *
+   * Only the values of the bands in the range are stored, so that
+   * values which occupy a small part of a wide SpectrumModel (e.g., the
+   * PSD of a transmission over a few resource blocks) take memory and
+   * CPU in proportion of their range only. The value is made dense
+   * transparently, the first time it is accessed outside of its range
+   * or through an iterator, or when an operation can make the bands
+   * outside of its range non-zero. Adding a sparse value to a dense one
+   * only touches the bands in the range of the sparse value.
+   *
+   * @param sm pointer to the SpectrumModel, see SpectrumValue (Ptr<const SpectrumModel>)
+   * @param firstBand the index of the first band which may be non-zero
+   * @param lastBand the index of the last band which may be non-zero
+   */
+  SpectrumValue (Ptr<const SpectrumModel> sm, size_t firstBand, size_t lastBand);
+
+
   SpectrumValue ();
 
 
@@ -98,6 +118,14 @@ public:
   SpectrumModelUid_t GetSpectrumModelUid () const;
 
 
+  /**
+   *
+   * @return true if the values of all the bands are stored, false if
+   * the value is zero outside of a range of bands
+   */
+  bool IsDense () const;
+
+
   /**
    *
    * @return the  embedded SpectrumModel
@@ -121,28 +149,30 @@ public:
 
 
   /**
-   *
+   * If the value is sparse, this makes it dense, which invalidates the
+   * iterators obtained before. Obtain the begin iterator in its own
+   * statement, before the end iterator, or call Densify () first.
    *
    * @return a const iterator pointing to the beginning of the embedded SpectrumModel
    */
   Values::const_iterator ConstValuesBegin () const;
 
   /**
-   *
+   * Obtain it after the begin iterator, see ConstValuesBegin ().
    *
    * @return a const iterator pointing to the end of the embedded SpectrumModel
    */
   Values::const_iterator ConstValuesEnd () const;
 
   /**
-   *
+   * Like ConstValuesBegin (), this makes a sparse value dense.
    *
    * @return an iterator pointing to the beginning of the embedded SpectrumModel
    */
   Values::iterator ValuesBegin ();
 
   /**
-   *
+   * Obtain it after the begin iterator, see ConstValuesBegin ().
    *
    * @return an iterator pointing to the end of the embedded SpectrumModel
    */
@@ -515,6 +545,19 @@ private:
   void Log2 ();
   void Log ();
 
+  /**
+   * Store the values of all the bands
+   */
+  void Densify () const;
+  /**
+   * Make the stored range of bands include [firstBand, endBand)
+   */
+  void Extend (size_t firstBand, size_t endBand);
+  /**
+   * @return the value of a band, zero if it is outside of the stored range
+   */
+  double ValueAt (size_t index) const;
+
   Ptr<const SpectrumModel> m_spectrumModel;
 
 
@@ -525,7 +568,13 @@ private:
  * propagation loss, etc.).
  *
  */
-  Values m_values;
+  mutable Values m_values;
+
+  /**
+   * Index of the band of m_values[0]. The values of the bands outside
+   * of [m_firstBand, m_firstBand + m_values.size ()) are zero.
+   */
+  mutable size_t m_firstBand;
 
 
 };
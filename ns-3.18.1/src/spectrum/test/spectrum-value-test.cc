@@ -83,6 +83,53 @@ SpectrumValueTestCase::DoRun (void)
 
 
 
+// checks that operations on values which are zero outside of a range
+// of bands only make them dense when needed
+class SpectrumValueSparseTestCase : public TestCase
+{
+public:
+  SpectrumValueSparseTestCase (Ptr<const SpectrumModel> sm);
+  virtual ~SpectrumValueSparseTestCase ();
+  virtual void DoRun (void);
+
+private:
+  Ptr<const SpectrumModel> m_sm;
+};
+
+SpectrumValueSparseTestCase::SpectrumValueSparseTestCase (Ptr<const SpectrumModel> sm)
+  : TestCase ("sparse values are made dense only when needed"),
+    m_sm (sm)
+{
+}
+
+SpectrumValueSparseTestCase::~SpectrumValueSparseTestCase ()
+{
+}
+
+void
+SpectrumValueSparseTestCase::DoRun (void)
+{
+  SpectrumValue s1 (m_sm, 1, 1), s2 (m_sm, 3, 3), d (m_sm);
+  s1[1] = 1.0;
+  s2[3] = 2.0;
+  NS_TEST_ASSERT_MSG_EQ (s1.IsDense (), false, "s1 should be sparse");
+  NS_TEST_ASSERT_MSG_EQ (d.IsDense (), true, "d should be dense");
+
+  SpectrumValue sum = s1 + s2;
+  sum *= 3.0;
+  NS_TEST_ASSERT_MSG_EQ (sum.IsDense (), false, "sum of sparse values should be sparse");
+  d += sum;
+  d -= s1;
+  NS_TEST_ASSERT_MSG_EQ (s1.IsDense (), false, "s1 should stay sparse when added to a dense value");
+  NS_TEST_ASSERT_MSG_EQ (sum[2], 0.0, "band between the ranges should be zero");
+  NS_TEST_ASSERT_MSG_EQ (sum.IsDense (), false, "access in the range should not make the value dense");
+  NS_TEST_ASSERT_MSG_EQ (sum[0], 0.0, "band outside of the range should be zero");
+  NS_TEST_ASSERT_MSG_EQ (sum.IsDense (), true, "access out of the range should make the value dense");
+  NS_TEST_ASSERT_MSG_EQ_TOL (Sum (d), 8.0, TOLERANCE, "wrong sum");
+}
+
+
+
 class SpectrumValueTestSuite : public TestSuite
 {
 public:
@@ -242,6 +289,44 @@ SpectrumValueTestSuite::SpectrumValueTestSuite ()
   tv1rs3 = v1 >> 3;
   AddTestCase (new SpectrumValueTestCase (tv1rs3, v1rs3, "tv1rs3 = v1 >> 3"), TestCase::QUICK);
 
+  // values which are zero outside of a range of bands, and their dense equivalents
+  SpectrumValue s1 (f, 1, 2), s2 (f, 3, 4), d1 (f), d2 (f);
+  s1[1] = d1[1] = v1[1];
+  s1[2] = d1[2] = v1[2];
+  s2[3] = d2[3] = v2[3];
+  s2[4] = d2[4] = v2[4];
+
+  SpectrumValue ts1 = v1 + s1;
+  SpectrumValue td1 = v1 + d1;
+  AddTestCase (new SpectrumValueTestCase (ts1, td1, "v1 + s1"), TestCase::QUICK);
+  SpectrumValue ts2 = s1 + s2;
+  SpectrumValue td2 = d1 + d2;
+  AddTestCase (new SpectrumValueTestCase (ts2, td2, "s1 + s2"), TestCase::QUICK);
+  SpectrumValue ts3 = s1 - v2;
+  SpectrumValue td3 = d1 - v2;
+  AddTestCase (new SpectrumValueTestCase (ts3, td3, "s1 - v2"), TestCase::QUICK);
+  SpectrumValue ts4 = s1 * v2;
+  SpectrumValue td4 = d1 * v2;
+  AddTestCase (new SpectrumValueTestCase (ts4, td4, "s1 * v2"), TestCase::QUICK);
+  SpectrumValue ts5 = v2 * s1;
+  SpectrumValue td5 = v2 * d1;
+  AddTestCase (new SpectrumValueTestCase (ts5, td5, "v2 * s1"), TestCase::QUICK);
+  SpectrumValue ts6 = s1 / v2;
+  SpectrumValue td6 = d1 / v2;
+  AddTestCase (new SpectrumValueTestCase (ts6, td6, "s1 div v2"), TestCase::QUICK);
+  SpectrumValue ts7 = s1 * doubleValue + doubleValue;
+  SpectrumValue td7 = d1 * doubleValue + doubleValue;
+  AddTestCase (new SpectrumValueTestCase (ts7, td7, "s1 * doubleValue + doubleValue"), TestCase::QUICK);
+  SpectrumValue ts8 = s2 << 3;
+  SpectrumValue td8 = d2 << 3;
+  AddTestCase (new SpectrumValueTestCase (ts8, td8, "s2 << 3"), TestCase::QUICK);
+  SpectrumValue ts9 = s1;
+  ts9 += s2;
+  ts9 -= s1;
+  SpectrumValue td9 = d2;
+  AddTestCase (new SpectrumValueTestCase (ts9, td9, "s1 += s2, -= s1"), TestCase::QUICK);
+  AddTestCase (new SpectrumValueSparseTestCase (f), TestCase::QUICK);
+
 
 }
 
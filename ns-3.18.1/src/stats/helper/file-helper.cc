@@ -25,6 +25,7 @@
 #include "file-helper.h"
 #include "ns3/abort.h"
 #include "ns3/log.h"
+#include "ns3/uinteger.h"
 #include "ns3/config.h"
 #include "ns3/get-wildcard-matches.h"
 
@@ -35,6 +36,7 @@ NS_LOG_COMPONENT_DEFINE ("FileHelper");
 FileHelper::FileHelper ()
   : m_aggregator                     (0),
     m_fileProbeCount                 (0),
+    m_batchSize                      (0),
     m_fileType                       (FileAggregator::SPACE_SEPARATED),
     m_outputFileNameWithoutExtension ("file-helper"),
     m_hasHeadingBeenSet              (false)
@@ -49,6 +51,7 @@ FileHelper::FileHelper (const std::string &outputFileNameWithoutExtension,
                         enum FileAggregator::FileType fileType)
   : m_aggregator                     (0),
     m_fileProbeCount                 (0),
+    m_batchSize                      (0),
     m_fileType                       (fileType),
     m_outputFileNameWithoutExtension (outputFileNameWithoutExtension),
     m_hasHeadingBeenSet              (false)
@@ -212,6 +215,13 @@ FileHelper::AddProbe (const std::string &typeId,
   m_probeMap[probeName] = std::make_pair (probe, typeId);
 }
 
+void
+FileHelper::SetBatchSize (uint32_t batchSize)
+{
+  NS_LOG_FUNCTION (this << batchSize);
+  m_batchSize = batchSize;
+}
+
 void
 FileHelper::AddTimeSeriesAdaptor (const std::string &adaptorName)
 {
@@ -228,6 +238,7 @@ FileHelper::AddTimeSeriesAdaptor (const std::string &adaptorName)
 
   // Enable logging of data for the time series adaptor.
   timeSeriesAdaptor->Enable ();
+  timeSeriesAdaptor->SetAttribute ("BatchSize", UintegerValue (m_batchSize));
 
   // Add this time series adaptor to the map so that it can be used.
   m_timeSeriesAdaptorMap[adaptorName] = timeSeriesAdaptor;
@@ -554,6 +565,15 @@ FileHelper::ConnectProbeToAggregator (const std::string &typeId,
   AddAggregator (probeContext, outputFileName, onlyOneAggregator);
 
   // Connect the adaptor to the aggregator.
+  if (m_batchSize > 0)
+    {
+      m_timeSeriesAdaptorMap[probeContext]->TraceConnect
+        ("OutputBatch",
+        probeContext,
+        MakeCallback (&FileAggregator::Write2dBatch,
+                      m_aggregatorMap[probeContext]));
+      return;
+    }
   std::string adaptorTraceSource = "Output";
   m_timeSeriesAdaptorMap[probeContext]->TraceConnect
     (adaptorTraceSource,
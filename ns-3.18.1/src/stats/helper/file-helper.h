@@ -119,6 +119,16 @@ public:
    */
   void AddTimeSeriesAdaptor (const std::string &adaptorName);
 
+  /**
+   * \param batchSize number of samples buffered by each time series
+   * adaptor before they are sent to the aggregator, or 0 to send them
+   * one by one.
+   *
+   * \brief Sets the batch size of the time series adaptors that are
+   * added after this call.
+   */
+  void SetBatchSize (uint32_t batchSize);
+
   /**
    * \param aggregatorName the aggregator's name.
    * \param outputFileName name of the file to write.
@@ -291,6 +301,9 @@ private:
   /// Number of file probes that have been created.
   uint32_t m_fileProbeCount;
 
+  /// Batch size of the time series adaptors.
+  uint32_t m_batchSize;
+
   /// Determines the kind of file written by the aggregator.
   enum FileAggregator::FileType m_fileType;
 
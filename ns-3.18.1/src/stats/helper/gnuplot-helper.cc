@@ -28,6 +28,7 @@
 #include "ns3/assert.h"
 #include "ns3/config.h"
 #include "ns3/log.h"
+#include "ns3/uinteger.h"
 #include "ns3/get-wildcard-matches.h"
 
 namespace ns3 {
@@ -37,6 +38,7 @@ NS_LOG_COMPONENT_DEFINE ("GnuplotHelper");
 GnuplotHelper::GnuplotHelper ()
   : m_aggregator                     (0),
     m_plotProbeCount                 (0),
+    m_batchSize                      (0),
     m_outputFileNameWithoutExtension ("gnuplot-helper"),
     m_title                          ("Gnuplot Helper Plot"),
     m_xLegend                        ("X Values"),
@@ -56,6 +58,7 @@ GnuplotHelper::GnuplotHelper (const std::string &outputFileNameWithoutExtension,
                               const std::string &terminalType)
   : m_aggregator                     (0),
     m_plotProbeCount                 (0),
+    m_batchSize                      (0),
     m_outputFileNameWithoutExtension (outputFileNameWithoutExtension),
     m_title                          (title),
     m_xLegend                        (xLegend),
@@ -234,6 +237,13 @@ GnuplotHelper::AddProbe (const std::string &typeId,
   m_probeMap[probeName] = std::make_pair (probe, typeId);
 }
 
+void
+GnuplotHelper::SetBatchSize (uint32_t batchSize)
+{
+  NS_LOG_FUNCTION (this << batchSize);
+  m_batchSize = batchSize;
+}
+
 void
 GnuplotHelper::AddTimeSeriesAdaptor (const std::string &adaptorName)
 {
@@ -250,6 +260,7 @@ GnuplotHelper::AddTimeSeriesAdaptor (const std::string &adaptorName)
 
   // Enable logging of data for the time series adaptor.
   timeSeriesAdaptor->Enable ();
+  timeSeriesAdaptor->SetAttribute ("BatchSize", UintegerValue (m_batchSize));
 
   // Add this time series adaptor to the map so that can be used.
   m_timeSeriesAdaptorMap[adaptorName] = timeSeriesAdaptor;
@@ -406,11 +417,21 @@ GnuplotHelper::ConnectProbeToAggregator (const std::string &typeId,
     }
 
   // Connect the adaptor to the aggregator.
-  std::string adaptorTraceSource = "Output";
-  m_timeSeriesAdaptorMap[probeContext]->TraceConnect
-    (adaptorTraceSource,
-    probeContext,
-    MakeCallback (&GnuplotAggregator::Write2d, aggregator));
+  if (m_batchSize > 0)
+    {
+      m_timeSeriesAdaptorMap[probeContext]->TraceConnect
+        ("OutputBatch",
+        probeContext,
+        MakeCallback (&GnuplotAggregator::Write2dBatch, aggregator));
+    }
+  else
+    {
+      std::string adaptorTraceSource = "Output";
+      m_timeSeriesAdaptorMap[probeContext]->TraceConnect
+        (adaptorTraceSource,
+        probeContext,
+        MakeCallback (&GnuplotAggregator::Write2d, aggregator));
+    }
 
   // Add the dataset to the plot.
   aggregator->Add2dDataset (probeContext, title);
@@ -137,6 +137,16 @@ public:
    */
   void AddTimeSeriesAdaptor (const std::string &adaptorName);
 
+  /**
+   * \param batchSize number of samples buffered by each time series
+   * adaptor before they are sent to the aggregator, or 0 to send them
+   * one by one.
+   *
+   * \brief Sets the batch size of the time series adaptors that are
+   * added after this call.
+   */
+  void SetBatchSize (uint32_t batchSize);
+
   /**
    * \param probeName the probe's name.
    *
@@ -189,6 +199,9 @@ private:
   /// Number of plot probes that have been created.
   uint32_t m_plotProbeCount;
 
+  /// Batch size of the time series adaptors.
+  uint32_t m_batchSize;
+
   /// The name of the output file to created without its extension.
   std::string m_outputFileNameWithoutExtension;
 
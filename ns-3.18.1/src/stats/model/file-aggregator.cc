@@ -75,7 +75,14 @@ FileAggregator::FileAggregator (const std::string &outputFileName,
       break;
     }
 
-  m_file.open (m_outputFileName.c_str ());
+  if (m_fileType == BINARY)
+    {
+      m_file.open (m_outputFileName.c_str (), std::ios::out | std::ios::binary);
+    }
+  else
+    {
+      m_file.open (m_outputFileName.c_str ());
+    }
 }
 
 FileAggregator::~FileAggregator ()
@@ -100,8 +107,11 @@ FileAggregator::SetHeading (const std::string &heading)
       m_heading = heading;
       m_hasHeadingBeenSet = true;
 
-      // Print the heading to the file.
-      m_file << m_heading << std::endl;
+      // Print the heading to the file, unless it is a binary file.
+      if (m_fileType != BINARY)
+        {
+          m_file << m_heading << "\n";
+        }
     }
 }
 
@@ -184,7 +194,12 @@ FileAggregator::Write1d (std::string context,
   if (m_enabled)
     {
       // Write the 1D data point to the file.
-      if (m_fileType == FORMATTED)
+      if (m_fileType == BINARY)
+        {
+          double values[] = { v1 };
+          m_file.write (reinterpret_cast<const char *> (values), sizeof (values));
+        }
+      else if (m_fileType == FORMATTED)
         {
           // Initially, have the C-style string in the buffer, which
           // is terminated by a null character, be of length zero.
@@ -203,12 +218,12 @@ FileAggregator::Write1d (std::string context,
             }
 
           // Write the formatted value.
-          m_file << buffer << std::endl;
+          m_file << buffer << "\n";
         }
       else
         {
           // Write the value.
-          m_file << v1 << std::endl;
+          m_file << v1 << "\n";
         }
     }
 }
@@ -223,7 +238,12 @@ FileAggregator::Write2d (std::string context,
   if (m_enabled)
     {
       // Write the 2D data point to the file.
-      if (m_fileType == FORMATTED)
+      if (m_fileType == BINARY)
+        {
+          double values[] = { v1, v2 };
+          m_file.write (reinterpret_cast<const char *> (values), sizeof (values));
+        }
+      else if (m_fileType == FORMATTED)
         {
           // Initially, have the C-style string in the buffer, which
           // is terminated by a null character, be of length zero.
@@ -243,17 +263,46 @@ FileAggregator::Write2d (std::string context,
             }
 
           // Write the formatted values.
-          m_file << buffer << std::endl;
+          m_file << buffer << "\n";
         }
       else
         {
           // Write the values with the proper separator.
           m_file << v1 << m_separator
-                 << v2 << std::endl;
+                 << v2 << "\n";
         }
     }
 }
 
+void
+FileAggregator::Write2dBatch (std::string context,
+                              const std::vector<double> &v1,
+                              const std::vector<double> &v2)
+{
+  NS_LOG_FUNCTION (this << context << v1.size ());
+  NS_ASSERT (v1.size () == v2.size ());
+
+  if (!m_enabled)
+    {
+      return;
+    }
+  if (m_fileType == BINARY)
+    {
+      // Interleave the two columns so that the file has the same
+      // layout as if the data points had been written one by one.
+      for (std::vector<double>::size_type i = 0; i < v1.size (); i++)
+        {
+          double values[] = { v1[i], v2[i] };
+          m_file.write (reinterpret_cast<const char *> (values), sizeof (values));
+        }
+      return;
+    }
+  for (std::vector<double>::size_type i = 0; i < v1.size (); i++)
+    {
+      Write2d (context, v1[i], v2[i]);
+    }
+}
+
 void
 FileAggregator::Write3d (std::string context,
                          double v1,
@@ -265,7 +314,12 @@ FileAggregator::Write3d (std::string context,
   if (m_enabled)
     {
       // Write the 3D data point to the file.
-      if (m_fileType == FORMATTED)
+      if (m_fileType == BINARY)
+        {
+          double values[] = { v1, v2, v3 };
+          m_file.write (reinterpret_cast<const char *> (values), sizeof (values));
+        }
+      else if (m_fileType == FORMATTED)
         {
           // Initially, have the C-style string in the buffer, which
           // is terminated by a null character, be of length zero.
@@ -286,14 +340,14 @@ FileAggregator::Write3d (std::string context,
             }
 
           // Write the formatted values.
-          m_file << buffer << std::endl;
+          m_file << buffer << "\n";
         }
       else
         {
           // Write the values with the proper separator.
           m_file << v1 << m_separator
                  << v2 << m_separator
-                 << v3 << std::endl;
+                 << v3 << "\n";
         }
     }
 }
@@ -310,7 +364,12 @@ FileAggregator::Write4d (std::string context,
   if (m_enabled)
     {
       // Write the 4D data point to the file.
-      if (m_fileType == FORMATTED)
+      if (m_fileType == BINARY)
+        {
+          double values[] = { v1, v2, v3, v4 };
+          m_file.write (reinterpret_cast<const char *> (values), sizeof (values));
+        }
+      else if (m_fileType == FORMATTED)
         {
           // Initially, have the C-style string in the buffer, which
           // is terminated by a null character, be of length zero.
@@ -332,7 +391,7 @@ FileAggregator::Write4d (std::string context,
             }
 
           // Write the formatted values.
-          m_file << buffer << std::endl;
+          m_file << buffer << "\n";
         }
       else
         {
@@ -340,7 +399,7 @@ FileAggregator::Write4d (std::string context,
           m_file << v1 << m_separator
                  << v2 << m_separator
                  << v3 << m_separator
-                 << v4 << std::endl;
+                 << v4 << "\n";
         }
     }
 }
@@ -358,7 +417,12 @@ FileAggregator::Write5d (std::string context,
   if (m_enabled)
     {
       // Write the 5D data point to the file.
-      if (m_fileType == FORMATTED)
+      if (m_fileType == BINARY)
+        {
+          double values[] = { v1, v2, v3, v4, v5 };
+          m_file.write (reinterpret_cast<const char *> (values), sizeof (values));
+        }
+      else if (m_fileType == FORMATTED)
         {
           // Initially, have the C-style string in the buffer, which
           // is terminated by a null character, be of length zero.
@@ -381,7 +445,7 @@ FileAggregator::Write5d (std::string context,
             }
 
           // Write the formatted values.
-          m_file << buffer << std::endl;
+          m_file << buffer << "\n";
         }
       else
         {
@@ -390,7 +454,7 @@ FileAggregator::Write5d (std::string context,
                  << v2 << m_separator
                  << v3 << m_separator
                  << v4 << m_separator
-                 << v5 << std::endl;
+                 << v5 << "\n";
         }
     }
 }
@@ -409,7 +473,12 @@ FileAggregator::Write6d (std::string context,
   if (m_enabled)
     {
       // Write the 6D data point to the file.
-      if (m_fileType == FORMATTED)
+      if (m_fileType == BINARY)
+        {
+          double values[] = { v1, v2, v3, v4, v5, v6 };
+          m_file.write (reinterpret_cast<const char *> (values), sizeof (values));
+        }
+      else if (m_fileType == FORMATTED)
         {
           // Initially, have the C-style string in the buffer, which
           // is terminated by a null character, be of length zero.
@@ -433,7 +502,7 @@ FileAggregator::Write6d (std::string context,
             }
 
           // Write the formatted values.
-          m_file << buffer << std::endl;
+          m_file << buffer << "\n";
         }
       else
         {
@@ -443,7 +512,7 @@ FileAggregator::Write6d (std::string context,
                  << v3 << m_separator
                  << v4 << m_separator
                  << v5 << m_separator
-                 << v6 << std::endl;
+                 << v6 << "\n";
         }
     }
 }
@@ -463,7 +532,12 @@ FileAggregator::Write7d (std::string context,
   if (m_enabled)
     {
       // Write the 7D data point to the file.
-      if (m_fileType == FORMATTED)
+      if (m_fileType == BINARY)
+        {
+          double values[] = { v1, v2, v3, v4, v5, v6, v7 };
+          m_file.write (reinterpret_cast<const char *> (values), sizeof (values));
+        }
+      else if (m_fileType == FORMATTED)
         {
           // Initially, have the C-style string in the buffer, which
           // is terminated by a null character, be of length zero.
@@ -488,7 +562,7 @@ FileAggregator::Write7d (std::string context,
             }
 
           // Write the formatted values.
-          m_file << buffer << std::endl;
+          m_file << buffer << "\n";
         }
       else
         {
@@ -499,7 +573,7 @@ FileAggregator::Write7d (std::string context,
                  << v4 << m_separator
                  << v5 << m_separator
                  << v6 << m_separator
-                 << v7 << std::endl;
+                 << v7 << "\n";
         }
     }
 }
@@ -520,7 +594,12 @@ FileAggregator::Write8d (std::string context,
   if (m_enabled)
     {
       // Write the 8D data point to the file.
-      if (m_fileType == FORMATTED)
+      if (m_fileType == BINARY)
+        {
+          double values[] = { v1, v2, v3, v4, v5, v6, v7, v8 };
+          m_file.write (reinterpret_cast<const char *> (values), sizeof (values));
+        }
+      else if (m_fileType == FORMATTED)
         {
           // Initially, have the C-style string in the buffer, which
           // is terminated by a null character, be of length zero.
@@ -546,7 +625,7 @@ FileAggregator::Write8d (std::string context,
             }
 
           // Write the formatted values.
-          m_file << buffer << std::endl;
+          m_file << buffer << "\n";
         }
       else
         {
@@ -558,7 +637,7 @@ FileAggregator::Write8d (std::string context,
                  << v5 << m_separator
                  << v6 << m_separator
                  << v7 << m_separator
-                 << v8 << std::endl;
+                 << v8 << "\n";
         }
     }
 }
@@ -579,7 +658,12 @@ FileAggregator::Write9d (std::string context,
   if (m_enabled)
     {
       // Write the 9D data point to the file.
-      if (m_fileType == FORMATTED)
+      if (m_fileType == BINARY)
+        {
+          double values[] = { v1, v2, v3, v4, v5, v6, v7, v8, v9 };
+          m_file.write (reinterpret_cast<const char *> (values), sizeof (values));
+        }
+      else if (m_fileType == FORMATTED)
         {
           // Initially, have the C-style string in the buffer, which
           // is terminated by a null character, be of length zero.
@@ -606,7 +690,7 @@ FileAggregator::Write9d (std::string context,
             }
 
           // Write the formatted values.
-          m_file << buffer << std::endl;
+          m_file << buffer << "\n";
         }
       else
         {
@@ -619,7 +703,7 @@ FileAggregator::Write9d (std::string context,
                  << v6 << m_separator
                  << v7 << m_separator
                  << v8 << m_separator
-                 << v9 << std::endl;
+                 << v9 << "\n";
         }
     }
 }
@@ -641,7 +725,12 @@ FileAggregator::Write10d (std::string context,
   if (m_enabled)
     {
       // Write the 10D data point to the file.
-      if (m_fileType == FORMATTED)
+      if (m_fileType == BINARY)
+        {
+          double values[] = { v1, v2, v3, v4, v5, v6, v7, v8, v9, v10 };
+          m_file.write (reinterpret_cast<const char *> (values), sizeof (values));
+        }
+      else if (m_fileType == FORMATTED)
         {
           // Initially, have the C-style string in the buffer, which
           // is terminated by a null character, be of length zero.
@@ -669,7 +758,7 @@ FileAggregator::Write10d (std::string context,
             }
 
           // Write the formatted values.
-          m_file << buffer << std::endl;
+          m_file << buffer << "\n";
         }
       else
         {
@@ -683,7 +772,7 @@ FileAggregator::Write10d (std::string context,
                  << v7 << m_separator
                  << v8 << m_separator
                  << v9 << m_separator
-                 << v10 << std::endl;
+                 << v10 << "\n";
         }
     }
 }
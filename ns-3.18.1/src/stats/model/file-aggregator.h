@@ -27,6 +27,7 @@
 #include <fstream>
 #include <map>
 #include <string>
+#include <vector>
 #include "ns3/data-collection-object.h"
 
 namespace ns3 {
@@ -37,13 +38,18 @@ namespace ns3 {
 class FileAggregator : public DataCollectionObject
 {
 public:
-  /// The type of file written by the aggregator.
+  /**
+   * The type of file written by the aggregator.  BINARY files contain
+   * the values as raw doubles in host byte order, without heading nor
+   * separators.
+   */
   enum FileType
   {
     FORMATTED,
     SPACE_SEPARATED,
     COMMA_SEPARATED,
-    TAB_SEPARATED
+    TAB_SEPARATED,
+    BINARY
   };
 
   static TypeId GetTypeId ();
@@ -185,6 +191,18 @@ public:
                 double v1,
                 double v2);
 
+  /**
+   * \param context specifies the 2D dataset these values came from.
+   * \param v1 first values of the new data points.
+   * \param v2 second values of the new data points.
+   *
+   * \brief Writes a batch of 2D data points to the file, as sent by
+   * the OutputBatch trace source of TimeSeriesAdaptor.
+   */
+  void Write2dBatch (std::string context,
+                     const std::vector<double> &v1,
+                     const std::vector<double> &v2);
+
   /**
    * \param context specifies the 3D dataset these values came from.
    * \param v1 first value for the new data point.
@@ -116,6 +116,30 @@ GnuplotAggregator::Write2d (std::string context, double x, double y)
     }
 }
 
+void
+GnuplotAggregator::Write2dBatch (std::string context,
+                                 const std::vector<double> &x,
+                                 const std::vector<double> &y)
+{
+  NS_LOG_FUNCTION (this << context << x.size ());
+  NS_ASSERT (x.size () == y.size ());
+
+  std::map<std::string, Gnuplot2dDataset>::iterator dataset = m_2dDatasetMap.find (context);
+  if (dataset == m_2dDatasetMap.end ())
+    {
+      NS_ABORT_MSG ("Dataset " << context << " has not been added");
+    }
+
+  if (m_enabled)
+    {
+      // Add these 2D data points to their dataset.
+      for (std::vector<double>::size_type i = 0; i < x.size (); i++)
+        {
+          dataset->second.Add (x[i], y[i]);
+        }
+    }
+}
+
 void
 GnuplotAggregator::Write2dWithXErrorDelta (std::string context,
                                            double x,
@@ -26,6 +26,7 @@
 
 #include <map>
 #include <string>
+#include <vector>
 #include "ns3/gnuplot.h"
 #include "ns3/data-collection-object.h"
 
@@ -78,6 +79,20 @@ public:
    */
   void Write2d (std::string context, double x, double y);
 
+  /**
+   * \param context specifies the gnuplot 2D dataset for these values
+   * \param x x coordinates for the new data points
+   * \param y y coordinates for the new data points
+   *
+   * \brief Writes a batch of 2D values to a 2D gnuplot dataset, as
+   * sent by the OutputBatch trace source of TimeSeriesAdaptor.
+   *
+   * Use this method with error bar style NONE.
+   */
+  void Write2dBatch (std::string context,
+                     const std::vector<double> &x,
+                     const std::vector<double> &y);
+
   /**
    * \param context specifies the gnuplot 2D dataset for these values
    * \param x x coordinate for the new data point
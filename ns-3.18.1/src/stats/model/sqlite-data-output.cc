@@ -19,6 +19,13 @@
  */
 
 #include <sstream>
+#include <vector>
+#include <cerrno>
+#include <cstring>
+#include <stdlib.h>
+#include <limits.h>
+#include <fcntl.h>
+#include <unistd.h>
 
 #include <sqlite3.h>
 
@@ -33,9 +40,75 @@ using namespace ns3;
 
 NS_LOG_COMPONENT_DEFINE ("SqliteDataOutput");
 
+namespace {
+
+// Records are lines of tab separated fields; tabs, newlines and
+// backslashes within the fields are escaped with a backslash.
+std::string
+EscapeField (const std::string &field)
+{
+  std::string escaped;
+  escaped.reserve (field.size ());
+  for (std::string::const_iterator i = field.begin (); i != field.end (); i++)
+    {
+      switch (*i)
+        {
+        case '\\':
+          escaped += "\\\\";
+          break;
+        case '\t':
+          escaped += "\\t";
+          break;
+        case '\n':
+          escaped += "\\n";
+          break;
+        default:
+          escaped += *i;
+          break;
+        }
+    }
+  return escaped;
+}
+
+std::vector<std::string>
+SplitRecord (const std::string &line)
+{
+  std::vector<std::string> fields (1);
+  for (std::string::size_type i = 0; i < line.size (); i++)
+    {
+      if (line[i] == '\t')
+        {
+          fields.push_back ("");
+        }
+      else if (line[i] == '\\' && i + 1 < line.size ())
+        {
+          i++;
+          fields.back () += line[i] == 't' ? '\t' : line[i] == 'n' ? '\n' : line[i];
+        }
+      else
+        {
+          fields.back () += line[i];
+        }
+    }
+  return fields;
+}
+
+void
+BindText (sqlite3_stmt *stmt, int index, const std::string &text)
+{
+  sqlite3_bind_text (stmt, index, text.c_str (), text.size (), SQLITE_TRANSIENT);
+}
+
+} // anonymous namespace
+
 //--------------------------------------------------------------
 //----------------------------------------------
 SqliteDataOutput::SqliteDataOutput()
+  : m_db (0),
+    m_insertExperiment (0),
+    m_insertMetadata (0),
+    m_insertSingleton (0),
+    m_recordFd (-1)
 {
   m_filePrefix = "data";
   NS_LOG_FUNCTION_NOARGS ();
@@ -49,10 +122,77 @@ SqliteDataOutput::DoDispose ()
 {
   NS_LOG_FUNCTION_NOARGS ();
 
+  Close ();
+  if (m_recordFd != -1)
+    {
+      close (m_recordFd);
+      m_recordFd = -1;
+    }
   DataOutputInterface::DoDispose ();
   // end SqliteDataOutput::DoDispose
 }
 
+bool
+SqliteDataOutput::Open (void)
+{
+  std::string dbFile = m_filePrefix + ".db";
+  if (m_db != 0 && dbFile == m_dbFile)
+    {
+      return true;
+    }
+  Close ();
+
+  m_dbFile = dbFile;
+  if (sqlite3_open (m_dbFile.c_str (), &m_db)) {
+      NS_LOG_ERROR ("Could not open sqlite3 database \"" << m_dbFile << "\"");
+      NS_LOG_ERROR ("sqlite3 error \"" << sqlite3_errmsg (m_db) << "\"");
+      sqlite3_close (m_db);
+      m_db = 0;
+      /// \todo Better error reporting, management!
+      return false;
+    }
+
+  // Let the simulations writing to the same database wait for each
+  // other rather than fail, and let readers run alongside the writer.
+  sqlite3_busy_timeout (m_db, 60000);
+  Exec ("PRAGMA journal_mode=WAL");
+  Exec ("PRAGMA synchronous=NORMAL");
+
+  Exec ("create table if not exists Experiments (run, experiment, strategy, input, description text)");
+  Exec ("create table if not exists Metadata ( run text, key text, value)");
+  Exec ("create table if not exists Singletons ( run text, name text, variable text, value )");
+
+  if (sqlite3_prepare_v2 (m_db, "insert into Experiments (run,experiment,strategy,input,description) values (?,?,?,?,?)",
+                          -1, &m_insertExperiment, 0) != SQLITE_OK
+      || sqlite3_prepare_v2 (m_db, "insert into Metadata (run,key,value) values (?,?,?)",
+                             -1, &m_insertMetadata, 0) != SQLITE_OK
+      || sqlite3_prepare_v2 (m_db, "insert into Singletons (run,name,variable,value) values (?,?,?,?)",
+                             -1, &m_insertSingleton, 0) != SQLITE_OK) {
+      NS_LOG_ERROR ("sqlite3 error \"" << sqlite3_errmsg (m_db) << "\"");
+      Close ();
+      return false;
+    }
+  return true;
+
+  // end SqliteDataOutput::Open
+}
+
+void
+SqliteDataOutput::Close (void)
+{
+  sqlite3_finalize (m_insertExperiment);
+  sqlite3_finalize (m_insertMetadata);
+  sqlite3_finalize (m_insertSingleton);
+  m_insertExperiment = 0;
+  m_insertMetadata = 0;
+  m_insertSingleton = 0;
+  if (m_db != 0) {
+      sqlite3_close (m_db);
+      m_db = 0;
+    }
+  // end SqliteDataOutput::Close
+}
+
 int
 SqliteDataOutput::Exec (std::string exe) {
   int res;
@@ -69,25 +209,7 @@ SqliteDataOutput::Exec (std::string exe) {
 
   if (res != SQLITE_OK) {
       NS_LOG_ERROR ("sqlite3 error: \"" << errMsg << "\"");
-      /*
-      } else {
-        // std::cout << "nrows " << nrows << " ncols " << ncols << std::endl;
-
-        if (nrows > 0) {
-          for (int i = 0; i < ncols; i++) {
-            std::cout << "  " << result[i];
-          }
-          std::cout << std::endl;
-
-          for (int r = 1; r <= nrows; r++) {
-            for (int c = 0; c < ncols; c++) {
-              std::cout << "  " << result[(r*ncols)+c];
-            }
-            std::cout << std::endl;
-          }
-          std::cout << std::endl;
-        }
-      */
+      sqlite3_free (errMsg);
     }
 
   sqlite3_free_table (result);
@@ -96,62 +218,251 @@ SqliteDataOutput::Exec (std::string exe) {
   // end SqliteDataOutput::Exec
 }
 
-//----------------------------------------------
+int
+SqliteDataOutput::Step (sqlite3_stmt *stmt)
+{
+  int res = sqlite3_step (stmt);
+  if (res != SQLITE_DONE) {
+      NS_LOG_ERROR ("sqlite3 error: \"" << sqlite3_errmsg (m_db) << "\"");
+    }
+  sqlite3_reset (stmt);
+  sqlite3_clear_bindings (stmt);
+  return res;
+}
+
 void
-SqliteDataOutput::Output (DataCollector &dc)
+SqliteDataOutput::SetRecordFile (std::string path)
 {
-  std::string m_dbFile = m_filePrefix + ".db";
+  NS_LOG_FUNCTION (this << path);
+  if (m_recordFd != -1) {
+      close (m_recordFd);
+      m_recordFd = -1;
+    }
+  m_recordFile = path;
+}
 
-  if (sqlite3_open (m_dbFile.c_str (), &m_db)) {
-      NS_LOG_ERROR ("Could not open sqlite3 database \"" << m_dbFile << "\"");
-      NS_LOG_ERROR ("sqlite3 error \"" << sqlite3_errmsg (m_db) << "\"");
-      sqlite3_close (m_db);
-      /// \todo Better error reporting, management!
+void
+SqliteDataOutput::WriteRecord (std::string record)
+{
+  if (m_recordFd == -1) {
+      // Opening a named pipe blocks until its reader is running.
+      m_recordFd = open (m_recordFile.c_str (), O_WRONLY | O_APPEND | O_CREAT, 0644);
+      if (m_recordFd == -1) {
+          NS_LOG_ERROR ("Could not open record file \"" << m_recordFile << "\": " << std::strerror (errno));
+          return;
+        }
+    }
+  record += '\n';
+  if (record.size () > PIPE_BUF) {
+      NS_LOG_WARN ("Record of " << record.size () << " bytes may be interleaved with other writers");
+    }
+  std::string::size_type written = 0;
+  while (written < record.size ()) {
+      ssize_t n = write (m_recordFd, record.data () + written, record.size () - written);
+      if (n < 0) {
+          if (errno == EINTR) {
+              continue;
+            }
+          NS_LOG_ERROR ("Could not write record: " << std::strerror (errno));
+          return;
+        }
+      written += n;
+    }
+}
+
+void
+SqliteDataOutput::InsertExperiment (std::string run, std::string experiment,
+                                    std::string strategy, std::string input,
+                                    std::string description)
+{
+  if (!m_recordFile.empty ()) {
+      WriteRecord ("E\t" + EscapeField (run) + "\t" + EscapeField (experiment) + "\t" +
+                   EscapeField (strategy) + "\t" + EscapeField (input) + "\t" +
+                   EscapeField (description));
       return;
     }
+  BindText (m_insertExperiment, 1, run);
+  BindText (m_insertExperiment, 2, experiment);
+  BindText (m_insertExperiment, 3, strategy);
+  BindText (m_insertExperiment, 4, input);
+  BindText (m_insertExperiment, 5, description);
+  Step (m_insertExperiment);
+}
 
-  std::string run = dc.GetRunLabel ();
+void
+SqliteDataOutput::InsertMetadata (std::string run, std::string key, std::string value)
+{
+  if (!m_recordFile.empty ()) {
+      WriteRecord ("M\t" + EscapeField (run) + "\t" + EscapeField (key) + "\t" + EscapeField (value));
+      return;
+    }
+  BindText (m_insertMetadata, 1, run);
+  BindText (m_insertMetadata, 2, key);
+  BindText (m_insertMetadata, 3, value);
+  Step (m_insertMetadata);
+}
 
-  Exec ("create table if not exists Experiments (run, experiment, strategy, input, description text)");
-  Exec ("insert into Experiments (run,experiment,strategy,input,description) values ('" +
-        run + "', '" +
-        dc.GetExperimentLabel () + "', '" +
-        dc.GetStrategyLabel () + "', '" +
-        dc.GetInputLabel () + "', '" +
-        dc.GetDescription () + "')");
+void
+SqliteDataOutput::InsertSingleton (std::string run, std::string name,
+                                   std::string variable, int64_t val)
+{
+  if (!m_recordFile.empty ()) {
+      std::ostringstream sstr;
+      sstr << val;
+      WriteRecord ("S\t" + EscapeField (run) + "\t" + EscapeField (name) + "\t" +
+                   EscapeField (variable) + "\ti\t" + sstr.str ());
+      return;
+    }
+  BindText (m_insertSingleton, 1, run);
+  BindText (m_insertSingleton, 2, name);
+  BindText (m_insertSingleton, 3, variable);
+  sqlite3_bind_int64 (m_insertSingleton, 4, val);
+  Step (m_insertSingleton);
+}
 
-  Exec ("create table if not exists Metadata ( run text, key text, value)");
+void
+SqliteDataOutput::InsertSingleton (std::string run, std::string name,
+                                   std::string variable, double val)
+{
+  if (!m_recordFile.empty ()) {
+      std::ostringstream sstr;
+      sstr.precision (17);
+      sstr << val;
+      WriteRecord ("S\t" + EscapeField (run) + "\t" + EscapeField (name) + "\t" +
+                   EscapeField (variable) + "\td\t" + sstr.str ());
+      return;
+    }
+  BindText (m_insertSingleton, 1, run);
+  BindText (m_insertSingleton, 2, name);
+  BindText (m_insertSingleton, 3, variable);
+  sqlite3_bind_double (m_insertSingleton, 4, val);
+  Step (m_insertSingleton);
+}
+
+void
+SqliteDataOutput::InsertSingleton (std::string run, std::string name,
+                                   std::string variable, std::string val)
+{
+  if (!m_recordFile.empty ()) {
+      WriteRecord ("S\t" + EscapeField (run) + "\t" + EscapeField (name) + "\t" +
+                   EscapeField (variable) + "\ts\t" + EscapeField (val));
+      return;
+    }
+  BindText (m_insertSingleton, 1, run);
+  BindText (m_insertSingleton, 2, name);
+  BindText (m_insertSingleton, 3, variable);
+  BindText (m_insertSingleton, 4, val);
+  Step (m_insertSingleton);
+}
+
+//----------------------------------------------
+void
+SqliteDataOutput::Output (DataCollector &dc)
+{
+  bool toDb = m_recordFile.empty ();
+  if (toDb) {
+      if (!Open ()) {
+          return;
+        }
+      // Take the write lock up front, so that concurrent writers wait in
+      // the busy handler instead of failing in the middle of the run.
+      if (Exec ("BEGIN IMMEDIATE") != SQLITE_OK) {
+          NS_LOG_ERROR ("Could not lock sqlite3 database \"" << m_dbFile << "\", run "
+                        << dc.GetRunLabel () << " not written");
+          return;
+        }
+    }
+
+  std::string run = dc.GetRunLabel ();
+
+  InsertExperiment (run, dc.GetExperimentLabel (), dc.GetStrategyLabel (),
+                    dc.GetInputLabel (), dc.GetDescription ());
 
   for (MetadataList::iterator i = dc.MetadataBegin ();
        i != dc.MetadataEnd (); i++) {
       std::pair<std::string, std::string> blob = (*i);
-      Exec ("insert into Metadata (run,key,value) values ('" +
-            run + "', '" +
-            blob.first + "', '" +
-            blob.second + "')");
+      InsertMetadata (run, blob.first, blob.second);
     }
 
-  Exec ("BEGIN");
   SqliteOutputCallback callback (this, run);
   for (DataCalculatorList::iterator i = dc.DataCalculatorBegin ();
        i != dc.DataCalculatorEnd (); i++) {
       (*i)->Output (callback);
     }
-  Exec ("COMMIT");
 
-  sqlite3_close (m_db);
+  if (toDb && Exec ("COMMIT") != SQLITE_OK) {
+      NS_LOG_ERROR ("Could not commit run " << run << " to sqlite3 database \"" << m_dbFile << "\"");
+      Exec ("ROLLBACK");
+    }
 
   // end SqliteDataOutput::Output
 }
 
+uint32_t
+SqliteDataOutput::Import (std::istream &is, uint32_t batchSize)
+{
+  NS_LOG_FUNCTION (this << batchSize);
+  NS_ASSERT (m_recordFile.empty ());
+  if (!Open ()) {
+      return 0;
+    }
+
+  uint32_t imported = 0;
+  uint32_t pending = 0;
+  std::string line;
+  if (Exec ("BEGIN IMMEDIATE") != SQLITE_OK) {
+      NS_LOG_ERROR ("Could not lock sqlite3 database \"" << m_dbFile << "\", no record imported");
+      return 0;
+    }
+  while (std::getline (is, line)) {
+      std::vector<std::string> f = SplitRecord (line);
+      if (f[0] == "E" && f.size () == 6) {
+          InsertExperiment (f[1], f[2], f[3], f[4], f[5]);
+        } else if (f[0] == "M" && f.size () == 4) {
+          InsertMetadata (f[1], f[2], f[3]);
+        } else if (f[0] == "S" && f.size () == 6 && f[4] == "i") {
+          InsertSingleton (f[1], f[2], f[3], static_cast<int64_t> (strtoll (f[5].c_str (), 0, 10)));
+        } else if (f[0] == "S" && f.size () == 6 && f[4] == "d") {
+          InsertSingleton (f[1], f[2], f[3], strtod (f[5].c_str (), 0));
+        } else if (f[0] == "S" && f.size () == 6 && f[4] == "s") {
+          InsertSingleton (f[1], f[2], f[3], f[5]);
+        } else {
+          NS_LOG_WARN ("Ignoring malformed record \"" << line << "\"");
+          continue;
+        }
+      if (++pending < batchSize) {
+          continue;
+        }
+      if (Exec ("COMMIT") != SQLITE_OK) {
+          NS_LOG_ERROR ("Could not commit to sqlite3 database \"" << m_dbFile << "\", stopping after "
+                        << imported << " records");
+          Exec ("ROLLBACK");
+          return imported;
+        }
+      imported += pending;
+      pending = 0;
+      if (Exec ("BEGIN IMMEDIATE") != SQLITE_OK) {
+          NS_LOG_ERROR ("Could not lock sqlite3 database \"" << m_dbFile << "\", stopping after "
+                        << imported << " records");
+          return imported;
+        }
+    }
+  if (Exec ("COMMIT") != SQLITE_OK) {
+      NS_LOG_ERROR ("Could not commit to sqlite3 database \"" << m_dbFile << "\", stopping after "
+                    << imported << " records");
+      Exec ("ROLLBACK");
+      return imported;
+    }
+  return imported + pending;
+
+  // end SqliteDataOutput::Import
+}
+
 SqliteDataOutput::SqliteOutputCallback::SqliteOutputCallback
   (Ptr<SqliteDataOutput> owner, std::string run) :
   m_owner (owner),
   m_runLabel (run)
 {
-
-  m_owner->Exec ("create table if not exists Singletons ( run text, name text, variable text, value )");
-
   // end SqliteDataOutput::SqliteOutputCallback::SqliteOutputCallback
 }
 
@@ -179,15 +490,7 @@ SqliteDataOutput::SqliteOutputCallback::OutputSingleton (std::string key,
                                                          std::string variable,
                                                          int val)
 {
-
-  std::stringstream sstr;
-  sstr << "insert into Singletons (run,name,variable,value) values ('" <<
-  m_runLabel << "', '" <<
-  key << "', '" <<
-  variable << "', " <<
-  val << ")";
-  m_owner->Exec (sstr.str ());
-
+  m_owner->InsertSingleton (m_runLabel, key, variable, static_cast<int64_t> (val));
   // end SqliteDataOutput::SqliteOutputCallback::OutputSingleton
 }
 void
@@ -195,13 +498,7 @@ SqliteDataOutput::SqliteOutputCallback::OutputSingleton (std::string key,
                                                          std::string variable,
                                                          uint32_t val)
 {
-  std::stringstream sstr;
-  sstr << "insert into Singletons (run,name,variable,value) values ('" <<
-  m_runLabel << "', '" <<
-  key << "', '" <<
-  variable << "', " <<
-  val << ")";
-  m_owner->Exec (sstr.str ());
+  m_owner->InsertSingleton (m_runLabel, key, variable, static_cast<int64_t> (val));
   // end SqliteDataOutput::SqliteOutputCallback::OutputSingleton
 }
 void
@@ -209,13 +506,7 @@ SqliteDataOutput::SqliteOutputCallback::OutputSingleton (std::string key,
                                                          std::string variable,
                                                          double val)
 {
-  std::stringstream sstr;
-  sstr << "insert into Singletons (run,name,variable,value) values ('" <<
-  m_runLabel << "', '" <<
-  key << "', '" <<
-  variable << "', " <<
-  val << ")";
-  m_owner->Exec (sstr.str ());
+  m_owner->InsertSingleton (m_runLabel, key, variable, val);
   // end SqliteDataOutput::SqliteOutputCallback::OutputSingleton
 }
 void
@@ -223,13 +514,7 @@ SqliteDataOutput::SqliteOutputCallback::OutputSingleton (std::string key,
                                                          std::string variable,
                                                          std::string val)
 {
-  std::stringstream sstr;
-  sstr << "insert into Singletons (run,name,variable,value) values ('" <<
-  m_runLabel << "', '" <<
-  key << "', '" <<
-  variable << "', '" <<
-  val << "')";
-  m_owner->Exec (sstr.str ());
+  m_owner->InsertSingleton (m_runLabel, key, variable, val);
   // end SqliteDataOutput::SqliteOutputCallback::OutputSingleton
 }
 void
@@ -237,12 +522,6 @@ SqliteDataOutput::SqliteOutputCallback::OutputSingleton (std::string key,
                                                          std::string variable,
                                                          Time val)
 {
-  std::stringstream sstr;
-  sstr << "insert into Singletons (run,name,variable,value) values ('" <<
-  m_runLabel << "', '" <<
-  key << "', '" <<
-  variable << "', " <<
-  val.GetTimeStep () << ")";
-  m_owner->Exec (sstr.str ());
+  m_owner->InsertSingleton (m_runLabel, key, variable, val.GetTimeStep ());
   // end SqliteDataOutput::SqliteOutputCallback::OutputSingleton
 }
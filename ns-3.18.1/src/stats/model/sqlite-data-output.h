@@ -21,6 +21,9 @@
 #ifndef SQLITE_DATA_OUTPUT_H
 #define SQLITE_DATA_OUTPUT_H
 
+#include <istream>
+#include <stdint.h>
+
 #include "ns3/nstime.h"
 
 #include "data-output-interface.h"
@@ -28,6 +31,7 @@
 #define STATS_HAS_SQLITE3
 
 struct sqlite3;
+struct sqlite3_stmt;
 
 namespace ns3 {
 
@@ -36,6 +40,18 @@ namespace ns3 {
 /**
  * \ingroup stats
  *
+ * Write the results of a DataCollector in the sqlite3 database
+ * named after the file prefix.
+ *
+ * The database is opened on the first Output () and kept open until
+ * the object is disposed.  It is switched to write-ahead logging, the
+ * inserts go through prepared statements, and each Output () is a
+ * single transaction, so that several simulations may write to the
+ * same database at once.
+ *
+ * For large sweeps, the simulations may instead write their results
+ * as records to a file or to a named pipe (see SetRecordFile ()),
+ * which a single process loads in the database with Import ().
  */
 class SqliteDataOutput : public DataOutputInterface {
 public:
@@ -44,6 +60,26 @@ public:
 
   virtual void Output (DataCollector &dc);
 
+  /**
+   * \param path the file or named pipe to write the records to, or
+   * an empty string to write to the database.
+   *
+   * Each record is written with a single write (), so that the records
+   * of simulations sharing a named pipe are not interleaved, as long as
+   * they are shorter than PIPE_BUF.
+   */
+  void SetRecordFile (std::string path);
+
+  /**
+   * \param is the stream to read records written by other instances
+   * with SetRecordFile () from.
+   * \param batchSize number of records inserted per transaction.
+   * \return the number of records inserted in the database.  The import
+   * stops at the first transaction that cannot be started or committed,
+   * so that only the records of the committed transactions are counted.
+   */
+  uint32_t Import (std::istream &is, uint32_t batchSize = 10000);
+
 protected:
   virtual void DoDispose ();
 
@@ -84,8 +120,30 @@ private:
   };
 
 
-  sqlite3 *m_db;
+  bool Open (void);
+  void Close (void);
   int Exec (std::string exe);
+  int Step (sqlite3_stmt *stmt);
+  void WriteRecord (std::string record);
+
+  void InsertExperiment (std::string run, std::string experiment,
+                         std::string strategy, std::string input,
+                         std::string description);
+  void InsertMetadata (std::string run, std::string key, std::string value);
+  void InsertSingleton (std::string run, std::string name,
+                        std::string variable, int64_t val);
+  void InsertSingleton (std::string run, std::string name,
+                        std::string variable, double val);
+  void InsertSingleton (std::string run, std::string name,
+                        std::string variable, std::string val);
+
+  sqlite3 *m_db;
+  std::string m_dbFile;
+  sqlite3_stmt *m_insertExperiment;
+  sqlite3_stmt *m_insertMetadata;
+  sqlite3_stmt *m_insertSingleton;
+  std::string m_recordFile;
+  int m_recordFd;
 
   // end class SqliteDataOutput
 };
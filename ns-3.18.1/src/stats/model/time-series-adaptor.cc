@@ -26,6 +26,8 @@
 #include "ns3/traced-value.h"
 #include "ns3/log.h"
 #include "ns3/simulator.h"
+#include "ns3/uinteger.h"
+#include "ns3/trace-source-accessor.h"
 
 NS_LOG_COMPONENT_DEFINE ("TimeSeriesAdaptor");
 
@@ -42,11 +44,24 @@ TimeSeriesAdaptor::GetTypeId (void)
     .AddTraceSource ( "Output",
                       "The current simulation time versus the current value converted to a double",
                       MakeTraceSourceAccessor (&TimeSeriesAdaptor::m_output))
+    .AddTraceSource ( "OutputBatch",
+                      "The simulation times and the values of BatchSize samples, "
+                      "as two columns of doubles",
+                      MakeTraceSourceAccessor (&TimeSeriesAdaptor::m_outputBatch))
+    .AddAttribute ( "BatchSize",
+                    "If not zero, the samples are buffered and sent to the OutputBatch "
+                    "trace source by batches of this many samples instead of one by one "
+                    "to the Output trace source.",
+                    UintegerValue (0),
+                    MakeUintegerAccessor (&TimeSeriesAdaptor::m_batchSize),
+                    MakeUintegerChecker<uint32_t> ())
   ;
   return tid;
 }
 
 TimeSeriesAdaptor::TimeSeriesAdaptor ()
+  : m_batchSize (0),
+    m_flushScheduled (false)
 {
   NS_LOG_FUNCTION (this);
 }
@@ -68,8 +83,54 @@ TimeSeriesAdaptor::TraceSinkDouble (double oldData, double newData)
       return;
     }
 
-  // Time stamp the value with the current time in seconds.
-  m_output (Simulator::Now ().GetSeconds (), newData);
+  AddSample (newData);
+}
+
+void
+TimeSeriesAdaptor::AddSample (double value)
+{
+  if (m_batchSize == 0)
+    {
+      // Time stamp the value with the current time in seconds.
+      m_output (Simulator::Now ().GetSeconds (), value);
+      return;
+    }
+
+  if (!m_flushScheduled)
+    {
+      // the buffers are allocated once and reused for every batch
+      m_times.reserve (m_batchSize);
+      m_values.reserve (m_batchSize);
+      Simulator::ScheduleDestroy (&TimeSeriesAdaptor::Flush, Ptr<TimeSeriesAdaptor> (this));
+      m_flushScheduled = true;
+    }
+  m_times.push_back (Simulator::Now ().GetSeconds ());
+  m_values.push_back (value);
+  if (m_times.size () >= m_batchSize)
+    {
+      Flush ();
+    }
+}
+
+void
+TimeSeriesAdaptor::Flush (void)
+{
+  NS_LOG_FUNCTION (this);
+  if (m_times.empty ())
+    {
+      return;
+    }
+  m_outputBatch (m_times, m_values);
+  m_times.clear ();
+  m_values.clear ();
+}
+
+void
+TimeSeriesAdaptor::DoDispose (void)
+{
+  NS_LOG_FUNCTION (this);
+  Flush ();
+  DataCollectionObject::DoDispose ();
 }
 
 void
@@ -25,6 +25,8 @@
 #include "ns3/object.h"
 #include "ns3/type-id.h"
 #include "ns3/traced-value.h"
+#include "ns3/traced-callback.h"
+#include <vector>
 
 namespace ns3 {
 
@@ -106,8 +108,36 @@ public:
    */
   void TraceSinkUinteger32 (uint32_t oldData, uint32_t newData);
 
+  /**
+   * \brief Sends the buffered samples to the OutputBatch trace source.
+   *
+   * This is done automatically when the buffer is full, when the
+   * adaptor is disposed and when the simulator is destroyed, so that
+   * it only needs to be called to get the samples before that.
+   */
+  void Flush (void);
+
+protected:
+  virtual void DoDispose (void);
+
 private:
+  /**
+   * \brief Stores or forwards a sample, depending on the batch size.
+   * \param value the new value converted to a double.
+   */
+  void AddSample (double value);
+
   TracedCallback<double, double> m_output;
+
+  /// Samples buffered before being sent as one batch, 0 to disable
+  uint32_t m_batchSize;
+  /// Time stamps of the buffered samples, in seconds
+  std::vector<double> m_times;
+  /// Values of the buffered samples
+  std::vector<double> m_values;
+  /// Whether the flush at simulator destroy time has been scheduled
+  bool m_flushScheduled;
+  TracedCallback<const std::vector<double> &, const std::vector<double> &> m_outputBatch;
 };
 
 } // namespace ns3
@@ -0,0 +1,204 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <fstream>
+#include <string>
+#include <unistd.h>
+
+#include <sqlite3.h>
+
+#include "ns3/test.h"
+#include "ns3/nstime.h"
+#include "ns3/data-collector.h"
+#include "ns3/data-calculator.h"
+#include "ns3/data-output-interface.h"
+#include "ns3/sqlite-data-output.h"
+
+using namespace ns3;
+
+// the strings of the run, with the characters escaped in the records
+static const std::string g_escaped = "tab\there, newline\nhere, backslash\\here, \\t and \\n\\";
+
+// ===========================================================================
+// A data calculator writing one singleton of each type.
+// ===========================================================================
+
+class SqliteTestCalculator : public DataCalculator
+{
+public:
+  virtual void Output (DataOutputCallback &callback) const
+  {
+    callback.OutputSingleton (m_key, "int", -3);
+    callback.OutputSingleton (m_key, "uint32", static_cast<uint32_t> (4000000000U));
+    callback.OutputSingleton (m_key, "double", 0.1);
+    callback.OutputSingleton (m_key, "string", g_escaped);
+    callback.OutputSingleton (m_key, "time", NanoSeconds (5));
+    callback.OutputSingleton (m_key, g_escaped, 1);
+  }
+};
+
+// ===========================================================================
+// Test case for the records written with SetRecordFile () and loaded with
+// Import ().
+// ===========================================================================
+
+class SqliteRecordImportTestCase : public TestCase
+{
+public:
+  SqliteRecordImportTestCase ();
+  virtual ~SqliteRecordImportTestCase ();
+
+private:
+  virtual void DoRun (void);
+  static std::string Dump (std::string dbFile);
+  static void Remove (std::string dbFile);
+};
+
+SqliteRecordImportTestCase::SqliteRecordImportTestCase ()
+  : TestCase ("Database written directly and through records")
+{
+}
+
+SqliteRecordImportTestCase::~SqliteRecordImportTestCase ()
+{
+}
+
+std::string
+SqliteRecordImportTestCase::Dump (std::string dbFile)
+{
+  const char *queries[] = {
+    "select run, experiment, strategy, input, description from Experiments order by rowid",
+    "select run, key, value, typeof (value) from Metadata order by rowid",
+    "select run, name, variable, value, typeof (value) from Singletons order by rowid",
+  };
+  std::string dump;
+  sqlite3 *db;
+  sqlite3_open (dbFile.c_str (), &db);
+  for (uint32_t q = 0; q < sizeof (queries) / sizeof (queries[0]); q++)
+    {
+      sqlite3_stmt *stmt;
+      if (sqlite3_prepare_v2 (db, queries[q], -1, &stmt, 0) != SQLITE_OK)
+        {
+          dump += std::string ("error: ") + sqlite3_errmsg (db) + "\n";
+          continue;
+        }
+      while (sqlite3_step (stmt) == SQLITE_ROW)
+        {
+          for (int c = 0; c < sqlite3_column_count (stmt); c++)
+            {
+              // the text of a real has 15 digits, so compare its bits
+              if (sqlite3_column_type (stmt, c) == SQLITE_FLOAT)
+                {
+                  double value = sqlite3_column_double (stmt, c);
+                  dump += std::string (reinterpret_cast<const char *> (&value), sizeof (value));
+                }
+              else
+                {
+                  dump += std::string (reinterpret_cast<const char *> (sqlite3_column_text (stmt, c)),
+                                       sqlite3_column_bytes (stmt, c));
+                }
+              dump += "|";
+            }
+          dump += "\n";
+        }
+      sqlite3_finalize (stmt);
+    }
+  sqlite3_close (db);
+  return dump;
+}
+
+void
+SqliteRecordImportTestCase::Remove (std::string dbFile)
+{
+  unlink (dbFile.c_str ());
+  unlink ((dbFile + "-wal").c_str ());
+  unlink ((dbFile + "-shm").c_str ());
+}
+
+void
+SqliteRecordImportTestCase::DoRun (void)
+{
+  std::string recordFile = "sqlite-test-records.txt";
+  Remove ("sqlite-test-direct.db");
+  Remove ("sqlite-test-import.db");
+  unlink (recordFile.c_str ());
+
+  Ptr<DataCollector> dc = CreateObject<DataCollector> ();
+  dc->DescribeRun ("experiment\t" + g_escaped, "strategy", "input\n", "run\\" + g_escaped, g_escaped);
+  dc->AddMetadata (g_escaped, g_escaped);
+  dc->AddMetadata ("uint32", static_cast<uint32_t> (7));
+  Ptr<SqliteTestCalculator> calculator = CreateObject<SqliteTestCalculator> ();
+  calculator->SetKey ("key\t" + g_escaped);
+  dc->AddDataCalculator (calculator);
+
+  Ptr<SqliteDataOutput> direct = CreateObject<SqliteDataOutput> ();
+  direct->SetFilePrefix ("sqlite-test-direct");
+  direct->Output (*dc);
+  direct->Dispose ();
+
+  Ptr<SqliteDataOutput> records = CreateObject<SqliteDataOutput> ();
+  records->SetRecordFile (recordFile);
+  records->Output (*dc);
+  records->Dispose ();
+
+  // one record per line, whatever the fields hold
+  std::ifstream lines (recordFile.c_str ());
+  std::string line;
+  uint32_t nLines = 0;
+  while (std::getline (lines, line))
+    {
+      nLines++;
+    }
+  lines.close ();
+  NS_TEST_ASSERT_MSG_EQ (nLines, 9, "Wrong number of records");
+
+  // a batch size that does not divide the number of records
+  Ptr<SqliteDataOutput> import = CreateObject<SqliteDataOutput> ();
+  import->SetFilePrefix ("sqlite-test-import");
+  std::ifstream is (recordFile.c_str ());
+  NS_TEST_EXPECT_MSG_EQ (import->Import (is, 4), 9, "Wrong number of imported records");
+  is.close ();
+  import->Dispose ();
+
+  std::string expected = Dump ("sqlite-test-direct.db");
+  std::string imported = Dump ("sqlite-test-import.db");
+  NS_TEST_EXPECT_MSG_NE (expected.find (g_escaped), std::string::npos, "Strings not written to the database");
+  NS_TEST_EXPECT_MSG_EQ (expected.find ("error: "), std::string::npos, "Database not written");
+  NS_TEST_EXPECT_MSG_EQ (imported, expected, "Imported records differ from the direct output");
+
+  dc->Dispose ();
+  Remove ("sqlite-test-direct.db");
+  Remove ("sqlite-test-import.db");
+  unlink (recordFile.c_str ());
+}
+
+// ===========================================================================
+// Test suite
+// ===========================================================================
+
+class SqliteDataOutputTestSuite : public TestSuite
+{
+public:
+  SqliteDataOutputTestSuite ();
+};
+
+SqliteDataOutputTestSuite::SqliteDataOutputTestSuite ()
+  : TestSuite ("sqlite-data-output", UNIT)
+{
+  AddTestCase (new SqliteRecordImportTestCase, TestCase::QUICK);
+}
+
+static SqliteDataOutputTestSuite sqliteDataOutputTestSuite;
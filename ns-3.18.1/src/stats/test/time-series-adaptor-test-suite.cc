@@ -0,0 +1,125 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <vector>
+#include "ns3/time-series-adaptor.h"
+#include "ns3/test.h"
+#include "ns3/core-module.h"
+
+using namespace ns3;
+
+class TimeSeriesAdaptorBatchTestCase : public TestCase
+{
+public:
+  TimeSeriesAdaptorBatchTestCase ();
+  virtual ~TimeSeriesAdaptorBatchTestCase ();
+
+private:
+  virtual void DoRun (void);
+  void Output (double time, double value);
+  void OutputBatch (const std::vector<double> &times, const std::vector<double> &values);
+  void Sample (Ptr<TimeSeriesAdaptor> unbatched, Ptr<TimeSeriesAdaptor> batched, double value);
+
+  std::vector<double> m_times;
+  std::vector<double> m_values;
+  std::vector<double> m_batchedTimes;
+  std::vector<double> m_batchedValues;
+  uint32_t m_batches;
+};
+
+TimeSeriesAdaptorBatchTestCase::TimeSeriesAdaptorBatchTestCase ()
+  : TestCase ("time series adaptor batches"),
+    m_batches (0)
+{
+}
+
+TimeSeriesAdaptorBatchTestCase::~TimeSeriesAdaptorBatchTestCase ()
+{
+}
+
+void
+TimeSeriesAdaptorBatchTestCase::Output (double time, double value)
+{
+  m_times.push_back (time);
+  m_values.push_back (value);
+}
+
+void
+TimeSeriesAdaptorBatchTestCase::OutputBatch (const std::vector<double> &times, const std::vector<double> &values)
+{
+  NS_TEST_ASSERT_MSG_EQ (times.size (), values.size (), "Columns of different sizes");
+  NS_TEST_ASSERT_MSG_LT (times.size (), 5, "Batch larger than BatchSize");
+  m_batchedTimes.insert (m_batchedTimes.end (), times.begin (), times.end ());
+  m_batchedValues.insert (m_batchedValues.end (), values.begin (), values.end ());
+  m_batches++;
+}
+
+void
+TimeSeriesAdaptorBatchTestCase::Sample (Ptr<TimeSeriesAdaptor> unbatched, Ptr<TimeSeriesAdaptor> batched, double value)
+{
+  unbatched->TraceSinkDouble (0, value);
+  batched->TraceSinkDouble (0, value);
+}
+
+void
+TimeSeriesAdaptorBatchTestCase::DoRun (void)
+{
+  Ptr<TimeSeriesAdaptor> unbatched = CreateObject<TimeSeriesAdaptor> ();
+  unbatched->Enable ();
+  unbatched->TraceConnectWithoutContext ("Output", MakeCallback (&TimeSeriesAdaptorBatchTestCase::Output, this));
+
+  Ptr<TimeSeriesAdaptor> batched = CreateObject<TimeSeriesAdaptor> ();
+  batched->SetAttribute ("BatchSize", UintegerValue (4));
+  batched->Enable ();
+  batched->TraceConnectWithoutContext ("OutputBatch", MakeCallback (&TimeSeriesAdaptorBatchTestCase::OutputBatch, this));
+
+  for (uint32_t i = 0; i < 10; i++)
+    {
+      Simulator::Schedule (Seconds (i + 1), &TimeSeriesAdaptorBatchTestCase::Sample, this,
+                           unbatched, batched, i * 1.5);
+    }
+  Simulator::Run ();
+
+  // Two full batches, the last two samples are still buffered
+  NS_TEST_ASSERT_MSG_EQ (m_batches, 2, "Unexpected number of batches");
+  NS_TEST_ASSERT_MSG_EQ (m_batchedTimes.size (), 8, "Unexpected number of batched samples");
+
+  // The remaining samples are flushed when the simulator is destroyed
+  Simulator::Destroy ();
+  NS_TEST_ASSERT_MSG_EQ (m_batches, 3, "Buffered samples not flushed");
+  NS_TEST_ASSERT_MSG_EQ (m_times.size (), 10, "Unexpected number of samples");
+  NS_TEST_ASSERT_MSG_EQ (m_batchedTimes.size (), m_times.size (), "Samples lost by batching");
+  for (uint32_t i = 0; i < m_times.size (); i++)
+    {
+      NS_TEST_ASSERT_MSG_EQ (m_batchedTimes[i], m_times[i], "Batched time differs from Output");
+      NS_TEST_ASSERT_MSG_EQ (m_batchedValues[i], m_values[i], "Batched value differs from Output");
+    }
+}
+
+
+class TimeSeriesAdaptorTestSuite : public TestSuite
+{
+public:
+  TimeSeriesAdaptorTestSuite ();
+};
+
+TimeSeriesAdaptorTestSuite::TimeSeriesAdaptorTestSuite ()
+  : TestSuite ("time-series-adaptor", UNIT)
+{
+  AddTestCase (new TimeSeriesAdaptorBatchTestCase, TestCase::QUICK);
+}
+
+static TimeSeriesAdaptorTestSuite timeSeriesAdaptorTestSuite;
@@ -117,32 +117,19 @@ int main (int argc, char *argv[])
 
   int totlinks = inFile->LinksSize ();
 
-  NS_LOG_INFO ("creating node containers");
-  NodeContainer* nc = new NodeContainer[totlinks];
-  TopologyReader::ConstLinksIterator iter;
-  int i = 0;
-  for ( iter = inFile->LinksBegin (); iter != inFile->LinksEnd (); iter++, i++ )
-    {
-      nc[i] = NodeContainer (iter->GetFromNode (), iter->GetToNode ());
-    }
-
-  NS_LOG_INFO ("creating net device containers");
-  NetDeviceContainer* ndc = new NetDeviceContainer[totlinks];
+  // Install the devices and assign the addresses of each link in a single
+  // pass over the link list, it creates little subnets, one for each couple
+  // of nodes.
+  NS_LOG_INFO ("creating net devices and ipv4 interfaces for " << totlinks << " links");
   PointToPointHelper p2p;
-  for (int i = 0; i < totlinks; i++)
-    {
-      // p2p.SetChannelAttribute ("Delay", TimeValue(MilliSeconds(weight[i])));
-      p2p.SetChannelAttribute ("Delay", StringValue ("2ms"));
-      p2p.SetDeviceAttribute ("DataRate", StringValue ("5Mbps"));
-      ndc[i] = p2p.Install (nc[i]);
-    }
-
-  // it crates little subnets, one for each couple of nodes.
-  NS_LOG_INFO ("creating ipv4 interfaces");
-  Ipv4InterfaceContainer* ipic = new Ipv4InterfaceContainer[totlinks];
-  for (int i = 0; i < totlinks; i++)
+  // p2p.SetChannelAttribute ("Delay", TimeValue(MilliSeconds(weight[i])));
+  p2p.SetChannelAttribute ("Delay", StringValue ("2ms"));
+  p2p.SetDeviceAttribute ("DataRate", StringValue ("5Mbps"));
+  TopologyReader::ConstLinksIterator iter;
+  for ( iter = inFile->LinksBegin (); iter != inFile->LinksEnd (); iter++ )
     {
-      ipic[i] = address.Assign (ndc[i]);
+      NetDeviceContainer ndc = p2p.Install (iter->GetFromNode (), iter->GetToNode ());
+      address.Assign (ndc);
       address.NewNetwork ();
     }
 
@@ -199,10 +186,6 @@ int main (int argc, char *argv[])
   Simulator::Run ();
   Simulator::Destroy ();
 
-  delete[] ipic;
-  delete[] ndc;
-  delete[] nc;
-
   NS_LOG_INFO ("Done.");
 
   return 0;
@@ -195,6 +195,7 @@ RocketfuelTopologyReader::GenerateFromMapsFile (int argc, char *argv[])
           NS_LOG_INFO (linksNumber << ":" << nodesNumber << " From: " << uid << " to: " << nuid);
           Link link (nodeMap[uid], uid, nodeMap[nuid], nuid);
           AddLink (link);
+          m_linkIndex.insert (std::make_pair (PeekPointer (nodeMap[uid]), PeekPointer (nodeMap[nuid])));
           linksNumber++;
         }
     }
@@ -239,22 +240,15 @@ RocketfuelTopologyReader::GenerateFromWeightsFile (int argc, char *argv[])
           nodesNumber++;
         }
       NS_LOG_INFO (linksNumber << ":" << nodesNumber << " From: " << sname << " to: " << tname);
-      TopologyReader::ConstLinksIterator iter;
-      bool found = false;
-      for (iter = LinksBegin (); iter != LinksEnd (); iter++)
-        {
-          if ((iter->GetFromNode () == nodeMap[tname])
-              && (iter->GetToNode () == nodeMap[sname]))
-            {
-              found = true;
-              break;
-            }
-        }
+      // Skip the link if any link of this reader already goes the other way
+      bool found = (m_linkIndex.find (std::make_pair (PeekPointer (nodeMap[tname]), PeekPointer (nodeMap[sname])))
+                    != m_linkIndex.end ());
 
       if (!found)
         {
           Link link (nodeMap[sname], sname, nodeMap[tname], tname);
           AddLink (link);
+          m_linkIndex.insert (std::make_pair (PeekPointer (nodeMap[sname]), PeekPointer (nodeMap[tname])));
           linksNumber++;
         }
     }
@@ -315,6 +309,8 @@ RocketfuelTopologyReader::Read (void)
   int lineNumber = 0;
   enum RF_FileType ftype = RF_UNKNOWN;
   char errbuf[512];
+  regex_t regex;
+  bool compiled = false;
 
   if (!topgen.is_open ())
     {
@@ -344,46 +340,33 @@ RocketfuelTopologyReader::Read (void)
               NS_LOG_INFO ("Unknown File Format (" << GetFileName () << ")");
               break;
             }
-        }
-
-      regmatch_t regmatch[REGMATCH_MAX];
-      regex_t regex;
 
-      if (ftype == RF_MAPS)
-        {
-          ret = regcomp (&regex, ROCKETFUEL_MAPS_LINE, REG_EXTENDED | REG_NEWLINE);
+          // The expression only depends on the file type, compile it once
+          ret = regcomp (&regex, ftype == RF_MAPS ? ROCKETFUEL_MAPS_LINE : ROCKETFUEL_WEIGHTS_LINE,
+                         REG_EXTENDED | REG_NEWLINE);
           if (ret != 0)
             {
               regerror (ret, &regex, errbuf, sizeof (errbuf));
               regfree (&regex);
               break;
             }
-
-          ret = regexec (&regex, buf, REGMATCH_MAX, regmatch, 0);
-          if (ret == REG_NOMATCH)
-            {
-              NS_LOG_WARN ("match failed (maps file): %s" << buf);
-              regfree (&regex);
-              break;
-            }
+          compiled = true;
         }
-      else if (ftype == RF_WEIGHTS)
+
+      regmatch_t regmatch[REGMATCH_MAX];
+
+      ret = regexec (&regex, buf, REGMATCH_MAX, regmatch, 0);
+      if (ret == REG_NOMATCH)
         {
-          ret = regcomp (&regex, ROCKETFUEL_WEIGHTS_LINE, REG_EXTENDED | REG_NEWLINE);
-          if (ret != 0)
+          if (ftype == RF_MAPS)
             {
-              regerror (ret, &regex, errbuf, sizeof (errbuf));
-              regfree (&regex);
-              break;
+              NS_LOG_WARN ("match failed (maps file): %s" << buf);
             }
-
-          ret = regexec (&regex, buf, REGMATCH_MAX, regmatch, 0);
-          if (ret == REG_NOMATCH)
+          else
             {
               NS_LOG_WARN ("match failed (weights file): %s" << buf);
-              regfree (&regex);
-              break;
             }
+          break;
         }
 
       line = buf;
@@ -416,11 +399,13 @@ RocketfuelTopologyReader::Read (void)
         {
           NS_LOG_WARN ("Unsupported file format (only Maps/Weights are supported)");
         }
+    }
 
+  if (compiled)
+    {
       regfree (&regex);
     }
 
-
   topgen.close ();
 
   NS_LOG_INFO ("Rocketfuel topology created with " << nodesNumber << " nodes and " << linksNumber << " links");
@@ -21,6 +21,9 @@
 #ifndef ROCKETFUEL_TOPOLOGY_READER_H
 #define ROCKETFUEL_TOPOLOGY_READER_H
 
+#include <set>
+#include <utility>
+
 #include "ns3/nstime.h"
 #include "topology-reader.h"
 
@@ -78,6 +81,10 @@ private:
   };
   enum RF_FileType GetFileType (const char *);
 
+  // All the links of this reader, from every file read, indexed by
+  // their (from, to) nodes
+  std::set<std::pair<Node *, Node *> > m_linkIndex;
+
   // end class RocketfuelTopologyReader
 };
 
@@ -30,6 +30,8 @@
 #include "ns3/object-factory.h"
 #include "ns3/object-factory.h"
 #include "ns3/simulator.h"
+#include <fstream>
+#include <unistd.h>
 
 namespace ns3 {
 
@@ -79,10 +81,74 @@ public:
 private:
 };
 
+class RocketfuelTopologyReaderRereadTest : public TestCase
+{
+public:
+  RocketfuelTopologyReaderRereadTest ();
+private:
+  virtual void DoRun (void);
+};
+
+RocketfuelTopologyReaderRereadTest::RocketfuelTopologyReaderRereadTest ()
+  : TestCase ("RocketfuelTopologyReaderRereadTest")
+{
+}
+
+
+void
+RocketfuelTopologyReaderRereadTest::DoRun (void)
+{
+  std::string input1 = CreateTempDirFilename ("rocketfuel-test-weights-1.txt");
+  std::string input2 = CreateTempDirFilename ("rocketfuel-test-weights-2.txt");
+  std::string inputAll = CreateTempDirFilename ("rocketfuel-test-weights-all.txt");
+  std::string lines1 = "a b 1\nb c 2\n";
+  // the reverse of the links of the first file, and a new link
+  std::string lines2 = "c b 2\nb a 1\nc d 3\n";
+  std::ofstream out1 (input1.c_str ());
+  out1 << lines1;
+  out1.close ();
+  std::ofstream out2 (input2.c_str ());
+  out2 << lines2;
+  out2.close ();
+  std::ofstream outAll (inputAll.c_str ());
+  outAll << lines1 << lines2;
+  outAll.close ();
+
+  // the two files read one after the other by the same reader
+  Ptr<RocketfuelTopologyReader> reread = CreateObject<RocketfuelTopologyReader> ();
+  reread->SetFileName (input1);
+  reread->Read ();
+  reread->SetFileName (input2);
+  reread->Read ();
+
+  // the same lines read at once
+  Ptr<RocketfuelTopologyReader> single = CreateObject<RocketfuelTopologyReader> ();
+  single->SetFileName (inputAll);
+  single->Read ();
+
+  NS_TEST_ASSERT_MSG_EQ (reread->LinksSize (), single->LinksSize (), "Re-read and single read give different links");
+  TopologyReader::ConstLinksIterator i = reread->LinksBegin ();
+  TopologyReader::ConstLinksIterator j = single->LinksBegin ();
+  for (; i != reread->LinksEnd () && j != single->LinksEnd (); i++, j++)
+    {
+      NS_TEST_EXPECT_MSG_EQ (i->GetFromNodeName () + " " + i->GetToNodeName (),
+                             j->GetFromNodeName () + " " + j->GetToNodeName (),
+                             "Re-read and single read give different links");
+      NS_TEST_EXPECT_MSG_EQ (i->GetFromNode (), j->GetFromNode (), "Different from nodes");
+      NS_TEST_EXPECT_MSG_EQ (i->GetToNode (), j->GetToNode (), "Different to nodes");
+    }
+
+  unlink (input1.c_str ());
+  unlink (input2.c_str ());
+  unlink (inputAll.c_str ());
+  Simulator::Destroy ();
+}
+
 RocketfuelTopologyReaderTestSuite::RocketfuelTopologyReaderTestSuite ()
   : TestSuite ("rocketfuel-topology-reader", UNIT)
 {
   AddTestCase (new RocketfuelTopologyReaderTest (), TestCase::QUICK);
+  AddTestCase (new RocketfuelTopologyReaderRereadTest (), TestCase::QUICK);
 }
 
 static RocketfuelTopologyReaderTestSuite rocketfuelTopologyReaderTestSuite;
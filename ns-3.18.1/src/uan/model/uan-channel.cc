@@ -26,6 +26,8 @@
 #include "ns3/node.h"
 #include "ns3/log.h"
 #include "ns3/pointer.h"
+#include "ns3/boolean.h"
+#include "ns3/double.h"
 #include "ns3/log.h"
 
 #include "uan-channel.h"
@@ -58,6 +60,20 @@ UanChannel::GetTypeId ()
                    PointerValue (CreateObject<UanNoiseModelDefault> ()),
                    MakePointerAccessor (&UanChannel::m_noise),
                    MakePointerChecker<UanNoiseModel> ())
+    .AddAttribute ("CachePropagation",
+                   "Reuse the delay, PDP and path loss computed for a pair of devices "
+                   "as long as neither of them has moved.  Only enable this for propagation "
+                   "models which are deterministic.",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&UanChannel::m_cachePropagation),
+                   MakeBooleanChecker ())
+    .AddAttribute ("MaxRange",
+                   "Receivers further away from the sender than this distance (m) "
+                   "are not scheduled at all.  The distance to every device is still "
+                   "checked for each transmission.  0 means unlimited range.",
+                   DoubleValue (0.0),
+                   MakeDoubleAccessor (&UanChannel::m_maxRange),
+                   MakeDoubleChecker<double> (0.0))
   ;
 
   return tid;
@@ -66,7 +82,9 @@ UanChannel::GetTypeId ()
 UanChannel::UanChannel ()
   : Channel (),
     m_prop (0),
-    m_cleared (false)
+    m_cleared (false),
+    m_cachePropagation (false),
+    m_maxRange (0.0)
 {
 }
 
@@ -97,6 +115,7 @@ UanChannel::Clear ()
         }
     }
   m_devList.clear ();
+  m_propCache.clear ();
   if (m_prop)
     {
       m_prop->Clear ();
@@ -121,6 +140,7 @@ UanChannel::SetPropagationModel (Ptr<UanPropModel> prop)
 {
   NS_LOG_DEBUG ("Set Prop Model " << this);
   m_prop = prop;
+  m_propCache.clear ();
 }
 
 uint32_t
@@ -147,10 +167,11 @@ UanChannel::TxPacket (Ptr<UanTransducer> src, Ptr<Packet> packet,
                       double txPowerDb, UanTxMode txMode)
 {
   Ptr<MobilityModel> senderMobility = 0;
+  uint32_t srcIndex = 0;
 
   NS_LOG_DEBUG ("Channel scheduling");
   for (UanDeviceList::const_iterator i = m_devList.begin (); i
-       != m_devList.end (); i++)
+       != m_devList.end (); i++, srcIndex++)
     {
 
       if (src == i->second)
@@ -160,23 +181,64 @@ UanChannel::TxPacket (Ptr<UanTransducer> src, Ptr<Packet> packet,
         }
     }
   NS_ASSERT (senderMobility != 0);
+  Vector srcPos = senderMobility->GetPosition ();
   uint32_t j = 0;
   UanDeviceList::const_iterator i = m_devList.begin ();
   for (; i != m_devList.end (); i++)
     {
       if (src != i->second)
         {
-          NS_LOG_DEBUG ("Scheduling " << i->first->GetMac ()->GetAddress ());
           Ptr<MobilityModel> rcvrMobility = i->first->GetNode ()->GetObject<MobilityModel> ();
-          Time delay = m_prop->GetDelay (senderMobility, rcvrMobility, txMode);
-          UanPdp pdp = m_prop->GetPdp (senderMobility, rcvrMobility, txMode);
-          double rxPowerDb = txPowerDb - m_prop->GetPathLossDb (senderMobility,
-                                                                rcvrMobility,
-                                                                txMode);
+          Vector dstPos = rcvrMobility->GetPosition ();
+          if (m_maxRange > 0 && CalculateDistance (srcPos, dstPos) > m_maxRange)
+            {
+              NS_LOG_DEBUG ("Not scheduling " << i->first->GetMac ()->GetAddress () << ", out of range");
+              j++;
+              continue;
+            }
+          NS_LOG_DEBUG ("Scheduling " << i->first->GetMac ()->GetAddress ());
+          Time delay;
+          UanPdp pdp;
+          double pathLossDb;
+          PropCache::iterator cached = m_propCache.end ();
+          if (m_cachePropagation)
+            {
+              cached = m_propCache.find (std::make_pair (srcIndex, j));
+            }
+          if (cached != m_propCache.end ()
+              && cached->second.modeUid == txMode.GetUid ()
+              && cached->second.srcPos.x == srcPos.x
+              && cached->second.srcPos.y == srcPos.y
+              && cached->second.srcPos.z == srcPos.z
+              && cached->second.dstPos.x == dstPos.x
+              && cached->second.dstPos.y == dstPos.y
+              && cached->second.dstPos.z == dstPos.z)
+            {
+              delay = cached->second.delay;
+              pdp = cached->second.pdp;
+              pathLossDb = cached->second.pathLossDb;
+            }
+          else
+            {
+              delay = m_prop->GetDelay (senderMobility, rcvrMobility, txMode);
+              pdp = m_prop->GetPdp (senderMobility, rcvrMobility, txMode);
+              pathLossDb = m_prop->GetPathLossDb (senderMobility, rcvrMobility, txMode);
+              if (m_cachePropagation)
+                {
+                  PropCacheEntry &entry = m_propCache[std::make_pair (srcIndex, j)];
+                  entry.srcPos = srcPos;
+                  entry.dstPos = dstPos;
+                  entry.modeUid = txMode.GetUid ();
+                  entry.delay = delay;
+                  entry.pdp = pdp;
+                  entry.pathLossDb = pathLossDb;
+                }
+            }
+          double rxPowerDb = txPowerDb - pathLossDb;
 
           NS_LOG_DEBUG ("txPowerDb=" << txPowerDb << "dB, rxPowerDb="
                                      << rxPowerDb << "dB, distance="
-                                     << senderMobility->GetDistanceFrom (rcvrMobility)
+                                     << CalculateDistance (srcPos, dstPos)
                                      << "m, delay=" << delay);
 
           uint32_t dstNodeId = i->first->GetNode ()->GetId ();
@@ -26,8 +26,10 @@
 #include "ns3/packet.h"
 #include "ns3/uan-prop-model.h"
 #include "ns3/uan-noise-model.h"
+#include "ns3/vector.h"
 
 #include <list>
+#include <map>
 #include <vector>
 
 namespace ns3 {
@@ -100,10 +102,30 @@ public:
   void Clear (void);
 
 private:
+  /**
+   * \brief Propagation results between a pair of transducers
+   *
+   * An entry is valid as long as neither end has moved and the
+   * same transmission mode is used.
+   */
+  struct PropCacheEntry
+  {
+    Vector srcPos;
+    Vector dstPos;
+    uint32_t modeUid;
+    Time delay;
+    UanPdp pdp;
+    double pathLossDb;
+  };
+  typedef std::map<std::pair<uint32_t, uint32_t>, PropCacheEntry> PropCache;
+
   UanDeviceList m_devList;
   Ptr<UanPropModel> m_prop;
   Ptr<UanNoiseModel> m_noise;
   bool m_cleared;
+  bool m_cachePropagation;
+  double m_maxRange;
+  PropCache m_propCache;
 
   void SendUp (uint32_t i, Ptr<Packet> packet, double rxPowerDb, UanTxMode txMode, UanPdp pdp);
 protected:
@@ -24,13 +24,17 @@
 #include "ns3/uan-phy-gen.h"
 #include "ns3/uan-transducer-hd.h"
 #include "ns3/uan-prop-model-ideal.h"
+#include "ns3/uan-prop-model-thorp.h"
 #include "ns3/constant-position-mobility-model.h"
 #include "ns3/simulator.h"
 #include "ns3/test.h"
 #include "ns3/node.h"
 #include "ns3/object-factory.h"
 #include "ns3/pointer.h"
+#include "ns3/double.h"
 #include "ns3/callback.h"
+#include "ns3/boolean.h"
+#include <sstream>
 
 using namespace ns3;
 
@@ -43,7 +47,8 @@ public:
 private:
   Ptr<UanNetDevice> CreateNode (Vector pos, Ptr<UanChannel> chan);
   bool DoPhyTests ();
-  uint32_t DoOnePhyTest (Time t1, Time t2, uint32_t r1, uint32_t r2, Ptr<UanPropModel> prop, uint32_t mode1 = 0, uint32_t mode2 = 0);
+  uint32_t DoOnePhyTest (Time t1, Time t2, uint32_t r1, uint32_t r2, Ptr<UanPropModel> prop, uint32_t mode1 = 0, uint32_t mode2 = 0,
+                         double maxRange = 0.0);
   bool RxPacket (Ptr<NetDevice> dev, Ptr<const Packet> pkt, uint16_t mode, const Address &sender);
   void SendOnePacket (Ptr<UanNetDevice> dev, uint32_t mode);
   ObjectFactory m_phyFac;
@@ -104,11 +109,13 @@ UanTest::DoOnePhyTest (Time txTime1,
                        uint32_t r2,
                        Ptr<UanPropModel> prop,
                        uint32_t mode1,
-                       uint32_t mode2)
+                       uint32_t mode2,
+                       double maxRange)
 {
 
   Ptr<UanChannel> channel = CreateObject<UanChannel> ();
   channel->SetAttribute ("PropagationModel", PointerValue (prop));
+  channel->SetAttribute ("MaxRange", DoubleValue (maxRange));
 
   Ptr<UanNetDevice> dev0 = CreateNode (Vector (r1,50,50), channel);
   Ptr<UanNetDevice> dev1 = CreateNode (Vector (0,50,50), channel);
@@ -152,6 +159,12 @@ UanTest::DoPhyTests ()
   NS_TEST_ASSERT_MSG_EQ_RETURNS_BOOL (DoOnePhyTest (Seconds (1.0), Seconds (2.99), 50, 50, prop),
                                       0, "Expected collision resulting in loss of both packets");
 
+  // Collision, unless the interferer is beyond the channel maximum range
+  NS_TEST_ASSERT_MSG_EQ_RETURNS_BOOL (DoOnePhyTest (Seconds (1.0), Seconds (1.0), 50, 100, prop),
+                                      0, "Expected collision resulting in loss of both packets");
+  NS_TEST_ASSERT_MSG_EQ_RETURNS_BOOL (DoOnePhyTest (Seconds (1.0), Seconds (1.0), 50, 100, prop, 0, 0, 75.0),
+                                      17, "Interferer out of range should not have been scheduled");
+
 
   // Phy Gen / FH-FSK SINR check
 
@@ -241,6 +254,140 @@ UanTest::DoRun (void)
 }
 
 
+/**
+ * Default SINR model which also records the received power of each
+ * packet it is called for.
+ */
+class UanRecordingSinrModel : public UanPhyCalcSinrDefault
+{
+public:
+  virtual double CalcSinrDb (Ptr<Packet> pkt,
+                             Time arrTime,
+                             double rxPowerDb,
+                             double ambNoiseDb,
+                             UanTxMode mode,
+                             UanPdp pdp,
+                             const UanTransducer::ArrivalList &arrivalList
+                             ) const
+  {
+    std::ostringstream oss;
+    oss << arrTime.GetNanoSeconds () << " " << rxPowerDb;
+    m_records.push_back (oss.str ());
+    return UanPhyCalcSinrDefault::CalcSinrDb (pkt, arrTime, rxPowerDb, ambNoiseDb, mode, pdp, arrivalList);
+  }
+  mutable std::vector<std::string> m_records;
+};
+
+/**
+ * Checks that caching the propagation results in the channel does not
+ * change which packets are received nor their received power, also
+ * when a node moves between two transmissions.
+ */
+class UanCachePropagationTest : public TestCase
+{
+public:
+  UanCachePropagationTest ();
+
+  virtual void DoRun (void);
+private:
+  std::vector<std::string> Run (bool cachePropagation);
+  static void RxOk (std::vector<std::string> *records, uint32_t nodeId,
+                    Ptr<const Packet> pkt, double sinr, UanTxMode mode);
+  static void SendOnePacket (Ptr<UanNetDevice> dev);
+};
+
+UanCachePropagationTest::UanCachePropagationTest ()
+  : TestCase ("UAN channel propagation cache")
+{
+}
+
+void
+UanCachePropagationTest::RxOk (std::vector<std::string> *records, uint32_t nodeId,
+                               Ptr<const Packet> pkt, double sinr, UanTxMode mode)
+{
+  std::ostringstream oss;
+  oss << Simulator::Now ().GetNanoSeconds () << " " << nodeId << " " << sinr;
+  records->push_back (oss.str ());
+}
+
+void
+UanCachePropagationTest::SendOnePacket (Ptr<UanNetDevice> dev)
+{
+  dev->Send (Create<Packet> (17), dev->GetBroadcast (), 0);
+}
+
+std::vector<std::string>
+UanCachePropagationTest::Run (bool cachePropagation)
+{
+  UanModesList mList;
+  mList.AppendMode (UanTxModeFactory::CreateMode (UanTxMode::FSK, 80, 80, 10000, 4000, 2, "TestMode"));
+  Ptr<UanRecordingSinrModel> sinr = CreateObject<UanRecordingSinrModel> ();
+  ObjectFactory phyFac;
+  phyFac.SetTypeId ("ns3::UanPhyGen");
+  phyFac.Set ("SinrModel", PointerValue (sinr));
+  phyFac.Set ("SupportedModes", UanModesListValue (mList));
+
+  Ptr<UanChannel> channel = CreateObject<UanChannel> ();
+  channel->SetAttribute ("PropagationModel", PointerValue (CreateObject<UanPropModelThorp> ()));
+  channel->SetAttribute ("CachePropagation", BooleanValue (cachePropagation));
+
+  std::vector<std::string> records;
+  std::vector<Ptr<UanNetDevice> > devs;
+  for (uint32_t i = 0; i < 4; i++)
+    {
+      Ptr<Node> node = CreateObject<Node> ();
+      Ptr<ConstantPositionMobilityModel> mobility = CreateObject<ConstantPositionMobilityModel> ();
+      mobility->SetPosition (Vector (100.0 * i * i, 50, 50));
+      node->AggregateObject (mobility);
+      Ptr<UanNetDevice> dev = CreateObject<UanNetDevice> ();
+      Ptr<UanMacAloha> mac = CreateObject<UanMacAloha> ();
+      mac->SetAddress (UanAddress::Allocate ());
+      Ptr<UanPhy> phy = phyFac.Create<UanPhy> ();
+      phy->TraceConnectWithoutContext ("RxOk", MakeBoundCallback (&UanCachePropagationTest::RxOk,
+                                                                  &records, node->GetId ()));
+      dev->SetPhy (phy);
+      dev->SetMac (mac);
+      dev->SetChannel (channel);
+      dev->SetTransducer (CreateObject<UanTransducerHd> ());
+      node->AddDevice (dev);
+      devs.push_back (dev);
+    }
+
+  // every node sends twice, the last node moving between the two rounds
+  for (uint32_t round = 0; round < 2; round++)
+    {
+      for (uint32_t i = 0; i < devs.size (); i++)
+        {
+          Simulator::Schedule (Seconds (1.0 + 4.0 * (round * devs.size () + i)),
+                               &UanCachePropagationTest::SendOnePacket, devs[i]);
+        }
+    }
+  Ptr<MobilityModel> moving = devs.back ()->GetNode ()->GetObject<MobilityModel> ();
+  Simulator::Schedule (Seconds (15.0), &MobilityModel::SetPosition, moving, Vector (500, 80, 50));
+
+  Simulator::Stop (Seconds (40.0));
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  records.insert (records.end (), sinr->m_records.begin (), sinr->m_records.end ());
+  return records;
+}
+
+void
+UanCachePropagationTest::DoRun (void)
+{
+  std::vector<std::string> uncached = Run (false);
+  std::vector<std::string> cached = Run (true);
+
+  // 8 packets, each received by 3 nodes, and the SINR of each reception
+  NS_TEST_ASSERT_MSG_EQ (uncached.size (), 48, "Unexpected number of receptions");
+  NS_TEST_ASSERT_MSG_EQ (cached.size (), uncached.size (), "The cache changed the number of receptions");
+  for (uint32_t i = 0; i < cached.size (); i++)
+    {
+      NS_TEST_EXPECT_MSG_EQ (cached[i], uncached[i], "The cache changed reception " << i);
+    }
+}
+
 class UanTestSuite : public TestSuite
 {
 public:
@@ -251,6 +398,7 @@ UanTestSuite::UanTestSuite ()
   :  TestSuite ("devices-uan", UNIT)
 {
   AddTestCase (new UanTest, TestCase::QUICK);
+  AddTestCase (new UanCachePropagationTest, TestCase::QUICK);
 }
 
 static UanTestSuite g_uanTestSuite;
@@ -107,12 +107,15 @@ ConnectionManager::AddConnection (Ptr<WimaxConnection> connection, Cid::Type typ
     {
     case Cid::BASIC:
       m_basicConnections.push_back (connection);
+      m_connectionsByCid.insert (std::make_pair (connection->GetCid ().GetIdentifier (), connection));
       break;
     case Cid::PRIMARY:
       m_primaryConnections.push_back (connection);
+      m_connectionsByCid.insert (std::make_pair (connection->GetCid ().GetIdentifier (), connection));
       break;
     case Cid::TRANSPORT:
       m_transportConnections.push_back (connection);
+      m_connectionsByCid.insert (std::make_pair (connection->GetCid ().GetIdentifier (), connection));
       break;
     case Cid::MULTICAST:
       m_multicastConnections.push_back (connection);
@@ -126,32 +129,11 @@ ConnectionManager::AddConnection (Ptr<WimaxConnection> connection, Cid::Type typ
 Ptr<WimaxConnection>
 ConnectionManager::GetConnection (Cid cid)
 {
-  std::vector<Ptr<WimaxConnection> >::const_iterator iter;
-
-  for (iter = m_basicConnections.begin (); iter != m_basicConnections.end (); ++iter)
-    {
-      if ((*iter)->GetCid () == cid)
-        {
-          return *iter;
-        }
-    }
-
-  for (iter = m_primaryConnections.begin (); iter != m_primaryConnections.end (); ++iter)
+  sgi::hash_map<uint16_t, Ptr<WimaxConnection> >::const_iterator iter = m_connectionsByCid.find (cid.GetIdentifier ());
+  if (iter != m_connectionsByCid.end ())
     {
-      if ((*iter)->GetCid () == cid)
-        {
-          return *iter;
-        }
+      return iter->second;
     }
-
-  for (iter = m_transportConnections.begin (); iter != m_transportConnections.end (); ++iter)
-    {
-      if ((*iter)->GetCid () == cid)
-        {
-          return *iter;
-        }
-    }
-
   return 0;
 }
 
@@ -27,6 +27,7 @@
 #include "cid.h"
 #include "wimax-connection.h"
 #include "ns3/mac48-address.h"
+#include "ns3/sgi-hashmap.h"
 
 namespace ns3 {
 
@@ -84,6 +85,8 @@ private:
   std::vector<Ptr<WimaxConnection> > m_primaryConnections;
   std::vector<Ptr<WimaxConnection> > m_transportConnections;
   std::vector<Ptr<WimaxConnection> > m_multicastConnections;
+  // basic, primary and transport connections indexed by their cid
+  sgi::hash_map<uint16_t, Ptr<WimaxConnection> > m_connectionsByCid;
   // only for BS
   CidFactory *m_cidFactory;
 };
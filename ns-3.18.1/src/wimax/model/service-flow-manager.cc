@@ -20,6 +20,7 @@
  */
 
 #include <stdint.h>
+#include <algorithm>
 #include "ns3/node.h"
 #include "ns3/simulator.h"
 #include "ns3/packet.h"
@@ -41,6 +42,8 @@
 #include "service-flow-record.h"
 NS_LOG_COMPONENT_DEFINE ("ServiceFlowManager");
 
+#define MAX_CLASSIFIER_CACHE_SIZE 4096
+
 namespace ns3 {
 
 NS_OBJECT_ENSURE_REGISTERED (ServiceFlowManager);
@@ -70,12 +73,48 @@ ServiceFlowManager::DoDispose (void)
     }
   m_serviceFlows->clear ();
   delete m_serviceFlows;
+  m_classifierCache.clear ();
 }
 
 void
 ServiceFlowManager::AddServiceFlow (ServiceFlow *serviceFlow)
 {
   m_serviceFlows->push_back (serviceFlow);
+  m_classifierCache.clear ();
+}
+
+void
+ServiceFlowManager::RemoveServiceFlow (ServiceFlow *serviceFlow)
+{
+  std::vector<ServiceFlow*>::iterator iter = std::find (m_serviceFlows->begin (), m_serviceFlows->end (), serviceFlow);
+  if (iter != m_serviceFlows->end ())
+    {
+      m_serviceFlows->erase (iter);
+      m_classifierCache.clear ();
+    }
+}
+
+uint32_t
+ServiceFlowManager::GetClassifierCacheSize (void) const
+{
+  return m_classifierCache.size ();
+}
+
+bool
+ServiceFlowManager::ClassifierKey::operator == (const ClassifierKey &o) const
+{
+  return srcAddress == o.srcAddress && dstAddress == o.dstAddress && srcPort == o.srcPort
+         && dstPort == o.dstPort && proto == o.proto && dir == o.dir;
+}
+
+size_t
+ServiceFlowManager::ClassifierKeyHash::operator () (const ClassifierKey &key) const
+{
+  size_t h = key.srcAddress.Get () * 2654435761U;
+  h ^= key.dstAddress.Get () + 0x9e3779b9 + (h << 6) + (h >> 2);
+  h ^= ((key.srcPort << 16) | key.dstPort) + 0x9e3779b9 + (h << 6) + (h >> 2);
+  h ^= ((key.proto << 1) | key.dir) + 0x9e3779b9 + (h << 6) + (h >> 2);
+  return h;
 }
 
 ServiceFlow* ServiceFlowManager::DoClassify (Ipv4Address srcAddress,
@@ -85,17 +124,37 @@ ServiceFlow* ServiceFlowManager::DoClassify (Ipv4Address srcAddress,
                                              uint8_t proto,
                                              ServiceFlow::Direction dir) const
 {
+  ClassifierKey key;
+  key.srcAddress = srcAddress;
+  key.dstAddress = dstAddress;
+  key.srcPort = srcPort;
+  key.dstPort = dstPort;
+  key.proto = proto;
+  key.dir = dir;
+  ClassifierCache::const_iterator it = m_classifierCache.find (key);
+  if (it != m_classifierCache.end ())
+    {
+      return it->second;
+    }
+
+  ServiceFlow *serviceFlow = 0;
   for (std::vector<ServiceFlow*>::iterator iter = m_serviceFlows->begin (); iter != m_serviceFlows->end (); ++iter)
     {
       if ((*iter)->GetDirection () == dir)
         {
           if ((*iter)->CheckClassifierMatch (srcAddress, dstAddress, srcPort, dstPort, proto))
             {
-              return (*iter);
+              serviceFlow = *iter;
+              break;
             }
         }
     }
-  return 0;
+  if (m_classifierCache.size () >= MAX_CLASSIFIER_CACHE_SIZE)
+    {
+      m_classifierCache.clear ();
+    }
+  m_classifierCache[key] = serviceFlow;
+  return serviceFlow;
 }
 
 ServiceFlow*
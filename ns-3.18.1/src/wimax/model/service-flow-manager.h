@@ -26,6 +26,7 @@
 #include "ns3/event-id.h"
 #include "mac-messages.h"
 #include "ns3/buffer.h"
+#include "ns3/sgi-hashmap.h"
 
 namespace ns3 {
 
@@ -54,6 +55,12 @@ public:
   void DoDispose (void);
 
   void AddServiceFlow (ServiceFlow * serviceFlow);
+  /**
+   * \brief remove a service flow from the manager, which then no longer
+   * deletes it when disposed
+   * \param serviceFlow the service flow to remove
+   */
+  void RemoveServiceFlow (ServiceFlow * serviceFlow);
   ServiceFlow* GetServiceFlow (uint32_t sfid) const;
   ServiceFlow* GetServiceFlow (Cid cid) const;
   std::vector<ServiceFlow*> GetServiceFlows (enum ServiceFlow::SchedulingType schedulingType) const;
@@ -97,8 +104,35 @@ public:
                            uint16_t DstPort,
                            uint8_t Proto,
                            ServiceFlow::Direction dir) const;
+  /**
+   * \return the number of ip flows whose service flow is cached by DoClassify
+   */
+  uint32_t GetClassifierCacheSize (void) const;
 private:
+  /// The fields DoClassify looks at
+  struct ClassifierKey
+  {
+    Ipv4Address srcAddress;
+    Ipv4Address dstAddress;
+    uint16_t srcPort;
+    uint16_t dstPort;
+    uint8_t proto;
+    ServiceFlow::Direction dir;
+    bool operator == (const ClassifierKey &o) const;
+  };
+  struct ClassifierKeyHash : public std::unary_function<ClassifierKey, size_t>
+  {
+    size_t operator () (const ClassifierKey &key) const;
+  };
+  typedef sgi::hash_map<ClassifierKey, ServiceFlow*, ClassifierKeyHash> ClassifierCache;
+
   std::vector<ServiceFlow*> * m_serviceFlows;
+  /**
+   * The service flow each ip flow was classified to, so that the classifier
+   * records are only matched once per ip flow. Flushed when a service flow
+   * is added or removed, and when it is full.
+   */
+  mutable ClassifierCache m_classifierCache;
 };
 
 } // namespace ns3
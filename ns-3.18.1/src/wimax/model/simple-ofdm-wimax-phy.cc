@@ -141,8 +141,6 @@ SimpleOfdmWimaxPhy::InitSimpleOfdmWimaxPhy (void)
   m_nfft = 256;
   m_g = (double) 1 / 4;
   SetNrCarriers (192);
-  m_fecBlocks = new std::list<bvec>;
-  m_receivedFecBlocks = new std::list<bvec>;
   m_currentBurstSize = 0;
   m_noiseFigure = 5; // dB
   m_txPower = 30; // dBm
@@ -223,10 +221,6 @@ SimpleOfdmWimaxPhy::SetNoiseFigure (double noiseFigure)
 void
 SimpleOfdmWimaxPhy::DoDispose (void)
 {
-  delete m_receivedFecBlocks;
-  delete m_fecBlocks;
-  m_receivedFecBlocks = 0;
-  m_fecBlocks = 0;
   delete m_snrToBlockErrorRateManager;
   WimaxPhy::DoDispose ();
 }
@@ -350,10 +344,12 @@ SimpleOfdmWimaxPhy::StartReceive (uint32_t burstSize,
   double Nwb = -114 + m_noiseFigure + 10 * std::log (GetBandwidth () / 1000000000.0) / 2.303;
   double SNR = rxPower - Nwb;
 
-  SNRToBlockErrorRateRecord * record = m_snrToBlockErrorRateManager->GetSNRToBlockErrorRateRecord (SNR, modulationType);
-  double I1 = record->GetI1 ();
-  double I2 = record->GetI2 ();
+  double I1;
+  double I2;
+  m_snrToBlockErrorRateManager->GetBlockErrorRateInterval (SNR, modulationType, I1, I2);
 
+  // Always draw both values, even when the outcome is known, so that the
+  // random stream and therefore the results do not depend on the SNR range
   double blockErrorRate = m_URNG->GetValue (I1, I2);
 
   double rand = m_URNG->GetValue (0.0, 1.0);
@@ -375,7 +371,6 @@ SimpleOfdmWimaxPhy::StartReceive (uint32_t burstSize,
     {
       drop = 0;
     }
-  delete record;
 
   NS_LOG_INFO ("PHY: Receive rxPower=" << rxPower << ", Nwb=" << Nwb << ", SNR=" << SNR << ", Modulation="
                                        << modulationType << ", BlocErrorRate=" << blockErrorRate << ", drop=" << (int) drop);
@@ -397,7 +392,6 @@ SimpleOfdmWimaxPhy::StartReceive (uint32_t burstSize,
           if (isFirstBlock)
             {
               NotifyRxBegin (burst);
-              m_receivedFecBlocks->clear ();
               m_nrRecivedFecBlocks=0;
               SetBlockParameters (burstSize, modulationType);
               m_blockTime = GetBlockTransmissionTime (modulationType);
@@ -469,137 +463,6 @@ SimpleOfdmWimaxPhy::EndReceive (Ptr<const PacketBurst> burst)
   m_traceRx (burst);
 }
 
-bvec
-SimpleOfdmWimaxPhy::ConvertBurstToBits (Ptr<const PacketBurst> burst)
-{
-  bvec buffer (burst->GetSize () * 8, 0);
-
-  std::list<Ptr<Packet> > packets = burst->GetPackets ();
-
-  uint32_t j = 0;
-  for (std::list<Ptr<Packet> >::iterator iter = packets.begin (); iter != packets.end (); ++iter)
-    {
-      Ptr<Packet> packet = *iter;
-      uint8_t *pstart = (uint8_t*) std::malloc (packet->GetSize ());
-      std::memset (pstart, 0, packet->GetSize ());
-      packet->CopyData (pstart, packet->GetSize ());
-      bvec temp (8);
-      temp.resize (0, 0);
-      temp.resize (8, 0);
-      for (uint32_t i = 0; i < packet->GetSize (); i++)
-        {
-          for (uint8_t l = 0; l < 8; l++)
-            {
-              temp[l] = (bool)((((uint8_t) pstart[i]) >> (7 - l)) & 0x01);
-              buffer.at (j * 8 + l) = temp[l];
-            }
-          j++;
-        }
-      std::free (pstart);
-    }
-
-  return buffer;
-}
-
-/*
- Converts back the bit buffer (bvec) to the actual burst.
- Actually creates byte buffer from the bvec and resets the buffer
- of each packet in the copy of the orifinal burst stored before transmitting.
- By doing this it preserves the metadata and tags in the packet.
- Function could also be named DeserializeBurst because actually it
- copying to the burst's byte buffer.
- */
-Ptr<PacketBurst>
-SimpleOfdmWimaxPhy::ConvertBitsToBurst (bvec buffer)
-{
-  uint8_t init[buffer.size () / 8];
-  uint8_t *pstart = init;
-  uint8_t temp;
-  int32_t j = 0;
-  // recreating byte buffer from bit buffer (bvec)
-  for (uint32_t i = 0; i < buffer.size (); i += 8)
-    {
-
-      temp = 0;
-      for (int l = 0; l < 8; l++)
-        {
-          bool bin = buffer.at (i + l);
-          temp += (uint8_t)(bin * std::pow (2.0, (7 - l)));
-        }
-
-      *(pstart + j) = temp;
-      j++;
-    }
-  uint16_t bufferSize = buffer.size () / 8;
-  uint16_t pos = 0;
-  Ptr<PacketBurst> RecvBurst = Create<PacketBurst> ();
-  while (pos < bufferSize)
-    {
-      uint16_t packetSize = 0;
-      // Get the header type: first bit
-      uint8_t ht = (pstart[pos] >> 7) & 0x01;
-      if (ht == 1)
-        {
-          // BW request header. Size is always 8 bytes
-          packetSize = 6;
-        }
-      else
-        {
-          // Read the size
-          uint8_t Len_MSB = pstart[pos + 1] & 0x07;
-          packetSize = (uint16_t)((uint16_t)(Len_MSB << 8) | (uint16_t)(pstart[pos + 2]));
-          if (packetSize == 0)
-            {
-              break; // padding
-            }
-        }
-
-      Ptr<Packet> p = Create<Packet> (&(pstart[pos]), packetSize);
-      RecvBurst->AddPacket (p);
-      pos += packetSize;
-    }
-  return RecvBurst;
-}
-
-void
-SimpleOfdmWimaxPhy::CreateFecBlocks (const bvec &buffer, WimaxPhy::ModulationType modulationType)
-{
-
-  bvec fecBlock (m_blockSize);
-  for (uint32_t i = 0, j = m_nrBlocks; j > 0; i += m_blockSize, j--)
-    {
-
-      if (j == 1 && m_paddingBits > 0) // last block can be smaller than block size
-        {
-          fecBlock = bvec (buffer.begin () + i, buffer.end ());
-          fecBlock.resize (m_blockSize, 0);
-        }
-      else
-        {
-          fecBlock = bvec (buffer.begin () + i, buffer.begin () + i + m_blockSize);
-        }
-
-      m_fecBlocks->push_back (fecBlock);
-    }
-}
-
-bvec
-SimpleOfdmWimaxPhy::RecreateBuffer ()
-{
-
-  bvec buffer (m_blockSize * (unsigned long)m_nrBlocks);
-  bvec block (m_blockSize);
-  uint32_t i = 0;
-  for (uint32_t j = 0; j < m_nrBlocks; j++)
-    {
-      bvec tmpRecFecBloc = m_receivedFecBlocks->front ();
-      buffer.insert (buffer.begin () + i, tmpRecFecBloc.begin (), tmpRecFecBloc.end ());
-      m_receivedFecBlocks->pop_front ();
-      i += m_blockSize;
-    }
-  return buffer;
-}
-
 void
 SimpleOfdmWimaxPhy::DoSetDataRates (void)
 {
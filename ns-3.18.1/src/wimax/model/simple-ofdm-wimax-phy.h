@@ -190,10 +190,6 @@ private:
   Time DoGetTransmissionTime (uint32_t size, WimaxPhy::ModulationType modulationType) const;
   uint64_t DoGetNrSymbols (uint32_t size, WimaxPhy::ModulationType modulationType) const;
   uint64_t DoGetNrBytes (uint32_t symbols, WimaxPhy::ModulationType modulationType) const;
-  bvec ConvertBurstToBits (Ptr<const PacketBurst> burst);
-  Ptr<PacketBurst> ConvertBitsToBurst (bvec buffer);
-  void CreateFecBlocks (const bvec &buffer, WimaxPhy::ModulationType modulationType);
-  bvec RecreateBuffer ();
   uint32_t GetFecBlockSize (WimaxPhy::ModulationType type) const;
   uint32_t GetCodedFecBlockSize (WimaxPhy::ModulationType modulationType) const;
   void SetBlockParameters (uint32_t burstSize, WimaxPhy::ModulationType modulationType);
@@ -241,9 +237,7 @@ private:
   uint16_t m_fecBlockSize; // in bits, size of FEC block transmitted after PHY operations
   uint32_t m_currentBurstSize;
 
-  std::list<bvec> *m_receivedFecBlocks; // a list of received FEC blocks until they are combined to recreate the full burst buffer
   uint32_t m_nrFecBlocksSent; // counting the number of FEC blocks sent (within a burst)
-  std::list<bvec> *m_fecBlocks;
   Time m_blockTime;
 
   TracedCallback<Ptr<const PacketBurst> > m_traceRx;
@@ -20,6 +20,8 @@
  */
 
 #include <cstring>
+#include <cstdio>
+#include <algorithm>
 #include "ns3/snr-to-block-error-rate-manager.h"
 #include "ns3/snr-to-block-error-rate-record.h"
 #include "default-traces.h"
@@ -31,13 +33,37 @@ NS_LOG_COMPONENT_DEFINE ("SNRToBlockErrorRateManager");
 
 namespace ns3 {
 
-SNRToBlockErrorRateManager::SNRToBlockErrorRateManager (void)
+/*
+ * The tables loaded so far, indexed by their origin. They are shared by all
+ * the managers of the process and never modified once loaded.
+ */
+std::map<std::string, Ptr<SNRToBlockErrorRateManager::Table> > &
+SNRToBlockErrorRateManager::GetTableCache (void)
 {
+  static std::map<std::string, Ptr<Table> > cache;
+  return cache;
+}
 
-  for (int i = 0; i < 7; i++)
+template <unsigned int N>
+void
+SNRToBlockErrorRateManager::AddDefaultRecords (std::vector<Entry> &records, double (&modulation)[6][N])
+{
+  records.reserve (N);
+  for (unsigned int j = 0; j < N; j++)
     {
-      m_recordModulation[i] = new std::vector<SNRToBlockErrorRateRecord*> ();
+      Entry entry;
+      entry.snrValue = modulation[0][j];
+      entry.bitErrorRate = modulation[1][j];
+      entry.blockErrorRate = modulation[2][j];
+      entry.sigma2 = modulation[3][j];
+      entry.I1 = modulation[4][j];
+      entry.I2 = modulation[5][j];
+      records.push_back (entry);
     }
+}
+
+SNRToBlockErrorRateManager::SNRToBlockErrorRateManager (void)
+{
   m_activateLoss = false;
   std::strcpy (m_traceFilePath,"DefaultTraces");
 }
@@ -45,29 +71,12 @@ SNRToBlockErrorRateManager::SNRToBlockErrorRateManager (void)
 SNRToBlockErrorRateManager::~SNRToBlockErrorRateManager (void)
 {
   ClearRecords ();
-  for (int i = 0; i < 7; i++)
-    {
-      delete m_recordModulation[i];
-    }
 }
 
 void
 SNRToBlockErrorRateManager::ClearRecords (void)
 {
-  for (int i = 0; i < 7; i++)
-    {
-
-      for (std::vector<SNRToBlockErrorRateRecord*>::iterator iter = m_recordModulation[i]->begin (); iter
-           != m_recordModulation[i]->end (); ++iter)
-        {
-          if (*iter)
-            {
-              delete (*iter);
-              (*iter) = 0;
-            }
-        }
-      m_recordModulation[i]->clear ();
-    }
+  m_table = 0;
 }
 
 void
@@ -76,198 +85,92 @@ SNRToBlockErrorRateManager::ActivateLoss (bool loss)
   m_activateLoss = loss;
 }
 
-void
-SNRToBlockErrorRateManager::LoadTraces (void)
+Ptr<SNRToBlockErrorRateManager::Table>
+SNRToBlockErrorRateManager::LoadTable (std::string key, std::string traceFilePath, std::string fileName, bool reload)
 {
+  std::map<std::string, Ptr<Table> > &cache = GetTableCache ();
+  std::map<std::string, Ptr<Table> >::const_iterator it = cache.find (key);
+  if (!reload && it != cache.end ())
+    {
+      return it->second;
+    }
+
   std::ifstream m_ifTraceFile;
-  ClearRecords ();
   double snrValue, bitErrorRate, burstErrorRate, sigma2, I1, I2;
+  Ptr<Table> table = Create<Table> ();
 
   for (int i = 0; i < 7; i++)
     {
       char traceFile[1024];
-      sprintf (traceFile, "%s/modulation%d.txt", m_traceFilePath, i);
+      sprintf (traceFile, "%s/%s%d.txt", traceFilePath.c_str (), fileName.c_str (), i);
 
       m_ifTraceFile.open (traceFile, std::ifstream::in);
       if (m_ifTraceFile.good () == false)
         {
           NS_LOG_INFO ("Unable to load " << traceFile << "!! Loading default traces...");
-          LoadDefaultTraces ();
-          return;
+          table = LoadDefaultTable ();
+          break;
         }
       while (m_ifTraceFile.good ())
         {
           m_ifTraceFile >> snrValue >> bitErrorRate >> burstErrorRate >> sigma2 >> I1 >> I2;
-          SNRToBlockErrorRateRecord *record = new SNRToBlockErrorRateRecord (snrValue,
-                                                                             bitErrorRate,
-                                                                             burstErrorRate,
-                                                                             sigma2,
-                                                                             I1,
-                                                                             I2);
-          m_recordModulation[i]->push_back (record);
-
+          Entry entry;
+          entry.snrValue = snrValue;
+          entry.bitErrorRate = bitErrorRate;
+          entry.blockErrorRate = burstErrorRate;
+          entry.sigma2 = sigma2;
+          entry.I1 = I1;
+          entry.I2 = I2;
+          table->m_modulation[i].push_back (entry);
         }
       m_ifTraceFile.close ();
     }
+  cache[key] = table;
+  return table;
+}
+
+Ptr<SNRToBlockErrorRateManager::Table>
+SNRToBlockErrorRateManager::LoadDefaultTable (void)
+{
+  std::map<std::string, Ptr<Table> > &cache = GetTableCache ();
+  std::map<std::string, Ptr<Table> >::const_iterator it = cache.find ("");
+  if (it != cache.end ())
+    {
+      return it->second;
+    }
+  Ptr<Table> table = Create<Table> ();
+  AddDefaultRecords (table->m_modulation[0], modulation0);
+  AddDefaultRecords (table->m_modulation[1], modulation1);
+  AddDefaultRecords (table->m_modulation[2], modulation2);
+  AddDefaultRecords (table->m_modulation[3], modulation3);
+  AddDefaultRecords (table->m_modulation[4], modulation4);
+  AddDefaultRecords (table->m_modulation[5], modulation5);
+  AddDefaultRecords (table->m_modulation[6], modulation6);
+  cache[""] = table;
+  return table;
+}
+
+void
+SNRToBlockErrorRateManager::LoadTraces (void)
+{
+  ClearRecords ();
+  m_table = LoadTable (std::string ("modulation:") + m_traceFilePath, m_traceFilePath, "modulation", false);
   m_activateLoss = true;
 }
 
 void
 SNRToBlockErrorRateManager::LoadDefaultTraces (void)
 {
-  double snrValue, bitErrorRate, burstErrorRate, sigma2, I1, I2;
   ClearRecords ();
-  for (unsigned int j = 0; j < sizeof(modulation0[0]) / sizeof(double); j++)
-    {
-      snrValue = modulation0[0][j];
-      bitErrorRate = modulation0[1][j];
-      burstErrorRate = modulation0[2][j];
-      sigma2 = modulation0[3][j];
-      I1 = modulation0[4][j];
-      I2 = modulation0[5][j];
-      SNRToBlockErrorRateRecord *record = new SNRToBlockErrorRateRecord (snrValue,
-                                                                         bitErrorRate,
-                                                                         burstErrorRate,
-                                                                         sigma2,
-                                                                         I1,
-                                                                         I2);
-      m_recordModulation[0]->push_back (record);
-    }
-  for (unsigned int j = 0; j < sizeof(modulation1[0]) / sizeof(double); j++)
-    {
-      snrValue = modulation1[0][j];
-      bitErrorRate = modulation1[1][j];
-      burstErrorRate = modulation1[2][j];
-      sigma2 = modulation1[3][j];
-      I1 = modulation1[4][j];
-      I2 = modulation1[5][j];
-      SNRToBlockErrorRateRecord *record = new SNRToBlockErrorRateRecord (snrValue,
-                                                                         bitErrorRate,
-                                                                         burstErrorRate,
-                                                                         sigma2,
-                                                                         I1,
-                                                                         I2);
-      m_recordModulation[1]->push_back (record);
-    }
-  for (unsigned int j = 0; j < sizeof(modulation2[0]) / sizeof(double); j++)
-    {
-      snrValue = modulation2[0][j];
-      bitErrorRate = modulation2[1][j];
-      burstErrorRate = modulation2[2][j];
-      sigma2 = modulation2[3][j];
-      I1 = modulation2[4][j];
-      I2 = modulation2[5][j];
-      SNRToBlockErrorRateRecord *record = new SNRToBlockErrorRateRecord (snrValue,
-                                                                         bitErrorRate,
-                                                                         burstErrorRate,
-                                                                         sigma2,
-                                                                         I1,
-                                                                         I2);
-      m_recordModulation[2]->push_back (record);
-    }
-  for (unsigned int j = 0; j < sizeof(modulation3[0]) / sizeof(double); j++)
-    {
-      snrValue = modulation3[0][j];
-      bitErrorRate = modulation3[1][j];
-      burstErrorRate = modulation3[2][j];
-      sigma2 = modulation3[3][j];
-      I1 = modulation3[4][j];
-      I2 = modulation3[5][j];
-      SNRToBlockErrorRateRecord *record = new SNRToBlockErrorRateRecord (snrValue,
-                                                                         bitErrorRate,
-                                                                         burstErrorRate,
-                                                                         sigma2,
-                                                                         I1,
-                                                                         I2);
-      m_recordModulation[3]->push_back (record);
-    }
-  for (unsigned int j = 0; j < sizeof(modulation4[0]) / sizeof(double); j++)
-    {
-      snrValue = modulation4[0][j];
-      bitErrorRate = modulation4[1][j];
-      burstErrorRate = modulation4[2][j];
-      sigma2 = modulation4[3][j];
-      I1 = modulation4[4][j];
-      I2 = modulation4[5][j];
-      SNRToBlockErrorRateRecord *record = new SNRToBlockErrorRateRecord (snrValue,
-                                                                         bitErrorRate,
-                                                                         burstErrorRate,
-                                                                         sigma2,
-                                                                         I1,
-                                                                         I2);
-      m_recordModulation[4]->push_back (record);
-    }
-  for (unsigned int j = 0; j < sizeof(modulation5[0]) / sizeof(double); j++)
-    {
-      snrValue = modulation5[0][j];
-      bitErrorRate = modulation5[1][j];
-      burstErrorRate = modulation5[2][j];
-      sigma2 = modulation5[3][j];
-      I1 = modulation5[4][j];
-      I2 = modulation5[5][j];
-      SNRToBlockErrorRateRecord *record = new SNRToBlockErrorRateRecord (snrValue,
-                                                                         bitErrorRate,
-                                                                         burstErrorRate,
-                                                                         sigma2,
-                                                                         I1,
-                                                                         I2);
-      m_recordModulation[5]->push_back (record);
-    }
-  for (unsigned int j = 0; j < sizeof(modulation6[0]) / sizeof(double); j++)
-    {
-      snrValue = modulation6[0][j];
-      bitErrorRate = modulation6[1][j];
-      burstErrorRate = modulation6[2][j];
-      sigma2 = modulation6[3][j];
-      I1 = modulation6[4][j];
-      I2 = modulation6[5][j];
-      SNRToBlockErrorRateRecord *record = new SNRToBlockErrorRateRecord (snrValue,
-                                                                         bitErrorRate,
-                                                                         burstErrorRate,
-                                                                         sigma2,
-                                                                         I1,
-                                                                         I2);
-      m_recordModulation[6]->push_back (record);
-    }
+  m_table = LoadDefaultTable ();
   m_activateLoss = true;
 }
 
 void
 SNRToBlockErrorRateManager::ReLoadTraces (void)
 {
-  double snrValue, bitErrorRate, burstErrorRate, sigma2, I1, I2;
-
   ClearRecords ();
-
-  std::ifstream m_ifTraceFile;
-
-  for (int i = 0; i < 7; i++)
-    {
-      char traceFile[1024];
-      sprintf (traceFile, "%s/Modulation%d.txt", m_traceFilePath, i);
-
-      m_ifTraceFile.open (traceFile, std::ifstream::in);
-      if (m_ifTraceFile.good () == false)
-        {
-          NS_LOG_INFO ("Unable to load " << traceFile << "!!Loading default traces...");
-          LoadDefaultTraces ();
-          return;
-        }
-      while (m_ifTraceFile.good ())
-        {
-          m_ifTraceFile >> snrValue >> bitErrorRate >> burstErrorRate >> sigma2 >> I1 >> I2;
-          SNRToBlockErrorRateRecord *record = new SNRToBlockErrorRateRecord (snrValue,
-                                                                             bitErrorRate,
-                                                                             burstErrorRate,
-                                                                             sigma2,
-                                                                             I1,
-                                                                             I2);
-
-          m_recordModulation[i]->push_back (record);
-
-        }
-      m_ifTraceFile.close ();
-    }
+  m_table = LoadTable (std::string ("Modulation:") + m_traceFilePath, m_traceFilePath, "Modulation", true);
   m_activateLoss = true;
 }
 
@@ -285,6 +188,18 @@ SNRToBlockErrorRateManager::GetTraceFilePath (void)
   return (std::string (m_traceFilePath));
 }
 
+bool
+SNRToBlockErrorRateManager::CompareSnr (double SNR, Entry const &entry)
+{
+  return SNR < entry.snrValue;
+}
+
+uint32_t
+SNRToBlockErrorRateManager::FindInterval (std::vector<Entry> const &records, double SNR)
+{
+  return std::upper_bound (records.begin (), records.end (), SNR, CompareSnr) - records.begin ();
+}
+
 double
 SNRToBlockErrorRateManager::GetBlockErrorRate (double SNR, uint8_t modulation)
 {
@@ -294,32 +209,23 @@ SNRToBlockErrorRateManager::GetBlockErrorRate (double SNR, uint8_t modulation)
       return 0;
     }
 
-  std::vector<SNRToBlockErrorRateRecord *> *record = 0;
+  NS_ASSERT (m_table != 0);
+  std::vector<Entry> const &record = m_table->m_modulation[modulation];
 
-  record = m_recordModulation[modulation];
-
-  if (SNR <= (record->at (0)->GetSNRValue ()))
+  if (SNR <= (record.at (0).snrValue))
     {
       return 1;
     }
-  if (SNR >= (record->at (record->size () - 1)->GetSNRValue ()))
+  if (SNR >= (record.at (record.size () - 1).snrValue))
     {
       return 0;
     }
 
-  std::vector<SNRToBlockErrorRateRecord*>::const_iterator iter;
-  unsigned int i;
-  for (i = 0; i < record->size (); i++)
-    {
-      if (SNR < record->at (i)->GetSNRValue ())
-        {
-          break;
-        }
-    }
-  double intervalSize = (record->at (i)->GetSNRValue () - record->at (i - 1)->GetSNRValue ());
-  double coeff1 = (SNR - record->at (i - 1)->GetSNRValue ()) / intervalSize;
-  double coeff2 = -1 * (SNR - record->at (i)->GetSNRValue ()) / intervalSize;
-  double BlockErrorRate = coeff2 * (record->at (i - 1)->GetBlockErrorRate ()) + coeff1 * (record->at (i)->GetBlockErrorRate ());
+  unsigned int i = FindInterval (record, SNR);
+  double intervalSize = (record[i].snrValue - record[i - 1].snrValue);
+  double coeff1 = (SNR - record[i - 1].snrValue) / intervalSize;
+  double coeff2 = -1 * (SNR - record[i].snrValue) / intervalSize;
+  double BlockErrorRate = coeff2 * (record[i - 1].blockErrorRate) + coeff1 * (record[i].blockErrorRate);
   return BlockErrorRate;
 }
 
@@ -333,42 +239,67 @@ SNRToBlockErrorRateManager::GetSNRToBlockErrorRateRecord (double SNR,
       return new SNRToBlockErrorRateRecord (SNR, 0, 0, 0, 0, 0);
     }
 
-  std::vector<SNRToBlockErrorRateRecord *> *record = 0;
-  record = m_recordModulation[modulation];
+  NS_ASSERT (m_table != 0);
+  std::vector<Entry> const &record = m_table->m_modulation[modulation];
 
-  if (SNR <= (record->at (0)->GetSNRValue ()))
+  if (SNR <= (record.at (0).snrValue))
     {
-      return
-        record->at (0)->Copy ();
+      Entry const &e = record[0];
+      return new SNRToBlockErrorRateRecord (e.snrValue, e.bitErrorRate, e.blockErrorRate, e.sigma2, e.I1, e.I2);
     }
-  if (SNR >= (record->at (record->size () - 1)->GetSNRValue ()))
+  if (SNR >= (record.at (record.size () - 1).snrValue))
     {
-      return
-        record->at (record->size () - 1)->Copy ();
+      Entry const &e = record[record.size () - 1];
+      return new SNRToBlockErrorRateRecord (e.snrValue, e.bitErrorRate, e.blockErrorRate, e.sigma2, e.I1, e.I2);
     }
 
-  std::vector<SNRToBlockErrorRateRecord*>::const_iterator iter;
-  unsigned int i;
-  for (i = 0; i < record->size (); i++)
-    {
-      if (SNR < record->at (i)->GetSNRValue ())
-        {
-          break;
-        }
-    }
-  double intervalSize = (record->at (i)->GetSNRValue ()
-                         - record->at (i - 1)->GetSNRValue ());
-  double coeff1 = (SNR - record->at (i - 1)->GetSNRValue ()) / intervalSize;
-  double coeff2 = -1 * (SNR - record->at (i)->GetSNRValue ()) / intervalSize;
-  double BER = coeff2 * (record->at (i - 1)->GetBitErrorRate ()) + coeff1 * (record->at (i)->GetBitErrorRate ());
-  double BlcER = coeff2 * (record->at (i - 1)->GetBlockErrorRate ()) + coeff1 * (record->at (i)->GetBlockErrorRate ());
-  double sigma2 = coeff2 * (record->at (i - 1)->GetSigma2 ()) + coeff1 * (record->at (i)->GetSigma2 ());
-  double I1 = coeff2 * (record->at (i - 1)->GetI1 ()) + coeff1 * (record->at (i)->GetI1 ());
-  double I2 = coeff2 * (record->at (i - 1)->GetI2 ()) + coeff1 * (record->at (i)->GetI2 ());
+  unsigned int i = FindInterval (record, SNR);
+  double intervalSize = (record[i].snrValue
+                         - record[i - 1].snrValue);
+  double coeff1 = (SNR - record[i - 1].snrValue) / intervalSize;
+  double coeff2 = -1 * (SNR - record[i].snrValue) / intervalSize;
+  double BER = coeff2 * (record[i - 1].bitErrorRate) + coeff1 * (record[i].bitErrorRate);
+  double BlcER = coeff2 * (record[i - 1].blockErrorRate) + coeff1 * (record[i].blockErrorRate);
+  double sigma2 = coeff2 * (record[i - 1].sigma2) + coeff1 * (record[i].sigma2);
+  double I1 = coeff2 * (record[i - 1].I1) + coeff1 * (record[i].I1);
+  double I2 = coeff2 * (record[i - 1].I2) + coeff1 * (record[i].I2);
 
   SNRToBlockErrorRateRecord * SNRToBlockErrorRate = new SNRToBlockErrorRateRecord (SNR, BER, BlcER, sigma2, I1,I2);
   return SNRToBlockErrorRate;
 }
 
+void
+SNRToBlockErrorRateManager::GetBlockErrorRateInterval (double SNR, uint8_t modulation, double &I1, double &I2)
+{
+  if (m_activateLoss == false)
+    {
+      I1 = 0;
+      I2 = 0;
+      return;
+    }
+
+  NS_ASSERT (m_table != 0);
+  std::vector<Entry> const &record = m_table->m_modulation[modulation];
+
+  if (SNR <= (record.at (0).snrValue))
+    {
+      I1 = record[0].I1;
+      I2 = record[0].I2;
+      return;
+    }
+  if (SNR >= (record.at (record.size () - 1).snrValue))
+    {
+      I1 = record[record.size () - 1].I1;
+      I2 = record[record.size () - 1].I2;
+      return;
+    }
+
+  unsigned int i = FindInterval (record, SNR);
+  double intervalSize = (record[i].snrValue - record[i - 1].snrValue);
+  double coeff1 = (SNR - record[i - 1].snrValue) / intervalSize;
+  double coeff2 = -1 * (SNR - record[i].snrValue) / intervalSize;
+  I1 = coeff2 * (record[i - 1].I1) + coeff1 * (record[i].I1);
+  I2 = coeff2 * (record[i - 1].I2) + coeff1 * (record[i].I2);
 }
 
+}
@@ -25,7 +25,10 @@
 
 #include "ns3/snr-to-block-error-rate-record.h"
 #include <vector>
+#include <map>
+#include <string>
 #include "ns3/ptr.h"
+#include "ns3/simple-ref-count.h"
 
 namespace ns3 {
 
@@ -42,6 +45,9 @@ namespace ns3 {
  *  ...           ...       ...          ...                      ...                        ...
  *  ...           ...       ...          ...                      ...                        ...
  * SNR_value(n)   BER(n)    Blc_ER(n)    STANDARD_DEVIATION(n)    CONFIDENCE_INTERVAL1(n)    CONFIDENCE_INTERVAL2(n)
+ *
+ * The traces are loaded once per process and shared, read only, by all the managers using the same
+ * repository (or the default traces). Lookups do a binary search on the SNR values.
  */
 class SNRToBlockErrorRateManager
 {
@@ -72,6 +78,15 @@ public:
    * \return the Block Error Rate
    */
   GetSNRToBlockErrorRateRecord (double SNR, uint8_t modulation);
+  /**
+   * \brief returns the confidence interval of the Block Error Rate for a given modulation and SNR value,
+   * without allocating a record
+   * \param SNR the SNR value
+   * \param modulation one of the seven MCS
+   * \param I1 the lower boundary of the confidence interval
+   * \param I2 the upper boundary of the confidence interval
+   */
+  void GetBlockErrorRateInterval (double SNR, uint8_t modulation, double &I1, double &I2);
   /**
    * \brief Loads the traces form the repository specified in the constructor or setted by SetTraceFilePath function. If
    * no repository is provided, default traces will be loaded from default-traces.h file
@@ -91,12 +106,38 @@ public:
    */
   void ActivateLoss (bool loss);
 private:
+  struct Entry
+  {
+    double snrValue;
+    double bitErrorRate;
+    double blockErrorRate;
+    double sigma2;
+    double I1;
+    double I2;
+  };
+  /// the records of the seven MCS, sorted by SNR value
+  class Table : public SimpleRefCount<Table>
+  {
+public:
+    std::vector<Entry> m_modulation[7];
+  };
+  static std::map<std::string, Ptr<Table> > & GetTableCache (void);
+  template <unsigned int N>
+  static void AddDefaultRecords (std::vector<Entry> &records, double (&modulation)[6][N]);
+  static bool CompareSnr (double SNR, Entry const &entry);
+  static Ptr<Table> LoadTable (std::string key, std::string traceFilePath, std::string fileName, bool reload);
+  static Ptr<Table> LoadDefaultTable (void);
+  /**
+   * \return the index i of the first record with an SNR value greater than SNR, the SNR value is
+   * in [records[i - 1], records[i]] and is neither below the first nor above the last record
+   */
+  static uint32_t FindInterval (std::vector<Entry> const &records, double SNR);
   void ClearRecords (void);
   uint8_t m_activateLoss;
   static const unsigned int TRACE_FILE_PATH_SIZE = 1024;
   char m_traceFilePath[TRACE_FILE_PATH_SIZE];
 
-  std::vector<SNRToBlockErrorRateRecord *> * m_recordModulation[7];
+  Ptr<const Table> m_table;
 
 };
 }
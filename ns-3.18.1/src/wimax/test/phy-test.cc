@@ -149,12 +149,22 @@ bool Ns3WimaxSNRtoBLERTestCase::DoRunOnce (uint8_t modulationType)
 
   SNRToBlockErrorRateManager l_SNRToBlockErrorRateManager;
   l_SNRToBlockErrorRateManager.LoadTraces ();
+  // a second manager shares the traces loaded by the first one
+  SNRToBlockErrorRateManager l_otherManager;
+  l_otherManager.LoadTraces ();
   SNRToBlockErrorRateRecord * BLERRec;
+  double I1, I2;
 
   for (double i = -5; i < 40; i += 0.1)
     {
       BLERRec = l_SNRToBlockErrorRateManager.GetSNRToBlockErrorRateRecord (i,
                                                                            modulationType);
+      l_otherManager.GetBlockErrorRateInterval (i, modulationType, I1, I2);
+      NS_TEST_EXPECT_MSG_EQ_TOL (I1, BLERRec->GetI1 (), 1e-12, "Confidence interval differs from the record");
+      NS_TEST_EXPECT_MSG_EQ_TOL (I2, BLERRec->GetI2 (), 1e-12, "Confidence interval differs from the record");
+      NS_TEST_EXPECT_MSG_EQ_TOL (l_otherManager.GetBlockErrorRate (i, modulationType),
+                                 l_SNRToBlockErrorRateManager.GetBlockErrorRate (i, modulationType),
+                                 1e-12, "Shared traces give different block error rates");
       delete BLERRec;
     }
   return false;
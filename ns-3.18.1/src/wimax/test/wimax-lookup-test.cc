@@ -0,0 +1,205 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#include "ns3/log.h"
+#include "ns3/test.h"
+#include "ns3/ipv4-address.h"
+#include "ns3/cid.h"
+#include "ns3/cid-factory.h"
+#include "ns3/connection-manager.h"
+#include "ns3/wimax-connection.h"
+#include "ns3/service-flow.h"
+#include "ns3/service-flow-manager.h"
+#include "ns3/cs-parameters.h"
+#include "ns3/ipcs-classifier-record.h"
+#include <vector>
+
+using namespace ns3;
+
+/*
+ * Test the lookup of the connections by their CID.
+ */
+class Ns3WimaxCidLookupTestCase : public TestCase
+{
+public:
+  Ns3WimaxCidLookupTestCase ();
+  virtual ~Ns3WimaxCidLookupTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+};
+
+Ns3WimaxCidLookupTestCase::Ns3WimaxCidLookupTestCase ()
+  : TestCase ("Test the lookup of the connections by cid.")
+{
+}
+
+Ns3WimaxCidLookupTestCase::~Ns3WimaxCidLookupTestCase ()
+{
+}
+
+void
+Ns3WimaxCidLookupTestCase::DoRun (void)
+{
+  CidFactory cidFactory;
+  Ptr<ConnectionManager> connectionManager = CreateObject<ConnectionManager> ();
+  connectionManager->SetCidFactory (&cidFactory);
+
+  // connections created by the manager, as on a BS
+  std::vector<Ptr<WimaxConnection> > connections;
+  for (uint32_t i = 0; i < 20; ++i)
+    {
+      connections.push_back (connectionManager->CreateConnection (Cid::BASIC));
+      connections.push_back (connectionManager->CreateConnection (Cid::PRIMARY));
+      connections.push_back (connectionManager->CreateConnection (Cid::TRANSPORT));
+    }
+  // a connection added with a cid received from the BS, as on a SS
+  Ptr<WimaxConnection> added = CreateObject<WimaxConnection> (Cid (0x1234), Cid::TRANSPORT);
+  connectionManager->AddConnection (added, Cid::TRANSPORT);
+  connections.push_back (added);
+
+  for (uint32_t i = 0; i < connections.size (); ++i)
+    {
+      NS_TEST_EXPECT_MSG_EQ (connectionManager->GetConnection (connections[i]->GetCid ()), connections[i],
+                             "Wrong connection for cid " << connections[i]->GetCid ());
+    }
+  NS_TEST_EXPECT_MSG_EQ (connectionManager->GetConnections (Cid::BASIC).size (), 20,
+                         "Wrong number of basic connections");
+  NS_TEST_EXPECT_MSG_EQ (connectionManager->GetConnections (Cid::TRANSPORT).size (), 21,
+                         "Wrong number of transport connections");
+
+  // unknown cids and multicast connections are not found, as before the index
+  NS_TEST_EXPECT_MSG_EQ (connectionManager->GetConnection (Cid (0x4321)), 0, "Unknown cid found");
+  Ptr<WimaxConnection> multicast = connectionManager->CreateConnection (Cid::MULTICAST);
+  NS_TEST_EXPECT_MSG_EQ (connectionManager->GetConnection (multicast->GetCid ()), 0,
+                         "Multicast connection found");
+
+  connectionManager->Dispose ();
+}
+
+/*
+ * Test the cache of the service flow classification.
+ */
+class Ns3WimaxClassifierCacheTestCase : public TestCase
+{
+public:
+  Ns3WimaxClassifierCacheTestCase ();
+  virtual ~Ns3WimaxClassifierCacheTestCase ();
+
+private:
+  virtual void DoRun (void);
+  static ServiceFlow * CreateServiceFlow (uint16_t dstPortLow, uint16_t dstPortHigh);
+  ServiceFlow * Classify (Ptr<ServiceFlowManager> sfm, uint16_t srcPort, uint16_t dstPort);
+};
+
+Ns3WimaxClassifierCacheTestCase::Ns3WimaxClassifierCacheTestCase ()
+  : TestCase ("Test the cache of the service flow classification.")
+{
+}
+
+Ns3WimaxClassifierCacheTestCase::~Ns3WimaxClassifierCacheTestCase ()
+{
+}
+
+ServiceFlow *
+Ns3WimaxClassifierCacheTestCase::CreateServiceFlow (uint16_t dstPortLow, uint16_t dstPortHigh)
+{
+  ServiceFlow *serviceFlow = new ServiceFlow (ServiceFlow::SF_DIRECTION_DOWN);
+  IpcsClassifierRecord classifier (Ipv4Address ("0.0.0.0"),
+                                   Ipv4Mask ("0.0.0.0"),
+                                   Ipv4Address ("0.0.0.0"),
+                                   Ipv4Mask ("0.0.0.0"),
+                                   0,
+                                   65535,
+                                   dstPortLow,
+                                   dstPortHigh,
+                                   17,
+                                   1);
+  serviceFlow->SetConvergenceSublayerParam (CsParameters (CsParameters::ADD, classifier));
+  return serviceFlow;
+}
+
+ServiceFlow *
+Ns3WimaxClassifierCacheTestCase::Classify (Ptr<ServiceFlowManager> sfm, uint16_t srcPort, uint16_t dstPort)
+{
+  return sfm->DoClassify (Ipv4Address ("10.1.1.1"), Ipv4Address ("10.1.1.2"), srcPort, dstPort, 17,
+                          ServiceFlow::SF_DIRECTION_DOWN);
+}
+
+void
+Ns3WimaxClassifierCacheTestCase::DoRun (void)
+{
+  Ptr<ServiceFlowManager> sfm = CreateObject<ServiceFlowManager> ();
+  ServiceFlow *low = CreateServiceFlow (1000, 1999);
+  sfm->AddServiceFlow (low);
+
+  // the first classification of an ip flow fills the cache, the next ones hit it
+  NS_TEST_EXPECT_MSG_EQ (Classify (sfm, 5000, 1500), low, "Wrong service flow");
+  NS_TEST_EXPECT_MSG_EQ (sfm->GetClassifierCacheSize (), 1, "Classification not cached");
+  NS_TEST_EXPECT_MSG_EQ (Classify (sfm, 5000, 1500), low, "Wrong service flow on a cache hit");
+  NS_TEST_EXPECT_MSG_EQ (sfm->GetClassifierCacheSize (), 1, "Cache hit added an entry");
+
+  // ip flows matching no service flow are cached too
+  NS_TEST_EXPECT_MSG_EQ (Classify (sfm, 5000, 2500), 0, "Unclassified ip flow matched");
+  NS_TEST_EXPECT_MSG_EQ (sfm->GetClassifierCacheSize (), 2, "Unmatched ip flow not cached");
+
+  // adding a service flow invalidates the cache, including the unmatched flows
+  ServiceFlow *high = CreateServiceFlow (1500, 2999);
+  sfm->AddServiceFlow (high);
+  NS_TEST_EXPECT_MSG_EQ (sfm->GetClassifierCacheSize (), 0, "Cache not flushed on add");
+  NS_TEST_EXPECT_MSG_EQ (Classify (sfm, 5000, 2500), high, "Stale classification after add");
+  NS_TEST_EXPECT_MSG_EQ (Classify (sfm, 5000, 1500), low, "Wrong first matching service flow");
+
+  // removing a service flow invalidates the cache
+  sfm->RemoveServiceFlow (low);
+  NS_TEST_EXPECT_MSG_EQ (sfm->GetClassifierCacheSize (), 0, "Cache not flushed on remove");
+  NS_TEST_EXPECT_MSG_EQ (Classify (sfm, 5000, 1500), high, "Stale classification after remove");
+  NS_TEST_EXPECT_MSG_EQ (Classify (sfm, 5000, 1200), 0, "Removed service flow matched");
+  delete low;
+
+  // once the cache is full, it is flushed and classification goes on
+  sfm->RemoveServiceFlow (high);
+  sfm->AddServiceFlow (high);
+  for (uint32_t srcPort = 0; srcPort < 4096; ++srcPort)
+    {
+      NS_TEST_EXPECT_MSG_EQ (Classify (sfm, srcPort, 1500 + srcPort % 2000), (srcPort % 2000 < 1500) ? high : 0,
+                             "Wrong service flow for source port " << srcPort);
+    }
+  NS_TEST_EXPECT_MSG_EQ (sfm->GetClassifierCacheSize (), 4096, "Cache not filled");
+  NS_TEST_EXPECT_MSG_EQ (Classify (sfm, 4096, 1500), high, "Wrong service flow with a full cache");
+  NS_TEST_EXPECT_MSG_EQ (sfm->GetClassifierCacheSize (), 1, "Full cache not flushed");
+  NS_TEST_EXPECT_MSG_EQ (Classify (sfm, 0, 1500), high, "Wrong service flow after the flush");
+  NS_TEST_EXPECT_MSG_EQ (Classify (sfm, 1999, 3499), 0, "Wrong service flow after the flush");
+  NS_TEST_EXPECT_MSG_EQ (sfm->GetClassifierCacheSize (), 3, "Classification not cached after the flush");
+
+  sfm->Dispose ();
+}
+
+// ==============================================================================
+class Ns3WimaxLookupTestSuite : public TestSuite
+{
+public:
+  Ns3WimaxLookupTestSuite ();
+};
+
+Ns3WimaxLookupTestSuite::Ns3WimaxLookupTestSuite ()
+  : TestSuite ("wimax-lookup", UNIT)
+{
+  AddTestCase (new Ns3WimaxCidLookupTestCase, TestCase::QUICK);
+  AddTestCase (new Ns3WimaxClassifierCacheTestCase, TestCase::QUICK);
+}
+
+static Ns3WimaxLookupTestSuite ns3WimaxLookupTestSuite;